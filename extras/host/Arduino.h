@@ -0,0 +1,139 @@
+/*!
+	Arduino.h (host build)
+
+	copyright 2026, Vulintus, Inc.
+
+	Minimal stand-in for the Arduino core so that the Vulintus_DigiPot 
+	drivers in "src/" can be compiled and run unmodified on a PC. Time is 
+	simulated: "micros()" advances only when the simulated buses clock out
+	bits or when "delay()"/"delayMicroseconds()" are called, so bus 
+	occupancy can be measured exactly.
+
+	"analogRead" returns the level set by a simulated analog source
+	("host_set_analog"), scaled to the resolution from
+	"analogReadResolution" (10 bits by default).
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Host layer first created.
+		2026-10-17 - Drew Sloan - Added "analogRead" with a simulated analog 
+		                          source, and the analog pin names.
+*/
+
+
+#ifndef VULINTUS_HOST_ARDUINO_H
+#define VULINTUS_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define HIGH        0x1
+#define LOW         0x0
+#define INPUT       0x0
+#define OUTPUT      0x1
+#define LSBFIRST    0
+#define MSBFIRST    1
+
+#define PROGMEM
+#define PSTR(s)                 (s)
+#define F(s)                    (s)
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr)      (*(void * const *)(addr))
+
+#define HOST_NUM_PINS   256             // Number of simulated digital pins.
+
+#define A0  14                          // Analog pin names (Uno numbering).
+#define A1  15
+#define A2  16
+#define A3  17
+#define A4  18
+#define A5  19
+#define A6  20
+#define A7  21
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint32_t (*Host_analog_fn)(uint8_t pin, void *context);     // Simulated analog source (returns the level as a Q16 fraction of full scale).
+
+
+// FUNCTIONS *********************************************************************************************************//
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint32_t micros(void);
+uint32_t millis(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void noInterrupts(void);
+void interrupts(void);
+void yield(void);
+int analogRead(uint8_t pin);
+void analogReadResolution(int bits);
+
+// Sketch entry points. //
+void setup(void);
+void loop(void);
+
+// Host-only simulation controls. //
+void host_advance_ns(uint32_t ns);      // Advance the simulated clock.
+uint64_t host_time_ns(void);            // Read the simulated clock, in nanoseconds.
+void host_reset_time(void);             // Reset the simulated clock to zero.
+void host_set_analog(Host_analog_fn fn, void *context = NULL);     // Set the simulated analog source (NULL reads 0).
+
+
+// CLASSES ***********************************************************************************************************//
+class Print
+{
+    public:
+
+        virtual size_t write(uint8_t c);
+        virtual size_t write(const uint8_t *buf, size_t n);
+
+        size_t print(const char *str);
+        size_t print(char c);
+        size_t print(long n, int base = 10);
+        size_t print(unsigned long n, int base = 10);
+        size_t print(int n, int base = 10);
+        size_t print(unsigned int n, int base = 10);
+        size_t print(double n, int digits = 2);
+
+        size_t println(void);
+        size_t println(const char *str);
+        size_t println(char c);
+        size_t println(long n, int base = 10);
+        size_t println(unsigned long n, int base = 10);
+        size_t println(int n, int base = 10);
+        size_t println(unsigned int n, int base = 10);
+        size_t println(double n, int digits = 2);
+
+};
+
+
+class Stream : public Print
+{
+    public:
+
+        virtual int available(void);
+        virtual int read(void);
+
+};
+
+
+class HardwareSerial : public Stream
+{
+    public:
+
+        void begin(uint32_t baud);
+        operator bool(void) { return true; }
+
+};
+
+extern HardwareSerial Serial;
+
+#endif      // #ifndef VULINTUS_HOST_ARDUINO_H
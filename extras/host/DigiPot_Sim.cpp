@@ -0,0 +1,341 @@
+/*!
+	DigiPot_Sim.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	See "DigiPot_Sim.h" for documentation and change log.
+*/
+
+
+#include "DigiPot_Sim.h"
+
+
+// MCP4XXX ***********************************************************************************************************//
+
+// Simulator constructor.
+Sim_MCP4xxx::Sim_MCP4xxx(uint16_t n_steps, uint8_t n_wipers)
+    : full_scale(n_steps), n_wipers(n_wipers)
+{
+    wiper[0] = wiper[1] = n_steps / 2;      // Wipers power up at mid-scale.
+    tcon = 0x1FF;                           // All terminals connected.
+    status = 0x1F0;                         // Reserved bits read as 1s.
+    has_eeprom = false;                     // Volatile-only unless set.
+    nv_wiper[0] = nv_wiper[1] = n_steps / 2;    // NV wipers ship at mid-scale.
+    eewa_until_us = 0;
+    n_nv_writes = 0;
+    _nv_started = false;
+    n_cmds = 0;
+    n_cmd_errors = 0;
+    i2c_addr = 0x2E;
+    pin_cs = 0xFF;
+    _have_cmd = false;
+    _error = false;
+    _read_value = 0;
+    _read_pos = 0;
+}
+
+
+// Find a register by address.
+uint16_t *Sim_MCP4xxx::reg(uint8_t addr)
+{
+    switch (addr) {
+        case 0x00:  return &wiper[0];
+        case 0x01:  return (n_wipers > 1) ? &wiper[1] : NULL;
+        case 0x02:  return has_eeprom ? &nv_wiper[0] : NULL;
+        case 0x03:  return (has_eeprom && (n_wipers > 1)) ? &nv_wiper[1] : NULL;
+        case 0x04:  return &tcon;
+        case 0x05:  return &status;
+    }
+    return NULL;
+}
+
+
+// True if an NV wiper write would be rejected (write cycle active or WiperLock set).
+bool Sim_MCP4xxx::nv_rejected(uint8_t addr)
+{
+    bool busy = _nv_started || ((int32_t) (eewa_until_us - micros()) > 0);
+    bool locked = status & ((addr == 0x02) ? 0x04 : 0x08);
+    return busy || locked;
+}
+
+
+// Start the EEPROM write cycle at STOP or chip select rising edge.
+void Sim_MCP4xxx::nv_start(void)
+{
+    if (_nv_started) {
+        eewa_until_us = micros() + 5000;                // tWC = 5 ms.
+        _nv_started = false;
+    }
+}
+
+
+// Refresh the STATUS EEWA bit from the write cycle.
+void Sim_MCP4xxx::update_eewa(void)
+{
+    if (has_eeprom) {
+        status = (status & ~0x10) | (((int32_t) (eewa_until_us - micros()) > 0) ? 0x10 : 0x00);
+    }
+}
+
+
+// 1 for increment/decrement, 2 otherwise.
+uint8_t Sim_MCP4xxx::command_length(uint8_t hi)
+{
+    uint8_t cmd = (hi >> 2) & 0x03;
+    return ((cmd == 1) || (cmd == 2)) ? 1 : 2;
+}
+
+
+// Execute a complete command.
+bool Sim_MCP4xxx::execute(uint8_t hi, uint8_t lo)
+{
+    uint8_t addr = hi >> 4;
+    uint8_t cmd = (hi >> 2) & 0x03;
+    uint16_t data = ((hi & 0x01) << 8) | lo;
+    uint16_t *r = reg(addr);
+    bool is_wiper = (addr <= 0x01);
+    if (r == NULL) {                                    // Unimplemented address.
+        n_cmd_errors++;
+        return false;
+    }
+    switch (cmd) {
+        case 0:                                         // Write.
+            if (addr == 0x05) {                         // STATUS is read-only.
+                n_cmd_errors++;
+                return false;
+            }
+            if ((addr == 0x02) || (addr == 0x03)) {     // NV wiper write.
+                if (nv_rejected(addr)) {                // Rejected during a write cycle or with WiperLock set.
+                    n_cmd_errors++;
+                    return false;
+                }
+                _nv_started = true;                     // The write cycle starts at STOP/CS rise.
+                n_nv_writes++;
+            }
+            *r = is_wiper ? ((data > full_scale) ? full_scale : data) : data;
+            break;
+        case 1:                                         // Increment (saturates at full scale).
+        case 2:                                         // Decrement (saturates at zero).
+            if (!is_wiper) {
+                n_cmd_errors++;
+                return false;
+            }
+            if ((cmd == 1) && (*r < full_scale)) {
+                (*r)++;
+            }
+            else if ((cmd == 2) && (*r > 0)) {
+                (*r)--;
+            }
+            break;
+        case 3:                                         // Read.
+            if (addr == 0x05) {                         // EEWA reflects the write cycle.
+                update_eewa();
+            }
+            _read_value = *r;
+            _read_pos = 0;
+            break;
+    }
+    n_cmds++;
+    return true;
+}
+
+
+// I2C address match.
+bool Sim_MCP4xxx::i2c_start(bool)
+{
+    _have_cmd = false;
+    _read_pos = 0;
+    return true;
+}
+
+
+// I2C byte written by the master.
+bool Sim_MCP4xxx::i2c_write(uint8_t data)
+{
+    if (_error) {                                       // NACK everything after an error until STOP.
+        return false;
+    }
+    if (!_have_cmd) {                                   // Command byte.
+        if (command_length(data) == 1) {
+            _error = !execute(data, 0);
+            return !_error;
+        }
+        if (((data >> 2) & 0x03) == 3) {                // Reads complete on the command byte.
+            _error = !execute(data, 0);
+            return !_error;
+        }
+        _cmd_byte = data;
+        _have_cmd = true;
+        return reg(data >> 4) != NULL;
+    }
+    _have_cmd = false;                                  // Data byte.
+    _error = !execute(_cmd_byte, data);
+    return !_error;
+}
+
+
+// I2C byte read by the master.
+uint8_t Sim_MCP4xxx::i2c_read(void)
+{
+    uint8_t reply = (_read_pos == 0) ? (0xFE | (_read_value >> 8)) : (_read_value & 0xFF);
+    _read_pos ^= 1;                                     // Continuous reads repeat the same register.
+    return reply;
+}
+
+
+// I2C STOP.
+void Sim_MCP4xxx::i2c_stop(void)
+{
+    _have_cmd = false;
+    _error = false;
+    nv_start();
+}
+
+
+// I2C repeated START (the EEPROM write cycle waits for the STOP).
+void Sim_MCP4xxx::i2c_restart(void)
+{
+    _have_cmd = false;
+    _error = false;
+}
+
+
+// SPI chip select edge.
+void Sim_MCP4xxx::spi_select(bool selected)
+{
+    _have_cmd = false;
+    _error = false;
+    if (!selected) {
+        nv_start();
+    }
+}
+
+
+// SPI byte exchange.
+uint8_t Sim_MCP4xxx::spi_transfer(uint8_t data)
+{
+    if (_error) {                                       // SDO stays low after an error until CS rises.
+        return 0x00;
+    }
+    if (!_have_cmd) {                                   // Command byte.
+        uint8_t cmd = (data >> 2) & 0x03;
+        uint16_t *r = reg(data >> 4);
+        if ((data >> 4) == 0x05) {                      // STATUS shifts out from the command byte on.
+            update_eewa();
+        }
+        bool nv_write = (cmd == 0) && (((data >> 4) == 0x02) || ((data >> 4) == 0x03));
+        if ((r == NULL) || (((cmd == 1) || (cmd == 2)) && ((data >> 4) > 0x01)) || (nv_write && nv_rejected(data >> 4))) {
+            _error = true;                              // CMDERR bit reads 0.
+            n_cmd_errors++;
+            return 0xFD;
+        }
+        if (command_length(data) == 1) {
+            execute(data, 0);
+            return 0xFF;
+        }
+        _cmd_byte = data;
+        _have_cmd = true;
+        return 0xFE | ((*r >> 8) & 0x01);               // CMDERR set, then D8.
+    }
+    _have_cmd = false;                                  // Data byte.
+    uint16_t value = *reg(_cmd_byte >> 4);              // Data shifted out before the write takes effect.
+    if (!execute(_cmd_byte, data)) {
+        _error = true;
+        return 0x00;
+    }
+    return value & 0xFF;
+}
+
+
+// MCP40D1X **********************************************************************************************************//
+
+// Simulator constructor.
+Sim_MCP40D1x::Sim_MCP40D1x(uint8_t addr)
+{
+    i2c_addr = addr;
+    wiper = 0x40;                           // Wiper powers up at mid-scale.
+    n_writes = 0;
+    _pos = 0;
+}
+
+
+bool Sim_MCP40D1x::i2c_start(bool)
+{
+    _pos = 0;
+    return true;
+}
+
+
+bool Sim_MCP40D1x::i2c_write(uint8_t data)
+{
+    if (_pos == 0) {                        // Command byte must be 0x00.
+        _pos++;
+        return data == 0x00;
+    }
+    if (_pos == 1) {                        // Wiper value.
+        wiper = data & 0x7F;
+        n_writes++;
+        _pos++;
+        return true;
+    }
+    return false;                           // Extra bytes are NACKed.
+}
+
+
+uint8_t Sim_MCP40D1x::i2c_read(void)
+{
+    return wiper;
+}
+
+
+void Sim_MCP40D1x::i2c_stop(void)
+{
+    _pos = 0;
+}
+
+
+// AD5273 ************************************************************************************************************//
+
+// Simulator constructor.
+Sim_AD5273::Sim_AD5273(uint8_t addr)
+{
+    i2c_addr = addr;
+    wiper = 0x20;                           // Wiper powers up at mid-scale.
+    n_writes = 0;
+    _pos = 0;
+}
+
+
+bool Sim_AD5273::i2c_start(bool)
+{
+    _pos = 0;
+    return true;
+}
+
+
+bool Sim_AD5273::i2c_write(uint8_t data)
+{
+    if (_pos == 0) {                        // Instruction byte.
+        _pos++;
+        return true;
+    }
+    if (_pos == 1) {                        // 6-bit wiper value.
+        wiper = data & 0x3F;
+        n_writes++;
+        _pos++;
+        return true;
+    }
+    return false;
+}
+
+
+uint8_t Sim_AD5273::i2c_read(void)
+{
+    return wiper & 0x3F;                    // Read needs no command; E1/E0 fuse bits read as zero.
+}
+
+
+void Sim_AD5273::i2c_stop(void)
+{
+    _pos = 0;
+}
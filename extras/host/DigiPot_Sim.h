@@ -0,0 +1,131 @@
+/*!
+	DigiPot_Sim.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Register-level simulations of the digital potentiometers/rheostats 
+	supported by Vulintus_DigiPot, for use with the host "TwoWire" and 
+	"SPIClass" stand-ins:
+		- Sim_MCP4xxx  -> MCP41xx/42xx (SPI) and MCP45xx/46xx (I2C), with 
+		                  wipers, TCON, STATUS, 7/8-bit range, and saturating 
+		                  increment/decrement.
+		- Sim_MCP40D1x -> MCP40D17/18/19 (I2C, command byte 0x00).
+		- Sim_AD5273   -> AD5273 (I2C, command-less read).
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Simulators first created.
+		2026-10-17 - Drew Sloan - Added MCP4xxx EEPROM (NV wiper) variants 
+		                          with a timed write cycle and WiperLock.
+		2026-10-17 - Drew Sloan - The MCP4xxx simulator follows Hs-mode (3.4 MHz) 
+		                          I2C clocks.
+		2026-10-17 - Drew Sloan - The EEPROM write cycle starts at the I2C STOP 
+		                          or SPI chip select rising edge, and rejected 
+		                          SPI NV writes flag CMDERR.
+		2026-10-17 - Drew Sloan - SPI STATUS reads shift out the current EEWA 
+		                          bit, not the one from the previous read.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_SIM_H
+#define VULINTUS_DIGIPOT_SIM_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <SPI.h>
+
+
+// CLASSES ***********************************************************************************************************//
+class Sim_MCP4xxx : public Host_I2C_device, public Host_SPI_device
+{
+    public:
+
+        Sim_MCP4xxx(uint16_t n_steps, uint8_t n_wipers);
+
+        // Simulated registers. //
+        uint16_t wiper[2];          // Volatile wipers.
+        uint16_t tcon;              // Terminal control register.
+        uint16_t status;            // Status register.
+        uint16_t full_scale;        // Full-scale wiper value (0x80 or 0x100).
+        uint8_t n_wipers;           // Number of wipers.
+        bool has_eeprom;            // True for EE variants (NV wipers at 0x02/0x03).
+        uint16_t nv_wiper[2];       // Nonvolatile wipers.
+        uint32_t eewa_until_us;     // End of the current EEPROM write cycle ("micros" time).
+        uint32_t n_nv_writes;       // EEPROM write cycles started.
+
+        // Counters. //
+        uint32_t n_cmds;            // Valid commands executed.
+        uint32_t n_cmd_errors;      // Invalid commands received.
+
+        // I2C interface. //
+        bool i2c_start(bool read);
+        bool i2c_write(uint8_t data);
+        uint8_t i2c_read(void);
+        void i2c_stop(void);
+        void i2c_restart(void);
+        uint32_t i2c_max_clock(void) { return 3400000; }   // Hs-mode capable.
+
+        // SPI interface. //
+        void spi_select(bool selected);
+        uint8_t spi_transfer(uint8_t data);
+
+    private:
+
+        uint8_t _cmd_byte;          // Command byte waiting for its data byte.
+        bool _have_cmd;             // True if a command byte is pending.
+        bool _error;                // Command error latched until deselect/STOP.
+        uint16_t _read_value;       // Value being read out.
+        uint8_t _read_pos;          // Byte position within the read value.
+        bool _nv_started;           // NV write accepted, cycle starts at STOP/CS rise.
+
+        uint16_t *reg(uint8_t addr);                // Find a register by address.
+        bool nv_rejected(uint8_t addr);             // True if an NV wiper write would be rejected.
+        void nv_start(void);                        // Start the EEPROM write cycle at STOP/CS rise.
+        void update_eewa(void);                     // Refresh the STATUS EEWA bit from the write cycle.
+        bool execute(uint8_t hi, uint8_t lo);       // Execute a complete command.
+        uint8_t command_length(uint8_t hi);         // 1 for increment/decrement, 2 otherwise.
+
+};
+
+
+class Sim_MCP40D1x : public Host_I2C_device
+{
+    public:
+
+        Sim_MCP40D1x(uint8_t addr);
+
+        uint8_t wiper;              // Volatile wiper (0-127).
+        uint32_t n_writes;          // Wiper writes executed.
+
+        bool i2c_start(bool read);
+        bool i2c_write(uint8_t data);
+        uint8_t i2c_read(void);
+        void i2c_stop(void);
+
+    private:
+
+        uint8_t _pos;               // Byte position within the current write.
+
+};
+
+
+class Sim_AD5273 : public Host_I2C_device
+{
+    public:
+
+        Sim_AD5273(uint8_t addr);
+
+        uint8_t wiper;              // Wiper (0-63).
+        uint32_t n_writes;          // Wiper writes executed.
+
+        bool i2c_start(bool read);
+        bool i2c_write(uint8_t data);
+        uint8_t i2c_read(void);
+        void i2c_stop(void);
+
+    private:
+
+        uint8_t _pos;               // Byte position within the current write.
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_SIM_H
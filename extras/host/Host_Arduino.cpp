@@ -0,0 +1,631 @@
+/*!
+	Host_Arduino.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Host implementations of the Arduino core, "TwoWire" and "SPIClass" 
+	stand-ins. See "Arduino.h", "Wire.h" and "SPI.h" in this folder.
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Host layer first created.
+		2026-10-17 - Drew Sloan - Added I2C High-speed mode (master code) handling.
+		2026-10-17 - Drew Sloan - Added "analogRead" with a simulated analog source.
+		2026-10-17 - Drew Sloan - Hs master codes can be made to fail.
+		2026-10-17 - Drew Sloan - Repeated STARTs call "i2c_restart" instead of "i2c_stop".
+		2026-10-17 - Drew Sloan - SPI transfers can be made to fail.
+		2026-10-17 - Drew Sloan - Added the I2C core timeout and bus stalls.
+*/
+
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <SPI.h>
+
+
+// ARDUINO CORE ******************************************************************************************************//
+
+static uint64_t _host_ns = 0;                   // Simulated clock, in nanoseconds.
+static uint8_t _host_pins[HOST_NUM_PINS];       // Simulated pin output states.
+static Host_analog_fn _host_analog = NULL;      // Simulated analog source.
+static void *_host_analog_context = NULL;       // User pointer passed to the analog source.
+static int _host_analog_bits = 10;              // "analogRead" resolution.
+
+static struct Host_pins_init {                  // Start with every pin pulled high (chip selects idle).
+    Host_pins_init(void) { memset(_host_pins, HIGH, sizeof(_host_pins)); }
+} _host_pins_init;
+
+HardwareSerial Serial;
+TwoWire Wire;
+SPIClass SPI;
+SPIClass *SPIClass::buses[4] = {NULL, NULL, NULL, NULL};
+
+
+void pinMode(uint8_t, uint8_t)
+{
+}
+
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if (_host_pins[pin] == val) {               // Ignore writes that don't change the pin.
+        return;
+    }
+    _host_pins[pin] = val;                      // Save the new state.
+    for (uint8_t i = 0; i < 4; i++) {           // Let each SPI bus watch its chip select pins.
+        if (SPIClass::buses[i] != NULL) {
+            SPIClass::buses[i]->pin_changed(pin, val);
+        }
+    }
+}
+
+
+int digitalRead(uint8_t pin)
+{
+    return _host_pins[pin];
+}
+
+
+uint32_t micros(void)
+{
+    return (uint32_t) (_host_ns / 1000);
+}
+
+
+uint32_t millis(void)
+{
+    return (uint32_t) (_host_ns / 1000000);
+}
+
+
+void delay(uint32_t ms)
+{
+    _host_ns += (uint64_t) ms * 1000000;
+}
+
+
+void delayMicroseconds(uint32_t us)
+{
+    _host_ns += (uint64_t) us * 1000;
+}
+
+
+void noInterrupts(void)
+{
+}
+
+
+void interrupts(void)
+{
+}
+
+
+void yield(void)
+{
+}
+
+
+int analogRead(uint8_t pin)
+{
+    if (_host_analog == NULL) {
+        return 0;
+    }
+    uint32_t level = _host_analog(pin, _host_analog_context);   // Q16 fraction of full scale.
+    if (level > 0x10000) {
+        level = 0x10000;
+    }
+    uint32_t full_scale = (1UL << _host_analog_bits) - 1;
+    return (int) (((uint64_t) level * full_scale + 0x8000) >> 16);
+}
+
+
+void analogReadResolution(int bits)
+{
+    if ((bits >= 1) && (bits <= 16)) {
+        _host_analog_bits = bits;
+    }
+}
+
+
+void host_advance_ns(uint32_t ns)
+{
+    _host_ns += ns;
+}
+
+
+uint64_t host_time_ns(void)
+{
+    return _host_ns;
+}
+
+
+void host_reset_time(void)
+{
+    _host_ns = 0;
+}
+
+
+void host_set_analog(Host_analog_fn fn, void *context)
+{
+    _host_analog = fn;
+    _host_analog_context = context;
+}
+
+
+// PRINT/STREAM ******************************************************************************************************//
+
+size_t Print::write(uint8_t c)
+{
+    return fwrite(&c, 1, 1, stdout);
+}
+
+
+size_t Print::write(const uint8_t *buf, size_t n)
+{
+    size_t count = 0;
+    while (n--) {
+        count += write(*buf++);
+    }
+    return count;
+}
+
+
+static size_t print_fmt(Print *p, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static size_t print_fmt(Print *p, const char *fmt, ...)
+{
+    char buf[64];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n < 0) {
+        return 0;
+    }
+    return p->write((const uint8_t *) buf, strlen(buf));
+}
+
+
+static size_t print_base(Print *p, unsigned long n, int base, bool negative)
+{
+    char buf[8 * sizeof(long) + 2];
+    char *str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) {
+        base = 10;
+    }
+    do {
+        uint8_t digit = n % base;
+        n /= base;
+        *--str = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+    } while (n);
+    if (negative) {
+        *--str = '-';
+    }
+    return p->write((const uint8_t *) str, strlen(str));
+}
+
+
+size_t Print::print(const char *str)              { return write((const uint8_t *) str, strlen(str)); }
+size_t Print::print(char c)                       { return write((uint8_t) c); }
+size_t Print::print(long n, int base)             { return (n < 0) ? print_base(this, -n, base, true) : print_base(this, n, base, false); }
+size_t Print::print(unsigned long n, int base)    { return print_base(this, n, base, false); }
+size_t Print::print(int n, int base)              { return print((long) n, base); }
+size_t Print::print(unsigned int n, int base)     { return print((unsigned long) n, base); }
+size_t Print::print(double n, int digits)         { return print_fmt(this, "%.*f", digits, n); }
+
+size_t Print::println(void)                       { return print("\r\n"); }
+size_t Print::println(const char *str)            { return print(str) + println(); }
+size_t Print::println(char c)                     { return print(c) + println(); }
+size_t Print::println(long n, int base)           { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base)  { return print(n, base) + println(); }
+size_t Print::println(int n, int base)            { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base)   { return print(n, base) + println(); }
+size_t Print::println(double n, int digits)       { return print(n, digits) + println(); }
+
+int Stream::available(void)                       { return 0; }
+int Stream::read(void)                            { return -1; }
+
+void HardwareSerial::begin(uint32_t)               { }
+
+
+// TWOWIRE ***********************************************************************************************************//
+
+TwoWire::TwoWire(void)
+{
+    _n_devs = 0;
+    _clock = 100000;
+    _in_transaction = false;
+    _hs = false;
+    _active = NULL;
+    _tx_len = 0;
+    _rx_len = 0;
+    _rx_pos = 0;
+    n_begins = 0;
+    master_code_reply = 2;
+    stall_us = 0;
+    _timeout_us = 0;
+    _timeout_flag = false;
+    reset_stats();
+}
+
+
+void TwoWire::begin(void)
+{
+    n_begins++;
+}
+
+
+void TwoWire::end(void)
+{
+}
+
+
+void TwoWire::setClock(uint32_t clock)
+{
+    stats.clock_sets++;
+    if (clock != _clock) {
+        stats.clock_changes++;
+        _clock = clock;
+    }
+}
+
+
+void TwoWire::beginTransmission(uint8_t addr)
+{
+    _tx_addr = addr;
+    _tx_len = 0;
+}
+
+
+size_t TwoWire::write(uint8_t data)
+{
+    if (_tx_len >= BUFFER_LENGTH) {
+        return 0;
+    }
+    _tx_buf[_tx_len++] = data;
+    return 1;
+}
+
+
+size_t TwoWire::write(const uint8_t *buf, size_t n)
+{
+    size_t count = 0;
+    while (n-- && write(*buf++)) {
+        count++;
+    }
+    return count;
+}
+
+
+uint8_t TwoWire::endTransmission(bool send_stop)
+{
+    uint8_t error = 0;
+    if (stalled()) {                            // The deadline passed with the bus held.
+        _tx_len = 0;
+        return 5;
+    }
+    if (((_tx_addr & 0x7C) == 0x04) && (_tx_len == 0)) {    // Hs master code (0000 1XXX).
+        if (!_in_transaction) {
+            stats.transactions++;
+        }
+        _in_transaction = true;
+        stats.starts++;
+        stats.hs_entries++;
+        clock_bits(10);                         // START, master code and the (missing) ACK.
+        stats.bytes++;
+        _active = NULL;
+        if (master_code_reply != 2) {           // Simulated bus error: the bus is released, Hs-mode isn't entered.
+            stop();
+            return master_code_reply;
+        }
+        _hs = true;                             // Hs-mode until the next STOP.
+        if (send_stop) {
+            stop();
+        }
+        return 2;                               // Nobody acknowledges a master code.
+    }
+    if (!start(_tx_addr, false)) {              // Address NACK.
+        error = 2;
+    }
+    else {
+        for (uint8_t i = 0; i < _tx_len; i++) { // Clock out each data byte.
+            clock_bits(9);
+            stats.bytes++;
+            if (!_active->i2c_write(_tx_buf[i])) {
+                stats.nacks++;
+                error = 3;                      // Data NACK.
+                break;
+            }
+        }
+    }
+    _tx_len = 0;
+    if (send_stop || error) {
+        stop();
+    }
+    return error;
+}
+
+
+uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t qty, uint8_t send_stop)
+{
+    _rx_len = 0;
+    _rx_pos = 0;
+    if (qty > BUFFER_LENGTH) {
+        qty = BUFFER_LENGTH;
+    }
+    if (stalled()) {                            // The deadline passed with the bus held.
+        return 0;
+    }
+    if (!start(addr, true)) {                   // Address NACK.
+        stop();
+        return 0;
+    }
+    while (_rx_len < qty) {                     // Clock in each data byte.
+        clock_bits(9);
+        stats.bytes++;
+        _rx_buf[_rx_len++] = _active->i2c_read();
+    }
+    if (send_stop) {
+        stop();
+    }
+    return _rx_len;
+}
+
+
+int TwoWire::available(void)
+{
+    return _rx_len - _rx_pos;
+}
+
+
+int TwoWire::read(void)
+{
+    if (_rx_pos >= _rx_len) {
+        return -1;
+    }
+    return _rx_buf[_rx_pos++];
+}
+
+
+int TwoWire::peek(void)
+{
+    if (_rx_pos >= _rx_len) {
+        return -1;
+    }
+    return _rx_buf[_rx_pos];
+}
+
+
+void TwoWire::setWireTimeout(uint32_t timeout_us, bool)
+{
+    _timeout_us = timeout_us;
+    _timeout_flag = false;
+}
+
+
+bool TwoWire::getWireTimeoutFlag(void)
+{
+    return _timeout_flag;
+}
+
+
+void TwoWire::clearWireTimeoutFlag(void)
+{
+    _timeout_flag = false;
+}
+
+
+bool TwoWire::attach(Host_I2C_device *dev)
+{
+    if (_n_devs >= HOST_I2C_MAX_DEVICES) {
+        return false;
+    }
+    _devs[_n_devs++] = dev;
+    return true;
+}
+
+
+void TwoWire::reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+
+Host_I2C_device *TwoWire::find(uint8_t addr)
+{
+    for (uint8_t i = 0; i < _n_devs; i++) {
+        if (_devs[i]->i2c_addr == addr) {
+            return _devs[i];
+        }
+    }
+    return NULL;
+}
+
+
+void TwoWire::clock_bits(uint32_t n_bits)
+{
+    uint64_t ns = ((uint64_t) n_bits * 1000000000ULL) / _clock;
+    stats.busy_ns += ns;
+    host_advance_ns((uint32_t) ns);
+}
+
+
+bool TwoWire::stalled(void)
+{
+    if (stall_us == 0) {
+        return false;
+    }
+    uint32_t limit_us = (_timeout_us > 0) ? _timeout_us : 1000000;
+    if (stall_us < limit_us) {                  // The device lets go in time.
+        host_advance_ns(stall_us * 1000);
+        return false;
+    }
+    host_advance_ns(limit_us * 1000);           // The core gives up at the deadline...
+    stats.timeouts++;
+    _timeout_flag = true;
+    stop();                                     // ...and releases the bus.
+    return true;
+}
+
+
+bool TwoWire::start(uint8_t addr, bool read)
+{
+    if (!_in_transaction) {                     // A new START...
+        stats.transactions++;
+    }
+    else if (_active != NULL) {                 // ...or a repeated START.
+        _active->i2c_restart();
+    }
+    _in_transaction = true;
+    stats.starts++;
+    clock_bits(1);
+    clock_bits(9);                              // Address byte plus ACK.
+    stats.bytes++;
+    _active = find(addr);
+    if ((_active != NULL) && (_clock > 400000) && (!_hs || (_clock > _active->i2c_max_clock()))) {
+        _active = NULL;                         // The device can't follow this clock rate.
+    }
+    if ((_active == NULL) || !_active->i2c_start(read)) {
+        _active = NULL;
+        stats.nacks++;
+        return false;
+    }
+    return true;
+}
+
+
+void TwoWire::stop(void)
+{
+    if (!_in_transaction) {
+        return;
+    }
+    if (_active != NULL) {
+        _active->i2c_stop();
+    }
+    _active = NULL;
+    _in_transaction = false;
+    _hs = false;                                // Devices drop out of Hs-mode at a STOP.
+    stats.stops++;
+    clock_bits(1);
+}
+
+
+// SPICLASS **********************************************************************************************************//
+
+SPIClass::SPIClass(void)
+{
+    _n_devs = 0;
+    _clock = 4000000;
+    n_begins = 0;
+    fail = false;
+    _last_error = 0;
+    reset_stats();
+    for (uint8_t i = 0; i < 4; i++) {           // Register the bus for the chip select hook.
+        if (buses[i] == NULL) {
+            buses[i] = this;
+            break;
+        }
+    }
+}
+
+
+void SPIClass::begin(void)
+{
+    n_begins++;
+}
+
+
+void SPIClass::end(void)
+{
+}
+
+
+void SPIClass::beginTransaction(SPISettings settings)
+{
+    stats.transactions++;
+    _clock = settings.clock;
+    _last_error = 0;
+}
+
+
+void SPIClass::endTransaction(void)
+{
+}
+
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    stats.transfer_calls++;
+    stats.bytes++;
+    uint64_t ns = (8ULL * 1000000000ULL) / _clock;
+    stats.busy_ns += ns;
+    host_advance_ns((uint32_t) ns);
+    uint8_t reply = 0xFF;                       // Idle (pulled-up) MISO.
+    if (fail) {                                 // Simulated failure: nothing reaches the devices.
+        _last_error = 4;
+        return reply;
+    }
+    for (uint8_t i = 0; i < _n_devs; i++) {     // Exchange a byte with every selected device.
+        if (digitalRead(_devs[i]->pin_cs) == LOW) {
+            reply &= _devs[i]->spi_transfer(data);
+        }
+    }
+    return reply;
+}
+
+
+uint16_t SPIClass::transfer16(uint16_t data)
+{
+    uint16_t reply = transfer(data >> 8) << 8;
+    reply |= transfer(data & 0xFF);
+    stats.transfer_calls--;                     // Count the pair as a single call.
+    return reply;
+}
+
+
+void SPIClass::transfer(void *buf, size_t count)
+{
+    uint8_t *p = (uint8_t *) buf;
+    if (!count) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        p[i] = transfer(p[i]);
+    }
+    stats.transfer_calls -= (count - 1);        // Count the block as a single call.
+}
+
+
+uint8_t SPIClass::last_error(void)
+{
+    return _last_error;
+}
+
+
+bool SPIClass::attach(Host_SPI_device *dev)
+{
+    if (_n_devs >= HOST_SPI_MAX_DEVICES) {
+        return false;
+    }
+    _devs[_n_devs++] = dev;
+    return true;
+}
+
+
+void SPIClass::reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+
+void SPIClass::pin_changed(uint8_t pin, uint8_t val)
+{
+    for (uint8_t i = 0; i < _n_devs; i++) {
+        if (_devs[i]->pin_cs == pin) {
+            stats.cs_edges++;
+            _devs[i]->spi_select(val == LOW);
+        }
+    }
+}
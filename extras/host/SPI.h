@@ -0,0 +1,114 @@
+/*!
+	SPI.h (host build)
+
+	copyright 2026, Vulintus, Inc.
+
+	Stand-in "SPIClass" for host builds. Bytes are routed to simulated SPI 
+	devices attached with "attach()", selected by watching their chip select
+	pins through "digitalWrite()". Transactions, bytes and CS edges are 
+	counted.
+
+	Set "fail" to make transfers fail, as a failed spidev system call does
+	on Linux: nothing reaches the devices, replies read 0xFF, and
+	"last_error" reports the failure until the next "beginTransaction"
+	(DIGIPOT_SPI_ERRORS).
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Host layer first created.
+		2026-10-17 - Drew Sloan - Added "fail" and "last_error".
+*/
+
+
+#ifndef VULINTUS_HOST_SPI_H
+#define VULINTUS_HOST_SPI_H
+
+#include <Arduino.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define SPI_MODE0   0x00
+#define SPI_MODE1   0x04
+#define SPI_MODE2   0x08
+#define SPI_MODE3   0x0C
+
+#define HOST_SPI_MAX_DEVICES    16      // Maximum number of simulated devices per bus.
+
+#ifndef DIGIPOT_SPI_ERRORS
+    #define DIGIPOT_SPI_ERRORS          // This SPIClass reports failed transfers ("last_error").
+#endif
+
+struct Host_SPI_stats {
+    uint32_t transactions;      // Calls to "beginTransaction()".
+    uint32_t transfer_calls;    // Calls to any "transfer()" function.
+    uint32_t bytes;             // Bytes clocked on the wire.
+    uint32_t cs_edges;          // Chip select edges on attached devices.
+    uint64_t busy_ns;           // Simulated time spent clocking bits.
+};
+
+
+// CLASSES ***********************************************************************************************************//
+class SPISettings
+{
+    public:
+
+        SPISettings(void) : clock(4000000), bit_order(MSBFIRST), data_mode(SPI_MODE0) { }
+        SPISettings(uint32_t clock, uint8_t bit_order, uint8_t data_mode)
+            : clock(clock), bit_order(bit_order), data_mode(data_mode) { }
+
+        uint32_t clock;
+        uint8_t bit_order;
+        uint8_t data_mode;
+
+};
+
+
+class Host_SPI_device
+{
+    public:
+
+        uint8_t pin_cs;                                 // Chip select pin.
+
+        virtual void spi_select(bool selected) = 0;     // Chip select edge (true = asserted/low).
+        virtual uint8_t spi_transfer(uint8_t data) = 0; // Exchange one byte.
+
+};
+
+
+class SPIClass
+{
+    public:
+
+        SPIClass(void);
+
+        // Arduino API. //
+        void begin(void);
+        void end(void);
+        void beginTransaction(SPISettings settings);
+        void endTransaction(void);
+        uint8_t transfer(uint8_t data);
+        uint16_t transfer16(uint16_t data);
+        void transfer(void *buf, size_t count);
+
+        // Host-only functions. //
+        bool attach(Host_SPI_device *dev);      // Attach a simulated device.
+        uint8_t last_error(void);               // First failed transfer since "beginTransaction" (0 if none).
+        bool fail;                              // Set to make every transfer fail.
+        void reset_stats(void);                 // Clear the counters.
+        void pin_changed(uint8_t pin, uint8_t val);     // Chip select hook called by "digitalWrite()".
+        Host_SPI_stats stats;                   // Bus counters.
+        uint32_t n_begins;                      // Calls to "begin()".
+
+        static SPIClass *buses[4];              // All SPI buses, for the chip select hook.
+
+    private:
+
+        Host_SPI_device *_devs[HOST_SPI_MAX_DEVICES];
+        uint8_t _n_devs;
+        uint32_t _clock;
+        uint8_t _last_error;
+
+};
+
+extern SPIClass SPI;
+
+#endif      // #ifndef VULINTUS_HOST_SPI_H
@@ -0,0 +1,145 @@
+/*!
+	Wire.h (host build)
+
+	copyright 2026, Vulintus, Inc.
+
+	Stand-in "TwoWire" class for host builds. Transactions are routed to 
+	simulated I2C devices attached with "attach()", and every START, STOP, 
+	byte, NACK and clock change is counted.
+
+	Clock rates above 400 kHz need High-speed mode: a master code (address
+	0x04-0x07, never acknowledged) puts the bus in Hs-mode until the next
+	STOP. Devices NACK their address at rates above 400 kHz outside of
+	Hs-mode, or above their own "i2c_max_clock". Unlike the stock AVR, SAMD
+	and ESP32 Wire libraries, this one keeps the bus after the master code
+	when asked to, so it opts in to the library's High-speed mode
+	(DIGIPOT_I2C_HS_MODE). Set "master_code_reply" to make master codes
+	fail with another "endTransmission" code.
+
+	Like the AVR core, this one defines WIRE_HAS_TIMEOUT. Set "stall_us" to
+	make every blocking call ("endTransmission", "requestFrom") hold the
+	bus that long first, as a device stretching the clock would. A stall at
+	or past the timeout set with "setWireTimeout" (one second if none is
+	set) is aborted at the deadline: the call fails with code 5 and sets 
+	the timeout flag.
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Host layer first created.
+		2026-10-17 - Drew Sloan - Added High-speed mode (master code) handling.
+		2026-10-17 - Drew Sloan - Opts in to DIGIPOT_I2C_HS_MODE. Added 
+		                          "master_code_reply".
+		2026-10-17 - Drew Sloan - Added "i2c_restart" so devices can tell a 
+		                          repeated START from a STOP.
+		2026-10-17 - Drew Sloan - Added the core timeout (WIRE_HAS_TIMEOUT) and 
+		                          "stall_us".
+*/
+
+
+#ifndef VULINTUS_HOST_WIRE_H
+#define VULINTUS_HOST_WIRE_H
+
+#include <Arduino.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define BUFFER_LENGTH           32      // Same transmit/receive buffer size as the AVR Wire library.
+#define HOST_I2C_MAX_DEVICES    16      // Maximum number of simulated devices per bus.
+
+#ifndef DIGIPOT_I2C_HS_MODE
+    #define DIGIPOT_I2C_HS_MODE         // This TwoWire keeps the bus after the Hs master code.
+#endif
+
+#ifndef WIRE_HAS_TIMEOUT
+    #define WIRE_HAS_TIMEOUT            // This TwoWire has "setWireTimeout" (like the AVR core).
+#endif
+
+struct Host_I2C_stats {
+    uint32_t transactions;      // Transactions (START through STOP).
+    uint32_t starts;            // START and repeated START conditions.
+    uint32_t stops;             // STOP conditions.
+    uint32_t bytes;             // Bytes on the wire, including address bytes.
+    uint32_t nacks;             // Address or data NACKs.
+    uint32_t clock_changes;     // Calls to "setClock()" that changed the clock.
+    uint32_t clock_sets;        // All calls to "setClock()".
+    uint32_t hs_entries;        // Hs master codes sent.
+    uint32_t timeouts;          // Blocking calls aborted at the deadline.
+    uint64_t busy_ns;           // Simulated time spent clocking bits.
+};
+
+
+// CLASSES ***********************************************************************************************************//
+class Host_I2C_device
+{
+    public:
+
+        uint8_t i2c_addr;                                   // 7-bit I2C address.
+
+        virtual bool i2c_start(bool) { return true; }       // Addressed after a START with the read flag (return false to NACK).
+        virtual bool i2c_write(uint8_t data) = 0;           // Byte written by the master (return false to NACK).
+        virtual uint8_t i2c_read(void) = 0;                 // Byte read by the master.
+        virtual void i2c_stop(void) { }                     // STOP condition.
+        virtual void i2c_restart(void) { i2c_stop(); }      // Repeated START (ends the device's transfer like a STOP by default).
+        virtual uint32_t i2c_max_clock(void) { return 400000; }    // Fastest clock the device follows (Hz).
+
+};
+
+
+class TwoWire : public Stream
+{
+    public:
+
+        TwoWire(void);
+
+        // Arduino API. //
+        void begin(void);
+        void end(void);
+        void setClock(uint32_t clock);
+        void beginTransmission(uint8_t addr);
+        uint8_t endTransmission(bool send_stop = true);
+        uint8_t requestFrom(uint8_t addr, uint8_t qty, uint8_t send_stop = 1);
+        size_t write(uint8_t data);
+        size_t write(const uint8_t *buf, size_t n);
+        int available(void);
+        int read(void);
+        int peek(void);
+        void setWireTimeout(uint32_t timeout_us = 25000, bool reset_with_timeout = false);
+        bool getWireTimeoutFlag(void);
+        void clearWireTimeoutFlag(void);
+
+        // Host-only functions. //
+        bool attach(Host_I2C_device *dev);      // Attach a simulated device.
+        void reset_stats(void);                 // Clear the counters.
+        Host_I2C_stats stats;                   // Bus counters.
+        uint32_t clock(void) { return _clock; } // Current clock rate.
+        uint32_t n_begins;                      // Calls to "begin()".
+        uint8_t master_code_reply;              // "endTransmission" code for Hs master codes (2, the normal NACK, by default).
+        uint32_t stall_us;                      // Time each blocking call holds the bus before it runs (0 by default).
+
+    private:
+
+        Host_I2C_device *_devs[HOST_I2C_MAX_DEVICES];
+        uint8_t _n_devs;
+        uint32_t _clock;
+        bool _in_transaction;               // True between a START and a STOP.
+        bool _hs;                           // True from an Hs master code to the next STOP.
+        Host_I2C_device *_active;           // Device addressed since the last STOP.
+        uint8_t _tx_addr;
+        uint8_t _tx_buf[BUFFER_LENGTH];
+        uint8_t _tx_len;
+        uint8_t _rx_buf[BUFFER_LENGTH];
+        uint8_t _rx_len;
+        uint8_t _rx_pos;
+        uint32_t _timeout_us;               // Deadline for each blocking call (0 if none).
+        bool _timeout_flag;                 // True once a call has timed out.
+
+        Host_I2C_device *find(uint8_t addr);
+        void clock_bits(uint32_t n_bits);
+        bool start(uint8_t addr, bool read);
+        void stop(void);
+        bool stalled(void);
+
+};
+
+extern TwoWire Wire;
+
+#endif      // #ifndef VULINTUS_HOST_WIRE_H
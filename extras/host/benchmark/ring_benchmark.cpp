@@ -0,0 +1,77 @@
+/*!
+	ring_benchmark.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Enqueue cost of "Vulintus_DigiPot_Ring::push", the call an ISR makes.
+	Pushes go out in batches of 8 into a ring that is cleared between
+	batches, so every push takes the normal (not full) path. Prints the
+	average and best cost per push, in TSC cycles on x86 and nanoseconds
+	elsewhere. This only measures the host CPU; on AVR, count the inlined
+	instructions in the listing instead.
+
+	Build and run with "make benchmark" (built at -O2).
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Benchmark first created.
+*/
+
+
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define N_PUSHES        8000000         // Pushes timed.
+#define BATCH           8               // Pushes between timer reads.
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define BENCH_UNITS     "TSC cycles"
+    static inline uint64_t bench_now(void) { return __rdtsc(); }
+#else
+    #define BENCH_UNITS     "ns"
+    static inline uint64_t bench_now(void)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    }
+#endif
+
+
+int main(void)
+{
+    Sim_MCP4xxx chip(256, 2);                       // MCP4661 (8-bit, dual, I2C).
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_HLL;
+    Wire.attach(&chip);
+    Vulintus_MCP4661 pot(MCP4XXX_I2C_ADDR_HLL);
+    pot.begin();
+
+    Vulintus_DigiPot_Ring ring;
+    ring.add(&pot);
+
+    uint64_t total = 0;                             // Time across all batches.
+    uint64_t best = ~0ULL;                          // Fastest batch.
+    for (uint32_t rep = 0; rep < (N_PUSHES / BATCH); rep++) {
+        uint64_t start = bench_now();
+        for (uint8_t k = 0; k < BATCH; k++) {
+            ring.push(0, k & 1, k);
+        }
+        uint64_t elapsed = bench_now() - start;
+        ring.clear();                               // Empty the ring outside the timed section.
+        total += elapsed;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    printf("push: %.1f %s average, %.1f best (per push, batches of %d, including the timer read)\n", \
+            (double) total / N_PUSHES, BENCH_UNITS, (double) best / BATCH, BATCH);
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*!
+	example_main.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Runs "examples/Vulintus_DigiPot_Test" on the host. A simulated AD5273
+	(the sketch's default part) is attached at its default address, and
+	"analogRead" returns the voltage at its wiper, with the ends of the
+	ladder across the ADC reference. "setup" and one pass of "loop" run,
+	and the exit status is non-zero if the wiper doesn't end at full scale
+	(the last of the sketch's 8 steps).
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Example runner first created.
+*/
+
+
+#include <Arduino.h>
+#include "DigiPot_Sim.h"
+
+
+static Sim_AD5273 chip(0x58);                   // Simulated AD5273 at AD5273I2C_ADDR_L.
+
+
+// Wiper voltage, as a fraction of the ADC reference.
+static uint32_t wiper_level(uint8_t, void *context)
+{
+    Sim_AD5273 *sim = (Sim_AD5273 *) context;
+    return ((uint32_t) sim->wiper << 16) / 63;
+}
+
+
+int main(void)
+{
+    Wire.attach(&chip);                         // Put the simulated chip on the bus.
+    host_set_analog(wiper_level, &chip);        // Feed its wiper to every analog pin.
+    setup();
+    loop();
+    return (chip.wiper == 63) ? 0 : 1;
+}
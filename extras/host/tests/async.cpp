@@ -0,0 +1,154 @@
+/*!
+	async.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Asynchronous transaction queue test, against a simulated MCP4661 (I2C).
+	Queued writes and reads must leave the bus alone until "poll", run in
+	order, and report each result to the completion callback. A full queue,
+	a failed write and a "clear" must each leave the wiper cache unknown,
+	so the next write of the same value still reaches the chip.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// DEFINITIONS *******************************************************************************************************//
+struct Async_log {
+    uint8_t n_calls;                    // Callbacks received.
+    DigiPot_op op;                      // Last operation reported.
+    uint8_t wiper_i;                    // Last wiper reported.
+    DigiPot_status status;              // Last status reported.
+    uint16_t data;                      // Last data reported.
+    uint8_t n_cancelled;                // Callbacks with DIGIPOT_ERR_CANCELLED.
+};
+
+
+// Completion callback: log the result.
+static void on_done(Vulintus_DigiPot * /* pot */, DigiPot_op op, uint8_t wiper_i, DigiPot_status status, \
+        uint16_t data, void *context)
+{
+    Async_log *log = (Async_log *) context;
+    log->n_calls++;
+    log->op = op;
+    log->wiper_i = wiper_i;
+    log->status = status;
+    log->data = data;
+    if (status == DIGIPOT_ERR_CANCELLED) {
+        log->n_cancelled++;
+    }
+}
+
+
+int main(void)
+{
+    Sim_MCP4xxx chip(256, 2);                       // MCP4661 (8-bit, dual, I2C).
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_HLL;
+    Wire.attach(&chip);
+
+    Vulintus_MCP4661 pot(MCP4XXX_I2C_ADDR_HLL);
+    CHECK_EQ(pot.begin(), 0);
+    Vulintus_DigiPot_Queue queue;
+    Async_log log = {};
+    pot.set_async(&queue, on_done, &log);
+
+    // A queued write returns at once and leaves the bus alone until "poll".
+    Wire.reset_stats();
+    CHECK_EQ(pot.set_code(40, 0), 40);
+    CHECK_EQ(pot.status(), DIGIPOT_PENDING);
+    CHECK_EQ(queue.pending(), 1);
+    CHECK_EQ(Wire.stats.transactions, 0);
+    CHECK_EQ(chip.wiper[0], 128);
+    CHECK_EQ(queue.poll(), 1);
+    CHECK_EQ(chip.wiper[0], 40);
+    CHECK_EQ(log.n_calls, 1);
+    CHECK_EQ(log.op, DIGIPOT_OP_WRITE);
+    CHECK_EQ(log.status, DIGIPOT_OK);
+    CHECK_EQ(log.data, 40);
+    CHECK_EQ(queue.poll(), 0);                      // Nothing is left to run.
+
+    // Queued transactions run in order, and reads report the wiper value.
+    pot.set_code(60, 1);
+    CHECK_EQ(pot.get_code(1, true), DIGIPOT_CODE_INVALID);     // The value arrives in the callback.
+    CHECK_EQ(queue.pending(), 2);
+    CHECK_EQ(queue.flush(), 2);
+    CHECK_EQ(log.n_calls, 3);
+    CHECK_EQ(log.op, DIGIPOT_OP_READ);
+    CHECK_EQ(log.wiper_i, 1);
+    CHECK_EQ(log.data, 60);
+
+    // A full queue rejects the write, and the cache stays unknown.
+    for (uint8_t i = 0; i < DIGIPOT_QUEUE_LENGTH; i++) {
+        pot.set_code(i, 1);
+    }
+    CHECK_EQ(queue.pending(), DIGIPOT_QUEUE_LENGTH);
+    CHECK_EQ(pot.set_code(100, 0), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_QUEUE_FULL);
+    CHECK_EQ(queue.n_dropped, 1);
+    queue.flush();
+    CHECK_EQ(chip.wiper[1], DIGIPOT_QUEUE_LENGTH - 1);
+    CHECK_EQ(chip.wiper[0], 40);
+    pot.set_code(100, 0);                           // The rejected value is sent again.
+    queue.flush();
+    CHECK_EQ(chip.wiper[0], 100);
+
+    // A failed queued write clears the pending value from the cache.
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_HHH;           // The chip stops answering.
+    pot.set_code(20, 0);
+    queue.flush();
+    CHECK(log.status != DIGIPOT_OK);
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_HLL;
+    CHECK_EQ(chip.wiper[0], 100);
+    pot.set_code(20, 0);                            // Not skipped as "unchanged".
+    CHECK_EQ(queue.pending(), 1);
+    queue.flush();
+    CHECK_EQ(chip.wiper[0], 20);
+
+    // "clear" reports each dropped transaction and clears the pending values.
+    log.n_calls = 0;
+    pot.set_code(70, 0);
+    pot.set_code(80, 1);
+    queue.clear();
+    CHECK_EQ(queue.pending(), 0);
+    CHECK_EQ(log.n_calls, 2);
+    CHECK_EQ(log.n_cancelled, 2);
+    CHECK_EQ(chip.wiper[0], 20);
+    pot.set_code(70, 0);                            // Not skipped as "unchanged".
+    CHECK_EQ(queue.pending(), 1);
+    queue.flush();
+    CHECK_EQ(chip.wiper[0], 70);
+
+    // Increments are queued behind the writes before them.
+    pot.set_code(10, 0);
+    pot.increment(0);
+    pot.increment(0);
+    CHECK_EQ(queue.pending(), 3);
+    CHECK_EQ(chip.wiper[0], 70);
+    queue.flush();
+    CHECK_EQ(chip.wiper[0], 12);
+
+    // A step from an unknown value is rejected instead of jumping the queue.
+    pot.clear_cache();
+    pot.decrement(0);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_UNKNOWN);
+    CHECK_EQ(queue.pending(), 0);
+
+    // Staged steps move the staged target.
+    pot.set_async(NULL);
+    pot.set_code(50, 1);
+    pot.set_staged(true);
+    pot.set_code(30, 1);
+    pot.decrement(1);
+    CHECK_EQ(chip.wiper[1], 50);
+    CHECK_EQ(pot.flush(), 0);
+    CHECK_EQ(chip.wiper[1], 29);
+    pot.set_staged(false);
+
+    return host_test_done("async");
+}
@@ -0,0 +1,169 @@
+/*!
+	bus.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Bus-efficiency regression test: the transactions, bytes and simulated bus
+	time of the common driver paths, checked against the expected counts. A
+	change that adds a transaction or a byte to any of these paths fails
+	here.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// Print and return the I2C counters for one operation.
+static void report_i2c(const char *name)
+{
+    printf("%-32s I2C: %2u transactions, %2u bytes, %6.1f us\n", name, (unsigned) Wire.stats.transactions, \
+            (unsigned) Wire.stats.bytes, Wire.stats.busy_ns * 0.001);
+}
+
+
+// Print the SPI counters for one operation.
+static void report_spi(const char *name)
+{
+    printf("%-32s SPI: %2u transactions, %2u bytes, %6.1f us\n", name, (unsigned) SPI.stats.transactions, \
+            (unsigned) SPI.stats.bytes, SPI.stats.busy_ns * 0.001);
+}
+
+
+int main(void)
+{
+    Sim_MCP4xxx chip_i2c(256, 2);                   // MCP4661 (8-bit, dual, I2C).
+    chip_i2c.i2c_addr = MCP4XXX_I2C_ADDR_HLL;
+    Sim_MCP4xxx chip_spi(128, 2);                   // MCP4231 (7-bit, dual, SPI).
+    chip_spi.pin_cs = 9;
+    Sim_MCP40D1x chip_d1x(0x2E);                    // MCP40D18.
+    Wire.attach(&chip_i2c);
+    Wire.attach(&chip_d1x);
+    SPI.attach(&chip_spi);
+
+    Vulintus_MCP4661 pot_i2c(MCP4XXX_I2C_ADDR_HLL);
+    Vulintus_MCP4231 pot_spi(9);
+    Vulintus_MCP40D18 pot_d1x;
+    CHECK_EQ(pot_i2c.begin(), 0);
+    CHECK_EQ(pot_spi.begin(), 0);
+    CHECK_EQ(pot_d1x.begin(), 0);
+    CHECK_EQ(Wire.n_begins, 1);                     // The shared bus is only started once.
+
+    // A single wiper write is one transaction: address, command and data.
+    Wire.reset_stats();
+    pot_i2c.set_code(200, 1);
+    report_i2c("MCP4661 set_code");
+    CHECK_EQ(chip_i2c.wiper[1], 200);
+    CHECK_EQ(Wire.stats.transactions, 1);
+    CHECK_EQ(Wire.stats.bytes, 3);
+
+    // Writing the cached value again doesn't touch the bus.
+    Wire.reset_stats();
+    pot_i2c.set_code(200, 1);
+    report_i2c("MCP4661 set_code (unchanged)");
+    CHECK_EQ(Wire.stats.transactions, 0);
+
+    // Both wipers go out in one transaction.
+    uint16_t codes[2] = {10, 20};
+    Wire.reset_stats();
+    pot_i2c.set_codes(codes, 0x03);
+    report_i2c("MCP4661 set_codes (2 wipers)");
+    CHECK_EQ(chip_i2c.wiper[0], 10);
+    CHECK_EQ(chip_i2c.wiper[1], 20);
+    CHECK_EQ(Wire.stats.transactions, 1);
+    CHECK_EQ(Wire.stats.bytes, 5);
+
+    // A small move uses streamed single-byte increments.
+    Wire.reset_stats();
+    pot_i2c.move_to(11, 0);
+    report_i2c("MCP4661 move_to (+1 step)");
+    CHECK_EQ(chip_i2c.wiper[0], 11);
+    CHECK_EQ(Wire.stats.bytes, 2);
+
+    // Reads come from the cache unless a hardware read is asked for.
+    Wire.reset_stats();
+    CHECK_EQ(pot_i2c.get_code(0), 11);
+    CHECK_EQ(Wire.stats.transactions, 0);
+    CHECK_EQ(pot_i2c.get_code(0, true), 11);
+    report_i2c("MCP4661 get_code (hardware)");
+    CHECK_EQ(Wire.stats.transactions, 1);
+
+    // MCP40D1x read: command, repeated START, one data byte, one STOP.
+    Wire.reset_stats();
+    pot_d1x.get_code(0, true);
+    report_i2c("MCP40D18 get_code (hardware)");
+    CHECK_EQ(Wire.stats.starts, 2);
+    CHECK_EQ(Wire.stats.stops, 1);
+
+    // The clock is only reprogrammed when it changes.
+    Wire.reset_stats();
+    for (uint8_t i = 0; i < 20; i++) {
+        pot_i2c.set_code(i, 0);
+        pot_d1x.set_code(i);
+    }
+    report_i2c("40 writes, 2 devices");
+    CHECK_EQ(Wire.stats.transactions, 40);
+    CHECK_EQ(Wire.stats.clock_changes, 0);
+
+    // High-speed mode: one master code per transaction, and a failed master code sends nothing.
+    CHECK_EQ(pot_i2c.set_clock(DIGIPOT_I2C_HS_HZ), DIGIPOT_I2C_HS_HZ);
+    Wire.reset_stats();
+    pot_i2c.set_code(150, 0);
+    report_i2c("MCP4661 set_code (3.4 MHz)");
+    CHECK_EQ(chip_i2c.wiper[0], 150);
+    CHECK_EQ(Wire.stats.transactions, 1);
+    CHECK_EQ(Wire.stats.hs_entries, 1);
+    CHECK_EQ(Wire.stats.stops, 1);
+    Wire.master_code_reply = 4;                     // Simulate a bus error on the master code.
+    Wire.reset_stats();
+    CHECK_EQ(pot_i2c.set_code(151, 0), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot_i2c.status(), DIGIPOT_ERR_BUS);
+    CHECK_EQ(chip_i2c.wiper[0], 150);
+    CHECK_EQ(Wire.stats.bytes, 1);                  // Only the master code went out.
+    Wire.master_code_reply = 2;
+    pot_i2c.set_clock(DIGIPOT_I2C_FAST_HZ);
+
+    // SPI: one 2-byte frame per write, both wipers in one chip select window.
+    SPI.reset_stats();
+    pot_spi.set_code(100, 0);
+    report_spi("MCP4231 set_code");
+    CHECK_EQ(chip_spi.wiper[0], 100);
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(SPI.stats.bytes, 2);
+    SPI.reset_stats();
+    pot_spi.set_codes(codes, 0x03);
+    report_spi("MCP4231 set_codes (2 wipers)");
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(SPI.stats.bytes, 4);
+    CHECK_EQ(SPI.stats.cs_edges, 2);
+
+    // Staged updates: many producers, one flush, only the final values are sent.
+    Vulintus_DigiPotGroup group;
+    group.add(&pot_i2c);
+    group.add(&pot_spi);
+    group.add(&pot_d1x);
+    group.set_staged(true);
+    for (uint8_t i = 0; i < 10; i++) {
+        pot_i2c.set_code(50 + i, 0);
+        pot_i2c.set_code(60 + i, 1);
+        pot_spi.set_code(70 + i, 1);
+        pot_d1x.set_code(80 + i);
+    }
+    Wire.reset_stats();
+    SPI.reset_stats();
+    CHECK_EQ(group.flush(), 0);
+    report_i2c("group flush (40 staged values)");
+    report_spi("group flush (40 staged values)");
+    CHECK_EQ(Wire.stats.transactions, 2);
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(group.n_superseded(), 36);
+    CHECK_EQ(chip_i2c.wiper[1], 69);
+    CHECK_EQ(chip_spi.wiper[1], 79);
+    CHECK_EQ(chip_d1x.wiper, 89);
+
+    return host_test_done("bus");
+}
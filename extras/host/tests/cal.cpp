@@ -0,0 +1,151 @@
+/*!
+	cal.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Calibration table test against known non-linear 256-step ladders (a
+	straight line plus a small sine bow, and a square-law ladder). Every
+	code's table resistance must match the measured ladder to within half a
+	delta unit, and the nearest-code search must find each code again from
+	its own resistance. The square-law ladder strays up to 2.5 kOhm from
+	the straight line, so it needs a "delta_shift", and must still round
+	trip. With a table set on a simulated MCP4251, "set_milliohms" and
+	"get_milliohms" must use the table instead of the linear model.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <math.h>
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define N_CODES     257                 // 256-step ladder.
+#define ZERO_OHMS   75.0                // Wiper resistance.
+#define STEP_OHMS   (10000.0 / 256)     // Nominal step.
+
+
+// Fill a ladder that bows away from the straight line by up to "bow_ohms".
+static void make_bowed(float *ohms, float bow_ohms)
+{
+    for (uint16_t i = 0; i < N_CODES; i++) {
+        ohms[i] = ZERO_OHMS + STEP_OHMS * i + bow_ohms * sin(M_PI * i / 128.0);
+    }
+}
+
+
+// Fill a ladder whose resistance rises with the square of the code.
+static void make_square(float *ohms)
+{
+    for (uint16_t i = 0; i < N_CODES; i++) {
+        ohms[i] = ZERO_OHMS + STEP_OHMS * i * i / 256.0;
+    }
+}
+
+
+// Check every code against the measured ladder, and that each code is found again from its resistance.
+static void check_table(Vulintus_DigiPot_Cal *cal, const float *ohms)
+{
+    int32_t tolerance = (1L << cal->delta_shift) / 2 + 1;     // Half a delta unit, plus the line's rounding.
+    bool close = true;
+    bool round_trip = true;
+    bool monotonic = true;
+    for (uint16_t i = 0; i < N_CODES; i++) {
+        int32_t err = (int32_t) cal->resistance_mohm(i) - (int32_t) (ohms[i] * 1000.0 + 0.5);
+        if ((err > tolerance) || (err < -tolerance)) {
+            close = false;
+        }
+        if (cal->nearest_code(cal->resistance_mohm(i)) != i) {
+            round_trip = false;
+        }
+        if ((i > 0) && (cal->resistance_mohm(i) <= cal->resistance_mohm(i - 1))) {
+            monotonic = false;
+        }
+    }
+    CHECK(close);
+    CHECK(round_trip);
+    CHECK(monotonic);
+}
+
+
+int main(void)
+{
+    static float ohms[N_CODES];
+    static int16_t deltas[N_CODES];
+    Vulintus_DigiPot_Cal cal;
+
+    // A table that was never loaded.
+    CHECK_EQ(cal.resistance_mohm(10), DIGIPOT_MOHM_INVALID);
+    CHECK_EQ(cal.nearest_code(1000000), 0);
+
+    // A small bow fits in milliohm deltas.
+    make_bowed(ohms, 20.0);
+    CHECK(cal.build(ohms, N_CODES, deltas));
+    CHECK_EQ(cal.n_codes, N_CODES);
+    CHECK_EQ(cal.zero_mohm, 75000);
+    CHECK_EQ(cal.delta_shift, 0);
+    check_table(&cal, ohms);
+
+    // Targets between two codes go to the closer one, and targets off the ends clip.
+    uint32_t r_100 = cal.resistance_mohm(100);
+    uint32_t r_101 = cal.resistance_mohm(101);
+    CHECK_EQ(cal.nearest_code(r_100 + (r_101 - r_100) / 3), 100);
+    CHECK_EQ(cal.nearest_code(r_101 - (r_101 - r_100) / 3), 101);
+    CHECK_EQ(cal.nearest_code(0), 0);
+    CHECK_EQ(cal.nearest_code(100000000), 256);
+    CHECK_EQ(cal.resistance_mohm(1000), cal.resistance_mohm(256));
+
+    // Large deviations need coarser deltas (2.5 kOhm is 2,500,000 milliohms, so units of 128).
+    make_square(ohms);
+    CHECK(cal.build(ohms, N_CODES, deltas));
+    CHECK_EQ(cal.delta_shift, 7);
+    check_table(&cal, ohms);
+
+    // The same table from flash.
+    Vulintus_DigiPot_Cal cal_flash;
+    CHECK(cal_flash.begin(deltas, N_CODES, cal.zero_mohm, cal.step_mohm, cal.delta_shift, DIGIPOT_CAL_PROGMEM));
+    CHECK_EQ(cal_flash.resistance_mohm(77), cal.resistance_mohm(77));
+
+    // A ladder that falls with code is rejected.
+    float falling[2] = {10000.0, 75.0};
+    int16_t falling_deltas[2];
+    Vulintus_DigiPot_Cal cal_falling;
+    CHECK(!cal_falling.build(falling, 2, falling_deltas));
+    CHECK_EQ(cal_falling.resistance_mohm(0), DIGIPOT_MOHM_INVALID);
+
+    // Milliohm writes and reads use the table.
+    Sim_MCP4xxx chip(256, 2);                       // MCP4251 (8-bit, dual, SPI).
+    chip.pin_cs = 9;
+    SPI.attach(&chip);
+    Vulintus_MCP4251 pot(9);
+    CHECK_EQ(pot.begin(), 0);
+    uint32_t r_64 = cal.resistance_mohm(64);        // 700 ohms, far below the straight line.
+    pot.set_milliohms(r_64);                        // The linear model picks a much lower code.
+    CHECK(chip.wiper[0] < 30);
+    pot.set_calibration(&cal);
+    CHECK_EQ(pot.set_milliohms(r_64 + 500), r_64);  // Returns the table's resistance for the code written.
+    CHECK_EQ(chip.wiper[0], 64);
+    CHECK_EQ(pot.get_milliohms(0), r_64);
+    CHECK_EQ(pot.get_milliohms(0, true), r_64);
+    CHECK_EQ(pot.set_code(200, 0), 200);
+    CHECK_EQ(pot.get_milliohms(0), cal.resistance_mohm(200));
+    bool writes_match = true;
+    for (uint16_t i = 0; i < N_CODES; i += 5) {     // Every written code reads back at the table's resistance.
+        if ((pot.set_milliohms(cal.resistance_mohm(i), 1) != cal.resistance_mohm(i)) || (chip.wiper[1] != i)) {
+            writes_match = false;
+        }
+    }
+    CHECK(writes_match);
+
+    // Without the table, the linear model is back.
+    pot.set_calibration(NULL);
+    CHECK(pot.set_milliohms(r_64) != r_64);
+    CHECK(chip.wiper[0] < 30);
+
+    return host_test_done("cal");
+}
@@ -0,0 +1,148 @@
+/*!
+	composite.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Composite (two-wiper) potentiometer test against simulated MCP4251s
+	(SPI, dual, 256 steps). Series and parallel composites use both wipers
+	of one chip, and a coarse/fine composite uses a 100 kOhm chip with a
+	5 kOhm chip as the fine part. Every table must be strictly increasing
+	(sorted, with no duplicate resistances), and must have more entries than
+	one wiper has codes. Writes must land within half a fine step of the
+	target, reach the chips as the reported wiper pair, and go out in a
+	single transaction when both wipers are on one chip. Parallel targets
+	at or above a coarse wiper's own resistance take the "open" second
+	wiper branch.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define TABLE_SIZE  4096                // Composite table capacity.
+#define N_CODES     257                 // Codes on one 256-step wiper.
+
+
+// Check that a composite's table is strictly increasing (sorted, with no duplicates).
+static void check_table(Vulintus_DigiPot_Composite *pot, const DigiPot_composite_entry *table)
+{
+    bool increasing = true;
+    for (uint16_t i = 1; i < pot->table_size(); i++) {
+        if (table[i].mohm <= table[i - 1].mohm) {
+            increasing = false;
+        }
+    }
+    CHECK(increasing);
+    CHECK(pot->table_size() > N_CODES);             // More composite steps than one wiper has.
+    CHECK_EQ(pot->n_resistors, pot->table_size() - 1);
+}
+
+
+// Largest gap between neighboring table entries, in milliohms.
+static uint32_t max_gap(Vulintus_DigiPot_Composite *pot, const DigiPot_composite_entry *table)
+{
+    uint32_t gap = 0;
+    for (uint16_t i = 1; i < pot->table_size(); i++) {
+        if (table[i].mohm - table[i - 1].mohm > gap) {
+            gap = table[i].mohm - table[i - 1].mohm;
+        }
+    }
+    return gap;
+}
+
+
+int main(void)
+{
+    static DigiPot_composite_entry table[TABLE_SIZE];
+    Sim_MCP4xxx chip(256, 2);
+    Sim_MCP4xxx chip_coarse(256, 2);
+    Sim_MCP4xxx chip_fine(256, 2);
+    chip.pin_cs = 9;
+    chip_coarse.pin_cs = 10;
+    chip_fine.pin_cs = 11;
+    SPI.attach(&chip);
+    SPI.attach(&chip_coarse);
+    SPI.attach(&chip_fine);
+
+    Vulintus_MCP4251 pot(9);
+    Vulintus_MCP4251 pot_coarse(10);
+    Vulintus_MCP4251 pot_fine(11);
+    CHECK(pot_coarse.set_nominal_resistance(DIGIPOT_RAB_100K));
+    CHECK(pot_fine.set_nominal_resistance(DIGIPOT_RAB_5K));
+
+    // Series, both wipers on one chip. Equal ladders only reach the 513 sums of their codes.
+    Vulintus_DigiPot_Composite series(&pot, 0, &pot, 1, DIGIPOT_COMPOSITE_SERIES, table, TABLE_SIZE);
+    CHECK_EQ(series.begin(), 0);
+    check_table(&series, table);
+    CHECK(series.table_size() <= 2 * N_CODES - 1);
+    CHECK_EQ(series.get_milliohms(), 10150000);     // Both wipers start at mid-scale.
+    SPI.reset_stats();
+    uint32_t mohm = series.set_milliohms(12345000);
+    CHECK_EQ(SPI.stats.transactions, 1);            // One frame for both wipers.
+    CHECK(mohm + 20000 > 12345000 && mohm < 12345000 + 20000);
+    CHECK_EQ(mohm, (uint32_t) (series.pair_resistance(chip.wiper[0], chip.wiper[1]) * 1000.0 + 0.5));
+    CHECK_EQ(series.get_milliohms(0, true), mohm);
+    SPI.reset_stats();
+    CHECK(series.set_code(series.n_resistors) != DIGIPOT_CODE_INVALID);    // The top table entry.
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(chip.wiper[0], 256);
+    CHECK_EQ(chip.wiper[1], 256);
+
+    // Parallel, both wipers on one chip.
+    Vulintus_DigiPot_Composite parallel(&pot, 0, &pot, 1, DIGIPOT_COMPOSITE_PARALLEL, table, TABLE_SIZE);
+    CHECK_EQ(parallel.begin(), 0);
+    check_table(&parallel, table);
+    CHECK_EQ(parallel.get_milliohms(), table[parallel.table_size() - 1].mohm);  // Still at the top from above.
+    SPI.reset_stats();
+    mohm = parallel.set_milliohms(2000000);
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK(mohm + 5000 > 2000000 && mohm < 2000000 + 5000);
+    CHECK_EQ(mohm, (uint32_t) (parallel.pair_resistance(chip.wiper[0], chip.wiper[1]) * 1000.0 + 0.5));
+
+    // A parallel target the first wiper alone can't get under needs the second wiper open (full scale).
+    mohm = parallel.set_milliohms(100000000);
+    CHECK_EQ(mohm, table[parallel.table_size() - 1].mohm);
+    CHECK_EQ(chip.wiper[0], 256);
+    CHECK_EQ(chip.wiper[1], 256);
+    mohm = parallel.set_milliohms(0);               // And the bottom, both at zero.
+    CHECK_EQ(mohm, table[0].mohm);
+    CHECK_EQ(chip.wiper[0], 0);
+    CHECK_EQ(chip.wiper[1], 0);
+
+    // Coarse/fine, on two chips: 390 ohm coarse steps, 19.5 ohm fine steps.
+    Vulintus_DigiPot_Composite coarse_fine(&pot_coarse, 0, &pot_fine, 0, DIGIPOT_COMPOSITE_COARSE_FINE, table, TABLE_SIZE);
+    CHECK_EQ(coarse_fine.begin(), 0);
+    check_table(&coarse_fine, table);
+    CHECK(coarse_fine.table_size() > 3000);
+    CHECK(max_gap(&coarse_fine, table) < 390625 / 2);   // Much finer than the coarse part alone.
+    bool within_fine = true;                        // Every target lands within half a fine step.
+    bool pair_matches = true;
+    for (uint32_t target = 200000; target < 100000000; target += 333333) {
+        mohm = coarse_fine.set_milliohms(target);
+        uint32_t err = (mohm > target) ? (mohm - target) : (target - mohm);
+        if (err > 19531 / 2 + 1) {
+            within_fine = false;
+        }
+        float r = coarse_fine.pair_resistance(chip_coarse.wiper[0], chip_fine.wiper[0]);
+        if (mohm != (uint32_t) (r * 1000.0 + 0.5)) {
+            pair_matches = false;
+        }
+    }
+    CHECK(within_fine);
+    CHECK(pair_matches);
+    SPI.reset_stats();
+    coarse_fine.set_milliohms(50000000);
+    CHECK_EQ(SPI.stats.transactions, 2);            // One write per chip.
+
+    // Ratio writes span the table.
+    CHECK_EQ(coarse_fine.set_ratio_q16(0), 0);
+    CHECK(coarse_fine.set_ratio_q16(0xFFFF) > 0xFFF0);
+
+    return host_test_done("composite");
+}
@@ -0,0 +1,165 @@
+/*!
+	faults.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Fault handling test against a simulated MCP4251 (SPI, dual). A write,
+	frame, read or increment whose SPI transfer fails (as a failed spidev
+	system call does on Linux) must return DIGIPOT_ERR_BUS and leave the
+	wiper cache unknown, so the next write of the same value still reaches
+	the chip. A command the chip rejects (CMDERR) fails the same way. In a
+	frame, the chip ignores everything after a rejected command until chip
+	select rises, so those wipers are marked unknown too. A failed staged
+	"flush" keeps its targets for the next one, and turning staged mode
+	off stays staged when its flush fails.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+		2026-10-17 - Drew Sloan - Added the CMDERR checks.
+		2026-10-17 - Drew Sloan - Added the failed flush checks.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// CLASSES ***********************************************************************************************************//
+class Rejecting_MCP4xxx : public Sim_MCP4xxx
+{
+    public:
+
+        Rejecting_MCP4xxx(void) : Sim_MCP4xxx(256, 2), reject(false) { }
+
+        bool reject;                    // Reject every command with CMDERR (SDO held low).
+
+        uint8_t spi_transfer(uint8_t data)
+        {
+            if (reject) {               // The command is ignored.
+                n_cmd_errors++;
+                return 0x00;
+            }
+            return Sim_MCP4xxx::spi_transfer(data);
+        }
+
+};
+
+
+int main(void)
+{
+    Rejecting_MCP4xxx chip;                         // MCP4251 (8-bit, dual, SPI).
+    chip.pin_cs = 9;
+    SPI.attach(&chip);
+
+    Vulintus_MCP4251 pot(9);
+    CHECK_EQ(pot.begin(), 0);
+    CHECK_EQ(pot.set_code(50, 0), 50);
+
+    // A failed write is reported, and the same value is sent again afterwards.
+    SPI.fail = true;
+    CHECK_EQ(pot.set_code(100, 0), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_BUS);
+    CHECK_EQ(chip.wiper[0], 50);
+    SPI.fail = false;
+    SPI.reset_stats();
+    CHECK_EQ(pot.set_code(100, 0), 100);            // Not skipped as "unchanged".
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(chip.wiper[0], 100);
+
+    // A failed frame (both wipers) clears both cached values.
+    uint16_t codes[2] = {10, 20};
+    SPI.fail = true;
+    CHECK_EQ(pot.set_codes(codes, 0x03), DIGIPOT_ERR_BUS);
+    SPI.fail = false;
+    CHECK_EQ(chip.wiper[0], 100);
+    SPI.reset_stats();
+    CHECK_EQ(pot.set_codes(codes, 0x03), 0);
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(chip.wiper[0], 10);
+    CHECK_EQ(chip.wiper[1], 20);
+
+    // A failed read returns the error value instead of the idle bus.
+    SPI.fail = true;
+    CHECK_EQ(pot.get_code(1, true), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_BUS);
+
+    // A failed increment leaves the wiper unknown instead of stepping the cache.
+    pot.increment(1);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_BUS);
+    SPI.fail = false;
+    CHECK_EQ(chip.wiper[1], 20);
+    SPI.reset_stats();
+    CHECK_EQ(pot.get_code(1), 20);                  // Read from the chip, not the cache.
+    CHECK_EQ(SPI.stats.transactions, 1);
+
+    // A rejected write is reported, and the same value is sent again afterwards.
+    chip.reject = true;
+    CHECK_EQ(pot.set_code(60, 1), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_BUS);
+    chip.reject = false;
+    CHECK_EQ(chip.wiper[1], 20);
+    CHECK_EQ(pot.set_code(60, 1), 60);
+    CHECK_EQ(chip.wiper[1], 60);
+
+    // A rejected increment leaves the wiper unknown.
+    chip.reject = true;
+    pot.increment(1);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_BUS);
+    chip.reject = false;
+    SPI.reset_stats();
+    CHECK_EQ(pot.get_code(1), 60);
+    CHECK_EQ(SPI.stats.transactions, 1);
+
+    // In a frame, commands before the rejected one are cached, and the
+    // wipers it and the later commands address are not. (The MCP4251 has
+    // no EEPROM, so the nonvolatile wiper write is rejected.)
+    CHECK_EQ(pot.get_code(0), 10);
+    Vulintus_MCP4xxx_Frame frame;
+    frame.write(MCP4XXX_REG_WIPER0, 30);
+    frame.write(MCP4XXX_REG_NV_WIPER0, 30);
+    frame.write(MCP4XXX_REG_WIPER1, 40);
+    CHECK_EQ(pot.send_frame(frame), DIGIPOT_ERR_BUS);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_BUS);
+    CHECK(!frame.cmd_error(0));
+    CHECK(frame.cmd_error(1));
+    CHECK_EQ(chip.wiper[0], 30);
+    CHECK_EQ(chip.wiper[1], 60);                    // Ignored after the error.
+    SPI.reset_stats();
+    CHECK_EQ(pot.get_code(0), 30);                  // Cached.
+    CHECK_EQ(SPI.stats.transactions, 0);
+    CHECK_EQ(pot.get_code(1), 60);                  // Read from the chip.
+    CHECK_EQ(SPI.stats.transactions, 1);
+
+    // A failed flush keeps the staged targets, so the next flush sends them.
+    pot.set_staged(true);
+    pot.set_code(70, 0);
+    pot.set_code(80, 1);
+    SPI.fail = true;
+    CHECK_EQ(pot.flush(), DIGIPOT_ERR_BUS);
+    SPI.fail = false;
+    CHECK_EQ(chip.wiper[0], 30);
+    SPI.reset_stats();
+    CHECK_EQ(pot.flush(), 0);
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(chip.wiper[0], 70);
+    CHECK_EQ(chip.wiper[1], 80);
+    SPI.reset_stats();
+    CHECK_EQ(pot.flush(), 0);                       // Nothing left to send.
+    CHECK_EQ(SPI.stats.transactions, 0);
+
+    // Turning staged mode off reports a failed flush and stays staged.
+    pot.set_code(90, 0);
+    SPI.fail = true;
+    CHECK_EQ(pot.set_staged(false), DIGIPOT_ERR_BUS);
+    SPI.fail = false;
+    CHECK_EQ(chip.wiper[0], 70);
+    pot.set_code(95, 0);                            // Still staged.
+    CHECK_EQ(chip.wiper[0], 70);
+    CHECK_EQ(pot.set_staged(false), 0);
+    CHECK_EQ(chip.wiper[0], 95);
+    CHECK_EQ(pot.set_code(100, 0), 100);            // Straight to the bus.
+    CHECK_EQ(chip.wiper[0], 100);
+
+    return host_test_done("faults");
+}
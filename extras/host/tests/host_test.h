@@ -0,0 +1,52 @@
+/*!
+	host_test.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Check macros for the host test programs in this folder. A failed check
+	prints its file, line and expression (and both values, for "CHECK_EQ")
+	and the program keeps going, so one run reports every failure.
+	"host_test_done" prints the summary and returns the exit status.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Host tests first created.
+*/
+
+
+#ifndef VULINTUS_HOST_TEST_H
+#define VULINTUS_HOST_TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+static uint32_t host_test_checks = 0;       // Checks run.
+static uint32_t host_test_failures = 0;     // Checks failed.
+
+#define CHECK(expr) do { \
+        host_test_checks++; \
+        if (!(expr)) { \
+            host_test_failures++; \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #expr); \
+        } \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+        long long _actual = (long long) (actual), _expected = (long long) (expected); \
+        host_test_checks++; \
+        if (_actual != _expected) { \
+            host_test_failures++; \
+            printf("%s:%d: CHECK_EQ failed: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, _actual, _expected); \
+        } \
+    } while (0)
+
+
+// FUNCTIONS *********************************************************************************************************//
+static inline int host_test_done(const char *name)     // Print the summary and return the exit status.
+{
+    printf("%s: %u checks, %u failed\n", name, (unsigned) host_test_checks, (unsigned) host_test_failures);
+    return (host_test_failures > 0) ? 1 : 0;
+}
+
+#endif      // #ifndef VULINTUS_HOST_TEST_H
@@ -0,0 +1,125 @@
+/*!
+	manager.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Startup manager test against simulated I2C parts. A scan must tell an
+	MCP4xxx from an MCP40D1x at their shared address (0x2E), find the dual
+	parts, and read the step count from a wiper past 7-bit full scale. With
+	"probe_steps" set, the step count of parts with low wipers is found by
+	a write probe, and each wiper must be restored afterwards. Drivers
+	started by "begin" are matched to what was found, and once "begin" is
+	done, probes must reach the bus again instead of the scan results.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+int main(void)
+{
+    Sim_MCP4xxx chip_dual(256, 2);                  // MCP4661 (8-bit, dual), wipers at mid-scale (0x80).
+    Sim_MCP4xxx chip_7bit(128, 1);                  // MCP4531 (7-bit, single).
+    Sim_MCP4xxx chip_8bit(256, 1);                  // MCP4551 (8-bit, single).
+    Sim_MCP4xxx chip_late(128, 1);                  // Attached away from every scanned address.
+    Sim_MCP40D1x chip_ae(MCP40D18_AE_I2C_ADDR);     // MCP40D18-xxxAE.
+    Sim_AD5273 chip_ad(AD5273I2C_ADDR_L);           // AD5273.
+    chip_dual.i2c_addr = MCP4XXX_I2C_ADDR_HHL;      // 0x2E, shared with the MCP40D1x.
+    chip_7bit.i2c_addr = MCP4XXX_I2C_ADDR_LLL;
+    chip_7bit.wiper[0] = 0x20;
+    chip_8bit.i2c_addr = MCP4XXX_I2C_ADDR_LLH;
+    chip_8bit.wiper[0] = 0x10;
+    chip_late.i2c_addr = 0x7F;
+    Wire.attach(&chip_dual);
+    Wire.attach(&chip_7bit);
+    Wire.attach(&chip_8bit);
+    Wire.attach(&chip_late);
+    Wire.attach(&chip_ae);
+    Wire.attach(&chip_ad);
+
+    // An MCP40D1x alone at 0x2E, on a second bus.
+    TwoWire wire_d1x;
+    Sim_MCP40D1x chip_d1x(MCP40D1x_E_I2C_ADDR);
+    wire_d1x.attach(&chip_d1x);
+
+    Vulintus_MCP4661 pot_dual(MCP4XXX_I2C_ADDR_HHL);
+    Vulintus_MCP4531 pot_7bit(MCP4XXX_I2C_ADDR_LLL);
+    Vulintus_MCP4531 pot_late(MCP4XXX_I2C_ADDR_LHL);   // Nothing answers here during the scan.
+    Vulintus_MCP40D18 pot_d1x(MCP40D1x_E_I2C_ADDR, &wire_d1x);
+
+    // Without "probe_steps", low wipers leave the step count unknown and nothing is written.
+    Vulintus_DigiPot_Manager quick;
+    CHECK_EQ(quick.scan(&Wire), 5);
+    const DigiPot_found *dev = quick.find(&Wire, MCP4XXX_I2C_ADDR_LLL);
+    CHECK(dev != NULL);
+    CHECK_EQ(dev->family, DIGIPOT_FAMILY_MCP4XXX);
+    CHECK_EQ(dev->n_resistors, 0);
+    CHECK_EQ(chip_7bit.n_cmds, 1);                  // Just the wiper 0 read.
+
+    // The same buses, scanned again with "probe_steps".
+    Vulintus_DigiPot_Manager manager;
+    CHECK_EQ(manager.add(&pot_dual), 0);
+    CHECK_EQ(manager.add(&pot_7bit), 1);
+    CHECK_EQ(manager.add(&pot_late), 2);
+    CHECK_EQ(manager.add(&pot_d1x), 3);
+    CHECK_EQ(manager.scan(&Wire, true), 5);
+    CHECK_EQ(manager.scan(&wire_d1x, true), 1);
+    CHECK_EQ(manager.n_found, 6);
+
+    // An MCP4xxx at 0x2E: dual, and 8-bit from its mid-scale wiper.
+    dev = manager.find(&Wire, MCP4XXX_I2C_ADDR_HHL);
+    CHECK(dev != NULL);
+    CHECK_EQ(dev->family, DIGIPOT_FAMILY_MCP4XXX);
+    CHECK_EQ(dev->n_wipers, 2);
+    CHECK_EQ(dev->n_resistors, 256);
+    CHECK_EQ(chip_dual.wiper[0], 0x80);             // No write probe was needed.
+
+    // Low wipers are probed with a full-scale write, then restored.
+    dev = manager.find(&Wire, MCP4XXX_I2C_ADDR_LLL);
+    CHECK(dev != NULL);
+    CHECK_EQ(dev->n_wipers, 1);
+    CHECK_EQ(dev->n_resistors, 128);
+    CHECK_EQ(chip_7bit.wiper[0], 0x20);
+    dev = manager.find(&Wire, MCP4XXX_I2C_ADDR_LLH);
+    CHECK(dev != NULL);
+    CHECK_EQ(dev->n_wipers, 1);
+    CHECK_EQ(dev->n_resistors, 256);
+    CHECK_EQ(chip_8bit.wiper[0], 0x10);
+
+    // Parts identified by address alone.
+    dev = manager.find(&Wire, MCP40D18_AE_I2C_ADDR);
+    CHECK(dev != NULL);
+    CHECK_EQ(dev->family, DIGIPOT_FAMILY_MCP40D1X);
+    dev = manager.find(&Wire, AD5273I2C_ADDR_L);
+    CHECK(dev != NULL);
+    CHECK_EQ(dev->family, DIGIPOT_FAMILY_AD5273);
+    CHECK_EQ(dev->n_resistors, 63);
+
+    // An MCP40D1x at 0x2E NACKs the MCP4xxx read.
+    dev = manager.find(&wire_d1x, MCP40D1x_E_I2C_ADDR);
+    CHECK(dev != NULL);
+    CHECK_EQ(dev->family, DIGIPOT_FAMILY_MCP40D1X);
+    CHECK_EQ(dev->n_resistors, 127);
+    CHECK_EQ(chip_d1x.n_writes, 0);                 // The probe never wrote the wiper.
+
+    // Every driver starts, except the one with nothing at its address.
+    CHECK_EQ(manager.begin(), 1);
+    CHECK_EQ(pot_late.status(), DIGIPOT_ERR_NACK_ADDR);
+    CHECK_EQ(manager.find(&Wire, MCP4XXX_I2C_ADDR_HHL)->member_i, 0);
+    CHECK_EQ(manager.find(&Wire, MCP4XXX_I2C_ADDR_LLL)->member_i, 1);
+    CHECK_EQ(manager.find(&wire_d1x, MCP40D1x_E_I2C_ADDR)->member_i, 3);
+    CHECK_EQ(manager.find(&Wire, AD5273I2C_ADDR_L)->member_i, -1);
+
+    // After "begin", a part that shows up later is found by its own probe.
+    chip_late.i2c_addr = MCP4XXX_I2C_ADDR_LHL;
+    Wire.reset_stats();
+    CHECK_EQ(pot_late.begin(), 0);
+    CHECK(Wire.stats.transactions > 0);
+
+    return host_test_done("manager");
+}
@@ -0,0 +1,193 @@
+/*!
+	nv.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Nonvolatile (EEPROM) wiper write test for "Vulintus_MCP4xxx_NV", against
+	simulated MCP4661 (I2C) and MCP4161 (SPI) EE parts. The simulated write
+	cycle starts at the I2C STOP or the SPI chip select rising edge, as on
+	the chip, so each NV write must go out in its own transaction with
+	STATUS read afterwards. Writes rejected while the EEPROM is busy or the
+	wiper is locked must be caught from the NACK (I2C) or CMDERR (SPI), and
+	wiper indices the chip doesn't have must be rejected. Writes that fail
+	for any reason but WiperLock must stay pending until they succeed, and
+	volatile-only parts must be rejected before anything is sent.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+		2026-10-17 - Drew Sloan - Added out-of-range wiper checks.
+		2026-10-17 - Drew Sloan - Added retry and volatile-only part checks.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define STATUS_EEWA     0x10            // EEPROM write active bit.
+#define STATUS_WL1      0x08            // Wiper 1 WiperLock bit.
+#define STATUS_WL0      0x04            // Wiper 0 WiperLock bit.
+
+
+int main(void)
+{
+    Sim_MCP4xxx chip_i2c(256, 2);                   // MCP4661 (8-bit, dual, I2C, EE).
+    chip_i2c.i2c_addr = MCP4XXX_I2C_ADDR_HLL;
+    chip_i2c.has_eeprom = true;
+    Sim_MCP4xxx chip_spi(256, 1);                   // MCP4161 (8-bit, single, SPI, EE).
+    chip_spi.pin_cs = 9;
+    chip_spi.has_eeprom = true;
+    Wire.attach(&chip_i2c);
+    SPI.attach(&chip_spi);
+
+    Vulintus_MCP4661 pot_i2c(MCP4XXX_I2C_ADDR_HLL);
+    Vulintus_MCP4161 pot_spi(9);
+    CHECK_EQ(pot_i2c.begin(), 0);
+    CHECK_EQ(pot_spi.begin(), 0);
+    Vulintus_MCP4xxx_NV nv_i2c(&pot_i2c);
+    Vulintus_MCP4xxx_NV nv_spi(&pot_spi);
+
+    // A STATUS read in the same transaction as the write can't see the write cycle yet.
+    Vulintus_MCP4xxx_Frame frame;
+    frame.write(MCP4XXX_REG_NV_WIPER1, 50);
+    frame.read(MCP4XXX_REG_STATUS);
+    CHECK_EQ(pot_i2c.send_frame(frame), 0);
+    CHECK(!(frame.reply(1) & STATUS_EEWA));
+    CHECK(nv_i2c.read_status() & STATUS_EEWA);      // The next transaction can.
+    delay(10);
+
+    // Values the EEPROM already holds are skipped.
+    CHECK_EQ(nv_i2c.read(), 128);
+    CHECK_EQ(nv_i2c.write(128), DIGIPOT_OK);
+    CHECK_EQ(nv_i2c.n_skipped, 1);
+
+    // Each write is its own transaction, and STATUS is polled afterwards.
+    Wire.reset_stats();
+    CHECK_EQ(nv_i2c.write(10), DIGIPOT_PENDING);
+    CHECK_EQ(Wire.stats.transactions, 1);
+    CHECK_EQ(Wire.stats.bytes, 3);                  // Address, command and data only.
+    CHECK_EQ(chip_i2c.n_nv_writes, 2);
+    CHECK_EQ(chip_i2c.nv_wiper[0], 10);
+    CHECK_EQ(nv_i2c.read(), DIGIPOT_CODE_INVALID);  // The stored value is about to change.
+    CHECK_EQ(nv_i2c.status(), DIGIPOT_PENDING);
+
+    // Requests during the write cycle coalesce into a single write.
+    for (uint8_t i = 0; i < 5; i++) {
+        CHECK_EQ(nv_i2c.write(20 + i), DIGIPOT_PENDING);
+    }
+    CHECK_EQ(nv_i2c.n_coalesced, 4);
+    CHECK_EQ(chip_i2c.n_nv_writes, 2);
+    uint16_t n_polls = 0;
+    while (nv_i2c.poll() == DIGIPOT_PENDING) {
+        delayMicroseconds(100);
+        n_polls++;
+    }
+    CHECK_EQ(chip_i2c.n_nv_writes, 3);
+    CHECK_EQ(nv_i2c.read(), 24);
+    CHECK(n_polls > 40);                            // The write waited out the simulated 5 ms cycle.
+
+    // The coalescing window holds back a burst of requests.
+    nv_i2c.set_window(100);
+    for (uint8_t i = 0; i < 50; i++) {
+        nv_i2c.write(i);
+        delay(1);
+        nv_i2c.poll();
+    }
+    CHECK_EQ(nv_i2c.flush(), DIGIPOT_OK);
+    CHECK_EQ(chip_i2c.nv_wiper[0], 49);
+    CHECK_EQ(chip_i2c.n_nv_writes, 4);
+    nv_i2c.set_window(0);
+
+    // I2C: a locked wiper NACKs the write.
+    chip_i2c.status |= STATUS_WL1;
+    CHECK(nv_i2c.wiper_locked(1));
+    CHECK(!nv_i2c.wiper_locked(0));
+    CHECK_EQ(nv_i2c.write(77, 1), DIGIPOT_ERR_NACK_DATA);
+    CHECK_EQ(nv_i2c.n_failed, 1);
+    CHECK_EQ(chip_i2c.nv_wiper[1], 50);
+    CHECK(!nv_i2c.busy());                          // A locked write is dropped.
+    chip_i2c.status &= ~STATUS_WL1;
+    CHECK_EQ(nv_i2c.write(77, 1), DIGIPOT_PENDING);
+    CHECK_EQ(nv_i2c.flush(), DIGIPOT_OK);
+    CHECK_EQ(chip_i2c.nv_wiper[1], 77);
+
+    // I2C: a write cycle started elsewhere makes the chip NACK the write.
+    chip_i2c.eewa_until_us = micros() + 5000;
+    CHECK_EQ(nv_i2c.write(90), DIGIPOT_ERR_NACK_DATA);
+    CHECK_EQ(nv_i2c.n_failed, 2);
+    CHECK(nv_i2c.busy());                           // The request stays pending...
+    delay(10);
+    CHECK_EQ(nv_i2c.flush(), DIGIPOT_OK);           // ...and goes out once the chip is idle.
+    CHECK_EQ(chip_i2c.nv_wiper[0], 90);
+    CHECK_EQ(nv_i2c.n_failed, 2);
+
+    // The volatile wiper is unaffected.
+    CHECK_EQ(pot_i2c.set_code(5), 5);
+    CHECK_EQ(chip_i2c.wiper[0], 5);
+
+    // SPI: a locked wiper flags CMDERR.
+    chip_spi.status |= STATUS_WL0;
+    CHECK_EQ(nv_spi.write(3), DIGIPOT_ERR_BUS);
+    CHECK_EQ(nv_spi.n_failed, 1);
+    CHECK_EQ(chip_spi.n_nv_writes, 0);
+    chip_spi.status &= ~STATUS_WL0;
+
+    // SPI: the write cycle starts when chip select rises.
+    SPI.reset_stats();
+    CHECK_EQ(nv_spi.write(3), DIGIPOT_PENDING);
+    CHECK_EQ(SPI.stats.transactions, 1);
+    CHECK_EQ(SPI.stats.bytes, 2);
+    CHECK(nv_spi.read_status() & STATUS_EEWA);
+
+    // SPI: a write while the cycle is running flags CMDERR.
+    Vulintus_MCP4xxx_NV nv_other(&pot_spi);         // A second helper doesn't know about the first one's write.
+    CHECK_EQ(nv_other.write(4), DIGIPOT_ERR_BUS);
+    CHECK_EQ(chip_spi.nv_wiper[0], 3);
+    CHECK_EQ(nv_spi.flush(), DIGIPOT_OK);
+    CHECK_EQ(nv_spi.read(), 3);
+
+    // Wipers the chip doesn't have are rejected, not folded onto another wiper.
+    SPI.reset_stats();
+    CHECK_EQ(nv_spi.write(40, 1), DIGIPOT_ERR_WIPER);     // The MCP4161 has a single wiper.
+    CHECK_EQ(nv_spi.read(1), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(nv_spi.status(), DIGIPOT_ERR_WIPER);
+    CHECK(!nv_spi.busy());
+    CHECK_EQ(SPI.stats.transactions, 0);
+    CHECK_EQ(chip_spi.nv_wiper[0], 3);
+    CHECK_EQ(nv_i2c.write(40, 2), DIGIPOT_ERR_WIPER);     // The MCP4661 has two.
+    CHECK_EQ(nv_i2c.read(2), DIGIPOT_CODE_INVALID);
+
+    // SPI: a write lost to a bus error stays pending.
+    SPI.fail = true;
+    CHECK_EQ(nv_spi.write(7), DIGIPOT_ERR_BUS);
+    CHECK(nv_spi.busy());
+    CHECK_EQ(nv_spi.poll(), DIGIPOT_ERR_BUS);       // Still failing.
+    SPI.fail = false;
+    CHECK_EQ(nv_spi.flush(), DIGIPOT_OK);
+    CHECK_EQ(chip_spi.nv_wiper[0], 7);
+    CHECK_EQ(nv_spi.n_failed, 3);
+
+    // Volatile-only parts are rejected without any bus traffic.
+    Sim_MCP4xxx chip_ram(256, 1);                   // MCP4151 (8-bit, single, SPI, RAM).
+    chip_ram.pin_cs = 10;
+    SPI.attach(&chip_ram);
+    Vulintus_MCP4151 pot_ram(10);
+    CHECK_EQ(pot_ram.begin(), 0);
+    Vulintus_MCP4xxx_NV nv_ram(&pot_ram);
+    SPI.reset_stats();
+    CHECK_EQ(nv_ram.write(5), DIGIPOT_ERR_UNSUPPORTED);
+    CHECK_EQ(nv_ram.read(), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(nv_ram.status(), DIGIPOT_ERR_UNSUPPORTED);
+    CHECK(!nv_ram.busy());
+    CHECK_EQ(SPI.stats.transactions, 0);
+
+    // A generic driver doesn't know its part, so it's left to the chip.
+    Vulintus_MCP4xxx_DigiPot pot_generic(256, 9, &SPI);
+    CHECK_EQ(pot_generic.begin(), 0);
+    Vulintus_MCP4xxx_NV nv_generic(&pot_generic);
+    CHECK_EQ(nv_generic.read(), 7);
+
+    return host_test_done("nv");
+}
@@ -0,0 +1,148 @@
+/*!
+	ramp.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Non-blocking ramp test against an in-memory 16-bit (65535-step) device.
+	Linear, exponential and S-curve ramps must start and end exactly on
+	their endpoints, move monotonically, and hit the curve's knots at each
+	segment boundary, across the full 16-bit range (codes above 32767) and
+	with segments long enough to need the interpolation shift. A ramp that
+	starts just before the "micros" rollover must run to its normal end.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include <Vulintus_DigiPot_Ramp.h>
+#include "host_test.h"
+
+
+// CLASSES ***********************************************************************************************************//
+class Memory_DigiPot : public Vulintus_DigiPot
+{
+    public:
+
+        Memory_DigiPot(void) : wiper(0), n_writes(0)
+        {
+            n_resistors = 0xFFFF;       // 16-bit ladder.
+            n_wipers = 1;
+        }
+
+        uint16_t wiper;                 // Current wiper value.
+        uint32_t n_writes;              // Wiper writes received.
+
+        uint8_t begin(void) { return 0; }
+
+    protected:
+
+        uint8_t bus_write(uint16_t code, uint8_t wiper_i)
+        {
+            (void) wiper_i;
+            wiper = code;
+            n_writes++;
+            return 0;
+        }
+
+        uint16_t bus_read(uint8_t wiper_i)
+        {
+            (void) wiper_i;
+            return wiper;
+        }
+
+};
+
+
+// Run a ramp to the end in fixed ticks, checking the endpoints and direction.
+static void run_ramp(Memory_DigiPot *pot, uint16_t start_code, uint16_t end_code, uint32_t duration_us, \
+        DigiPot_ramp_curve curve, uint32_t t0)
+{
+    Vulintus_DigiPot_Ramp ramp;
+    CHECK(ramp.start(pot, 0, start_code, end_code, duration_us, curve, t0));
+    CHECK_EQ(pot->wiper, start_code);
+    bool rising = (end_code >= start_code);
+    bool monotonic = true;
+    uint16_t last = pot->wiper;
+    uint32_t tick = duration_us / 1000;
+    uint32_t t = t0;
+    uint16_t n_ticks = 0;
+    while (ramp.update(t += tick)) {
+        if (rising ? (pot->wiper < last) : (pot->wiper > last)) {
+            monotonic = false;
+        }
+        last = pot->wiper;
+        n_ticks++;
+    }
+    CHECK(monotonic);
+    CHECK(n_ticks >= 990);                          // Finished on time, not early.
+    CHECK_EQ(pot->wiper, end_code);
+    CHECK(!ramp.running());
+}
+
+
+int main(void)
+{
+    Memory_DigiPot pot;
+    Vulintus_DigiPot_Ramp ramp;
+
+    // Linear ramps reach each endpoint and pass the midpoint halfway.
+    CHECK(ramp.start(&pot, 0, 0, 0xFFFF, 1600000, DIGIPOT_RAMP_LINEAR, 0));
+    CHECK_EQ(pot.wiper, 0);
+    ramp.update(800000);
+    CHECK_EQ(pot.wiper, 0x8000);                    // Above 32767.
+    ramp.update(1599999);
+    CHECK(pot.wiper > 0xFFF0);
+    CHECK(!ramp.update(1600000));
+    CHECK_EQ(pot.wiper, 0xFFFF);
+    run_ramp(&pot, 0, 0xFFFF, 1600000, DIGIPOT_RAMP_LINEAR, 0);
+    run_ramp(&pot, 0xFFFF, 0, 1600000, DIGIPOT_RAMP_LINEAR, 0);
+
+    // Exponential and S-curve ramps end exactly on the endpoints, with the
+    // knots at the segment boundaries.
+    CHECK(ramp.start(&pot, 0, 0, 0xFFFF, 1600000, DIGIPOT_RAMP_EXPONENTIAL, 0));
+    ramp.update(100000);
+    CHECK_EQ(pot.wiper, (uint16_t) ((0xFFFFL * 174 + 0x4000) >> 15));
+    ramp.update(1500000);
+    CHECK_EQ(pot.wiper, (uint16_t) ((0xFFFFL * 25385 + 0x4000) >> 15));
+    ramp.update(1600000);
+    CHECK_EQ(pot.wiper, 0xFFFF);
+    CHECK(ramp.start(&pot, 0, 0, 0xFFFF, 1600000, DIGIPOT_RAMP_SCURVE, 0));
+    ramp.update(800000);
+    CHECK_EQ(pot.wiper, 0x8000);
+    run_ramp(&pot, 0, 0xFFFF, 1600000, DIGIPOT_RAMP_EXPONENTIAL, 0);
+    run_ramp(&pot, 0xFFFF, 100, 1600000, DIGIPOT_RAMP_EXPONENTIAL, 0);
+    run_ramp(&pot, 100, 0xFFFF, 1600000, DIGIPOT_RAMP_SCURVE, 0);
+    run_ramp(&pot, 0xFFFF, 0, 1600000, DIGIPOT_RAMP_SCURVE, 0);
+
+    // Long segments with wide spans (the product needs the shift), part way in.
+    CHECK(ramp.start(&pot, 0, 0, 0xFFFF, 16UL * 60000000UL, DIGIPOT_RAMP_LINEAR, 0));
+    ramp.update(16UL * 60000000UL / 4);
+    CHECK_EQ(pot.wiper, 0x4000);
+    ramp.update(4UL * 60000000UL + 30000000UL);     // Halfway through a 4096-step segment.
+    CHECK_EQ(pot.wiper, 0x4800);
+    ramp.update(16UL * 60000000UL / 4 * 3);
+    CHECK_EQ(pot.wiper, (uint16_t) ((0xFFFFL * 24576 + 0x4000) >> 15));
+    ramp.stop();
+    run_ramp(&pot, 0, 0xFFFF, 16UL * 60000000UL, DIGIPOT_RAMP_SCURVE, 0);
+    run_ramp(&pot, 0xFFFF, 0, 0xF0000000UL, DIGIPOT_RAMP_EXPONENTIAL, 0);
+
+    // A ramp across the "micros" rollover runs to its normal end.
+    run_ramp(&pot, 0, 0xFFFF, 1600000, DIGIPOT_RAMP_LINEAR, 0xFFFFFFFFUL - 800000);
+    run_ramp(&pot, 1000, 200, 1600000, DIGIPOT_RAMP_SCURVE, 0xFFFFFFFFUL - 10);
+    CHECK(ramp.start(&pot, 0, 0, 0xFFFF, 1600000, DIGIPOT_RAMP_LINEAR, 0xFFFFFFFFUL - 99999));
+    CHECK(ramp.update(0));                          // 100 ms in, still running.
+    CHECK(pot.wiper > 0 && pot.wiper < 0x1100);
+
+    // Only changed values reach the device.
+    pot.n_writes = 0;
+    CHECK(ramp.start(&pot, 0, 10, 20, 1600000, DIGIPOT_RAMP_LINEAR, 0));
+    for (uint32_t t = 0; t <= 1600000; t += 1000) {
+        ramp.update(t);
+    }
+    CHECK_EQ(pot.wiper, 20);
+    CHECK_EQ(pot.n_writes, 11);
+
+    return host_test_done("ramp");
+}
@@ -0,0 +1,156 @@
+/*!
+	retry.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Retry policy test for MCP4xxx I2C frames, against a simulated MCP4661
+	that NACKs its address a set number of times. Frames of absolute writes
+	and reads go through the bus transport's retry policy. Frames with
+	increments/decrements are never repeated, since a repeated step would
+	move the wiper twice. "worst_case_us" must not claim a bound until the
+	core enforces a deadline. The deadline applies to each blocking Wire
+	call, so the bound counts every wait in a transaction, and every call
+	stays within its bound on a slow (clock-stretching) or stuck bus.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+		2026-10-17 - Drew Sloan - Added the unenforced deadline check.
+		2026-10-17 - Drew Sloan - Added the per-wait bound and stuck bus checks.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// CLASSES ***********************************************************************************************************//
+class Flaky_MCP4xxx : public Sim_MCP4xxx
+{
+    public:
+
+        Flaky_MCP4xxx(void) : Sim_MCP4xxx(256, 2), n_fail(0) { }
+
+        uint8_t n_fail;                 // Number of address phases still to NACK.
+
+        bool i2c_start(bool read)
+        {
+            if (n_fail > 0) {           // NACK the address.
+                n_fail--;
+                return false;
+            }
+            return Sim_MCP4xxx::i2c_start(read);
+        }
+
+};
+
+
+int main(void)
+{
+    Flaky_MCP4xxx chip;
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_HLL;
+    Wire.attach(&chip);
+    Vulintus_MCP4661 pot(MCP4XXX_I2C_ADDR_HLL);
+    CHECK_EQ(pot.begin(), 0);
+    Vulintus_DigiPot_Bus *bus = Vulintus_DigiPot_Bus::get(&Wire);
+    uint16_t codes[2] = {10, 20};
+
+    // Without a retry policy, one NACK fails the frame.
+    chip.n_fail = 1;
+    pot.set_codes(codes, 0x03);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_NACK_ADDR);
+
+    // With retries, a frame of writes recovers.
+    DigiPot_retry_policy policy = {3, 100, 0};
+    bus->set_retry(policy);
+    chip.n_fail = 2;
+    Wire.reset_stats();
+    CHECK_EQ(pot.set_codes(codes, 0x03), 0);
+    CHECK_EQ(chip.wiper[0], 10);
+    CHECK_EQ(chip.wiper[1], 20);
+    CHECK_EQ(Wire.stats.transactions, 3);           // Two failed attempts and the one that went through.
+
+    // Frames with reads are retried too.
+    chip.n_fail = 1;
+    CHECK_EQ(pot.get_code(1, true), 20);
+
+    // A frame of increments is never repeated.
+    chip.n_fail = 1;
+    Wire.reset_stats();
+    pot.move_to(11, 0);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_NACK_ADDR);
+    CHECK_EQ(Wire.stats.transactions, 1);
+    CHECK_EQ(chip.wiper[0], 10);
+    CHECK_EQ(pot.get_code(0, true), 10);           // The cache was cleared, so this reads the chip.
+    CHECK_EQ(pot.move_to(11, 0), 11);
+    CHECK_EQ(chip.wiper[0], 11);
+
+    // The retry budget caps the time spent on a device that doesn't answer.
+    DigiPot_retry_policy budgeted = {5, 200, 500};
+    bus->set_retry(budgeted);
+    chip.n_fail = 255;
+    uint32_t t_start = micros();
+    pot.set_codes(codes, 0x03);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_NACK_ADDR);
+    CHECK(micros() - t_start < 1000);
+
+    // Without a deadline, nothing is bounded.
+    CHECK_EQ(bus->worst_case_us(), 0);
+    CHECK_EQ(pot.worst_case_us(DIGIPOT_CALL_WRITE), 0);
+
+    // Every blocking Wire call can run to the deadline, on every attempt.
+    DigiPot_retry_policy twice = {2, 100, 0};
+    bus->set_retry(twice);
+    bus->set_timeout(1000);
+    chip.n_fail = 0;
+    CHECK_EQ(bus->worst_case_us(1), 3 * 1000 + 100 + 200);
+    CHECK_EQ(bus->worst_case_us(2), 3 * 2000 + 100 + 200);
+    CHECK_EQ(bus->worst_case_us(1, 1000000), 3 * 2000 + 100 + 200);    // The Hs master code is another wait.
+
+    // A slow device stretches each wait to just under the deadline. An
+    // 8-read frame waits 16 times, well past a single deadline.
+    Wire.stall_us = 800;
+    uint8_t tx[8];
+    uint8_t rx[16];
+    DigiPot_i2c_seg segs[8];
+    for (uint8_t i = 0; i < 8; i++) {
+        tx[i] = MCP4XXX_REG_WIPER0 | MCP4XXX_CMD_READ;
+        segs[i].tx = &tx[i];
+        segs[i].n_tx = 1;
+        segs[i].rx = &rx[2 * i];
+        segs[i].n_rx = 2;
+    }
+    CHECK_EQ(Vulintus_DigiPot_Bus::i2c_waits(segs, 8), 16);
+    t_start = micros();
+    CHECK_EQ(bus->i2c_transfer(MCP4XXX_I2C_ADDR_HLL, segs, 8, pot.get_clock()), DIGIPOT_OK);
+    CHECK(micros() - t_start > 16 * 800);
+    CHECK(micros() - t_start <= bus->worst_case_us(16, pot.get_clock()));
+
+    pot.set_verify(DIGIPOT_VERIFY_ON_WRITE);
+    t_start = micros();
+    CHECK_EQ(pot.set_code(30, 0), 30);             // A write, then a read-back (a write and a read).
+    CHECK(micros() - t_start > 3 * 800);
+    CHECK(micros() - t_start <= pot.worst_case_us(DIGIPOT_CALL_WRITE));
+
+    // A stuck bus times out every wait, and every call still stays within its bound.
+    Wire.stall_us = 5000;
+    Wire.reset_stats();
+    t_start = micros();
+    CHECK_EQ(pot.get_code(0, true), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_TIMEOUT);
+    CHECK_EQ(Wire.stats.timeouts, 3);              // One per attempt.
+    CHECK(micros() - t_start <= pot.worst_case_us(DIGIPOT_CALL_READ));
+    t_start = micros();
+    CHECK_EQ(pot.set_code(40, 0), DIGIPOT_CODE_INVALID);
+    CHECK(micros() - t_start <= pot.worst_case_us(DIGIPOT_CALL_WRITE));
+    t_start = micros();
+    CHECK(pot.set_codes(codes, 0x03) != 0);
+    CHECK(micros() - t_start <= pot.worst_case_us(DIGIPOT_CALL_WRITE_ALL));
+    t_start = micros();
+    CHECK(pot.begin() != 0);
+    CHECK(micros() - t_start <= pot.worst_case_us(DIGIPOT_CALL_BEGIN));
+    Wire.stall_us = 0;
+    pot.set_verify(DIGIPOT_VERIFY_NEVER);
+
+    return host_test_done("retry");
+}
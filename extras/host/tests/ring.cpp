@@ -0,0 +1,132 @@
+/*!
+	ring.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Interrupt command ring test: coalescing, barrier and ratio commands,
+	unregistered devices, overflow counting, and a two-thread stress run
+	where one thread pushes as an ISR would while the other drains. Every
+	command pushed in the stress run must be accounted for exactly once:
+	pushed + dropped = attempted, and written + coalesced = pushed.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <thread>
+#include <atomic>
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define STRESS_PUSHES   2000000         // Commands pushed by the producer thread in the stress run.
+
+
+int main(void)
+{
+    Sim_MCP4xxx chip(256, 2);                       // MCP4661 (8-bit, dual, I2C).
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_HLL;
+    Wire.attach(&chip);
+    Vulintus_MCP4661 pot(MCP4XXX_I2C_ADDR_HLL);
+    CHECK_EQ(pot.begin(), 0);
+
+    Vulintus_DigiPot_Ring ring;
+    int8_t pot_i = ring.add(&pot);
+    CHECK_EQ(pot_i, 0);
+    CHECK_EQ(sizeof(DigiPot_ring_cmd), 4);          // Commands stay 4 bytes.
+
+    // Commands for the same wiper coalesce down to the latest value.
+    Wire.reset_stats();
+    for (uint8_t i = 0; i < 10; i++) {
+        CHECK_EQ(ring.push(pot_i, 0, 10 + i), DIGIPOT_PENDING);
+    }
+    ring.push(pot_i, 1, 77);
+    ring.push(pot_i, 0, 200);
+    CHECK_EQ(ring.pending(), 12);
+    CHECK_EQ(ring.drain(), 2);
+    CHECK_EQ(ring.pending(), 0);
+    CHECK_EQ(chip.wiper[0], 200);
+    CHECK_EQ(chip.wiper[1], 77);
+    CHECK_EQ(ring.n_coalesced, 10);
+    CHECK_EQ(ring.n_written, 2);
+    CHECK_EQ(Wire.stats.transactions, 2);
+
+    // A barrier command is always written, even with a later value queued.
+    ring.push(pot_i, 0, 5, DIGIPOT_RING_BARRIER);
+    ring.push(pot_i, 0, 6);
+    ring.push(pot_i, 0, 7);
+    CHECK_EQ(ring.drain(), 2);
+    CHECK_EQ(chip.wiper[0], 7);
+    CHECK_EQ(ring.n_coalesced, 11);
+
+    // Ratio commands are converted to steps by the driver.
+    ring.push(pot_i, 1, 0x8000, DIGIPOT_RING_RATIO);
+    ring.drain();
+    CHECK_EQ(chip.wiper[1], 128);
+
+    // Commands for unregistered devices are counted, not sent.
+    ring.push(5, 0, 1);
+    ring.drain();
+    CHECK_EQ(ring.n_invalid, 1);
+
+    // A full ring drops the command and reports it.
+    CHECK(!ring.overflowed());
+    for (uint8_t i = 0; i < DIGIPOT_RING_LENGTH; i++) {
+        CHECK_EQ(ring.push(pot_i, 0, i), DIGIPOT_PENDING);
+    }
+    CHECK_EQ(ring.push(pot_i, 0, 99), DIGIPOT_ERR_QUEUE_FULL);
+    CHECK_EQ(ring.push(pot_i, 0, 99), DIGIPOT_ERR_QUEUE_FULL);
+    CHECK(ring.overflowed());
+    CHECK_EQ(ring.n_overflows, 2);
+    CHECK(!ring.overflowed());                      // The check resets.
+    ring.drain();
+    CHECK_EQ(chip.wiper[0], DIGIPOT_RING_LENGTH - 1);  // The queued commands still go out.
+
+    // More than 255 drops between checks are all counted.
+    for (uint8_t i = 0; i < DIGIPOT_RING_LENGTH; i++) {
+        ring.push(pot_i, 0, i);
+    }
+    for (uint16_t i = 0; i < 300; i++) {
+        ring.push(pot_i, 0, i);
+    }
+    ring.clear();
+    CHECK_EQ(ring.pending(), 0);
+    CHECK(ring.overflowed());
+    CHECK_EQ(ring.n_overflows, 302);
+
+    // Stress: one thread pushes with a varying gap while this one drains.
+    // No devices are registered, so every write lands in "n_invalid".
+    Vulintus_DigiPot_Ring stress;
+    std::atomic<bool> done(false);
+    uint32_t n_pushed = 0;
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < STRESS_PUSHES; i++) {
+            for (volatile uint32_t spin = 0; spin < (i % 64) * 3; spin++);     // Vary the push rate.
+            if (stress.push(i & 1, (i >> 1) & 1, i) == DIGIPOT_PENDING) {
+                n_pushed++;
+            }
+            else if ((i % 4) == 0) {
+                std::this_thread::yield();          // Let the drain catch up.
+            }
+        }
+        done = true;
+    });
+    while (!done) {
+        stress.drain();
+        std::this_thread::yield();
+    }
+    producer.join();
+    stress.drain();
+    stress.overflowed();
+    printf("stress: %u pushed, %u dropped, %u coalesced, %u written\n", (unsigned) n_pushed, \
+            (unsigned) stress.n_overflows, (unsigned) stress.n_coalesced, (unsigned) stress.n_invalid);
+    CHECK_EQ(n_pushed + stress.n_overflows, STRESS_PUSHES);
+    CHECK_EQ(stress.n_coalesced + stress.n_invalid, n_pushed);
+    CHECK_EQ(stress.pending(), 0);
+
+    return host_test_done("ring");
+}
@@ -0,0 +1,132 @@
+/*!
+	stats.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Performance counter test (build with "make test STATS=1"). A known
+	sequence of calls on a simulated MCP4661 (I2C) must leave the expected
+	transactions, bytes, NACKs, short reads, cache hits and skipped writes
+	in both the device's and the bus's records. A simulated MCP40D18 on the
+	same bus checks that each device is only charged for its own calls,
+	while the bus counts everything. Without DIGIPOT_STATS, only the driver
+	results are checked.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// CLASSES ***********************************************************************************************************//
+class Sim_MCP4xxx_Short : public Sim_MCP4xxx
+{
+    public:
+
+        Sim_MCP4xxx_Short(void) : Sim_MCP4xxx(256, 2), nack_reads(false) { }
+
+        bool nack_reads;                // NACK the address of every read, so reads come back short.
+
+        bool i2c_start(bool read)
+        {
+            if (read && nack_reads) {
+                return false;
+            }
+            return Sim_MCP4xxx::i2c_start(read);
+        }
+
+};
+
+
+int main(void)
+{
+    Sim_MCP4xxx_Short chip;                         // MCP4661 (8-bit, dual, I2C).
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_LLL;
+    Sim_MCP40D1x chip_d1x(0x2E);                    // MCP40D18.
+    Wire.attach(&chip);
+    Wire.attach(&chip_d1x);
+
+    Vulintus_MCP4661 pot(MCP4XXX_I2C_ADDR_LLL);
+    Vulintus_MCP40D18 pot_d1x;
+    CHECK_EQ(pot.begin(), 0);
+    CHECK_EQ(pot_d1x.begin(), 0);
+    #if defined(DIGIPOT_STATS)
+        Vulintus_DigiPot_Bus *bus = Vulintus_DigiPot_Bus::get(&Wire);
+        pot.reset_stats();                          // Start from zero.
+        pot_d1x.reset_stats();
+        bus->reset_stats();
+    #endif
+
+    CHECK_EQ(pot.set_code(200, 0), 200);            // One write: command and data.
+    CHECK_EQ(pot.set_code(200, 0), 200);            // Skipped (the wiper already has the value).
+    CHECK_EQ(pot.get_code(0), 200);                 // Cache hit.
+    CHECK_EQ(pot.get_code(0, true), 200);           // One read: command, then two data bytes.
+    CHECK_EQ(chip.wiper[0], 200);
+    #if defined(DIGIPOT_STATS)
+        const DigiPot_stats *stats = pot.stats();
+        CHECK_EQ(stats->n_transactions, 2);
+        CHECK_EQ(stats->n_bytes, 5);
+        CHECK_EQ(stats->n_skipped_writes, 1);
+        CHECK_EQ(stats->n_cache_hits, 1);
+        CHECK_EQ(stats->n_nacks, 0);
+        CHECK_EQ(stats->n_short_reads, 0);
+        CHECK_EQ(stats->n_errors, 0);
+    #endif
+
+    // A write to a chip that doesn't answer is NACKed.
+    chip.i2c_addr = 0x7F;
+    CHECK_EQ(pot.set_code(10, 0), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_NACK_ADDR);
+    chip.i2c_addr = MCP4XXX_I2C_ADDR_LLL;
+    #if defined(DIGIPOT_STATS)
+        CHECK_EQ(stats->n_transactions, 3);
+        CHECK_EQ(stats->n_nacks, 1);
+    #endif
+
+    // A read whose reply never comes back is short.
+    chip.nack_reads = true;
+    CHECK_EQ(pot.get_code(1, true), DIGIPOT_CODE_INVALID);
+    CHECK_EQ(pot.status(), DIGIPOT_ERR_SHORT_READ);
+    chip.nack_reads = false;
+    #if defined(DIGIPOT_STATS)
+        CHECK_EQ(stats->n_transactions, 4);
+        CHECK_EQ(stats->n_short_reads, 1);
+        CHECK_EQ(stats->n_nacks, 1);
+        CHECK_EQ(stats->n_errors, 0);
+        CHECK_EQ(stats->n_cache_hits, 1);           // Failed reads aren't cache hits.
+    #endif
+
+    // A write to the other chip is charged to it, and counted by the bus.
+    CHECK_EQ(pot_d1x.set_code(100), 100);
+    CHECK_EQ(chip_d1x.wiper, 100);
+    #if defined(DIGIPOT_STATS)
+        CHECK_EQ(pot_d1x.stats()->n_transactions, 1);
+        CHECK_EQ(pot_d1x.stats()->n_bytes, 2);
+        CHECK_EQ(stats->n_transactions, 4);         // The MCP4661 isn't charged for it.
+        const DigiPot_stats *bus_stats = bus->stats();
+        CHECK_EQ(bus_stats->n_transactions, stats->n_transactions + 1);
+        CHECK_EQ(bus_stats->n_bytes, stats->n_bytes + 2);
+        CHECK_EQ(bus_stats->n_nacks, 1);
+        CHECK_EQ(bus_stats->n_short_reads, 1);
+        CHECK_EQ(bus_stats->n_cache_hits, 0);       // Cache hits and skipped writes are per-device.
+        CHECK_EQ(bus_stats->n_skipped_writes, 0);
+
+        // The latency histogram holds one entry per timed call.
+        uint32_t n_timed = 0;
+        for (uint8_t i = 0; i < DIGIPOT_STATS_BUCKETS; i++) {
+            n_timed += bus_stats->latency[i];
+        }
+        CHECK_EQ(n_timed, bus_stats->n_transactions);
+        CHECK(bus_stats->max_us > 0);
+
+        pot.reset_stats();                          // Clearing the device leaves the bus alone.
+        CHECK_EQ(pot.stats()->n_transactions, 0);
+        CHECK_EQ(pot.stats()->n_cache_hits, 0);
+        CHECK_EQ(bus->stats()->n_transactions, 5);
+    #endif
+
+    return host_test_done("stats");
+}
@@ -0,0 +1,198 @@
+/*!
+	tune.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Successive-approximation "tune" test against simulated MCP4xxx dividers
+	(terminal A at the reference, B at ground, the wiper read by a 12-bit
+	ADC). For 64, 128 and 256-step parts, every target from 0 to 4095 in
+	steps of 37 must land on the same error as a brute-force search of all
+	codes, in at most ceil(log2(N + 1)) + 1 wiper writes. Also checks the
+	early-stop and unreachable-target tolerance paths, automatic direction
+	detection, the monotonicity flag for a wrong direction setting, and the
+	result fields left by a search whose first write fails. Automatic
+	searches of rising and falling dividers must also match the brute-force
+	error, in at most the two end probes, ceil(log2(N)) probes between
+	them, and one final move, without probing any code twice.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+		2026-10-17 - Drew Sloan - Added a failed-write check.
+		2026-10-17 - Drew Sloan - Added automatic-direction sweeps.
+*/
+
+
+#include <stdlib.h>
+
+#include <Vulintus_DigiPot.h>
+#include "DigiPot_Sim.h"
+#include "host_test.h"
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define ADC_FULL_SCALE  4095            // 12-bit ADC.
+#define TARGET_STEP     37              // Spacing of the swept targets.
+
+struct Divider {
+    Sim_MCP4xxx *chip;                  // Simulated potentiometer.
+    uint16_t n_steps;                   // Number of resistor steps.
+    bool falling;                       // True if the ADC reads the A-to-wiper side (falls with the code).
+};
+
+
+// Measure the divider output, in ADC counts.
+static int32_t divider_adc(void *context)
+{
+    Divider *div = (Divider *) context;
+    int32_t value = (int32_t) ((int32_t) ADC_FULL_SCALE * div->chip->wiper[0] / div->n_steps);
+    return div->falling ? (ADC_FULL_SCALE - value) : value;
+}
+
+
+// Smallest error any code can reach for a rising divider.
+static int32_t best_error(uint16_t n_steps, int32_t target)
+{
+    int32_t best = INT32_MAX;
+    for (uint16_t code = 0; code <= n_steps; code++) {
+        int32_t err = abs((int32_t) ((int32_t) ADC_FULL_SCALE * code / n_steps) - target);
+        if (err < best) {
+            best = err;
+        }
+    }
+    return best;
+}
+
+
+// Number of writes a full search may take: ceil(log2(N + 1)) probes plus one final move.
+static uint8_t max_writes(uint16_t n_steps)
+{
+    uint8_t n = 0;
+    while ((1UL << n) < (uint32_t) (n_steps + 1)) {
+        n++;
+    }
+    return n + 1;
+}
+
+
+// Number of writes an automatic-direction search may take: both ends, ceil(log2(N)) probes between them, and one final move.
+static uint8_t max_auto_writes(uint16_t n_steps)
+{
+    uint8_t n = 0;
+    while ((1UL << n) < (uint32_t) n_steps) {
+        n++;
+    }
+    return n + 3;
+}
+
+
+int main(void)
+{
+    const uint16_t steps[3] = {64, 128, 256};
+    Sim_MCP4xxx chip_64(64, 1);                     // Single-wiper SPI parts (attached devices must outlive the bus).
+    Sim_MCP4xxx chip_128(128, 1);
+    Sim_MCP4xxx chip_256(256, 1);
+    Sim_MCP4xxx *chips[3] = {&chip_64, &chip_128, &chip_256};
+
+    for (uint8_t k = 0; k < 3; k++) {
+        Sim_MCP4xxx &chip = *chips[k];
+        chip.pin_cs = 10 + k;
+        SPI.attach(&chip);
+        Vulintus_MCP4xxx_DigiPot pot(steps[k], 10 + k, &SPI);
+        CHECK_EQ(pot.begin(), 0);
+        Divider div = {&chip, steps[k], false};
+
+        // Full searches: the result matches a brute-force search, within the write bound.
+        uint8_t most_writes = 0;
+        uint16_t n_mismatched = 0;
+        for (int32_t target = 0; target <= ADC_FULL_SCALE; target += TARGET_STEP) {
+            DigiPot_tune_config config = {target, 0, 100, 1, DIGIPOT_TUNE_RISING};
+            DigiPot_tune_result result = pot.tune(divider_adc, config, 0, &div);
+            if (abs(result.error) != best_error(steps[k], target)) {
+                n_mismatched++;
+                printf("%u steps, target %ld: code %u, error %ld, best error %ld\n", steps[k], (long) target, \
+                        result.code, (long) result.error, (long) best_error(steps[k], target));
+            }
+            CHECK_EQ(result.status, DIGIPOT_OK);
+            CHECK(result.monotonic);
+            CHECK_EQ(chip.wiper[0], result.code);   // The wiper is left at the reported code.
+            if (result.n_writes > most_writes) {
+                most_writes = result.n_writes;
+            }
+        }
+        printf("%3u steps: at most %u writes per search\n", steps[k], most_writes);
+        CHECK_EQ(n_mismatched, 0);
+        CHECK(most_writes <= max_writes(steps[k]));
+
+        // A wide tolerance stops the search early.
+        DigiPot_tune_config loose = {ADC_FULL_SCALE / 4, ADC_FULL_SCALE / 8, 100, 1, DIGIPOT_TUNE_RISING};
+        DigiPot_tune_result result = pot.tune(divider_adc, loose, 0, &div);
+        CHECK(result.in_tolerance);
+        CHECK(result.n_writes < max_writes(steps[k]) - 1);
+        CHECK(abs(result.error) <= loose.tolerance);
+
+        // An unreachable target ends at full scale, out of tolerance.
+        DigiPot_tune_config high = {ADC_FULL_SCALE + 500, 10, 100, 1, DIGIPOT_TUNE_RISING};
+        result = pot.tune(divider_adc, high, 0, &div);
+        CHECK(!result.in_tolerance);
+        CHECK_EQ(result.code, steps[k]);
+        CHECK_EQ(result.error, -500);
+        CHECK(result.monotonic);
+
+        // Automatic direction detection finds a falling divider.
+        div.falling = true;
+        DigiPot_tune_config automatic = {1000, ADC_FULL_SCALE / steps[k], 50, 4, DIGIPOT_TUNE_AUTO};
+        result = pot.tune(divider_adc, automatic, 0, &div);
+        CHECK(result.in_tolerance);
+        CHECK(result.monotonic);
+        CHECK_EQ(result.n_probes, result.n_writes);     // Every probe was a new code.
+        CHECK(result.n_writes <= max_writes(steps[k]) + 2);
+
+        // Automatic searches in both directions match a brute-force search, within their own write bound.
+        for (uint8_t falling = 0; falling < 2; falling++) {
+            div.falling = falling;
+            most_writes = 0;
+            n_mismatched = 0;
+            bool all_monotonic = true;
+            bool no_repeats = true;
+            for (int32_t target = 0; target <= ADC_FULL_SCALE; target += TARGET_STEP) {
+                DigiPot_tune_config config = {target, 0, 100, 1, DIGIPOT_TUNE_AUTO};
+                result = pot.tune(divider_adc, config, 0, &div);
+                int32_t rising_target = falling ? (ADC_FULL_SCALE - target) : target;
+                if (abs(result.error) != best_error(steps[k], rising_target)) {
+                    n_mismatched++;
+                }
+                if (!result.monotonic) {
+                    all_monotonic = false;
+                }
+                if (result.n_probes > result.n_writes + 1) {
+                    no_repeats = false;             // Only the first end probe may find the wiper already there.
+                }
+                if (result.n_writes > most_writes) {
+                    most_writes = result.n_writes;
+                }
+            }
+            printf("%3u steps, automatic (%s): at most %u writes per search\n", steps[k], \
+                    falling ? "falling" : "rising", most_writes);
+            CHECK_EQ(n_mismatched, 0);
+            CHECK(all_monotonic);
+            CHECK(no_repeats);
+            CHECK(most_writes <= max_auto_writes(steps[k]));
+        }
+
+        // The wrong direction setting is caught by the monotonicity check.
+        DigiPot_tune_config wrong = {1000, 10, 50, 1, DIGIPOT_TUNE_RISING};
+        result = pot.tune(divider_adc, wrong, 0, &div);
+        CHECK(!result.monotonic);
+        CHECK(!result.in_tolerance);
+
+        // A failed first write reports no measurement, out of tolerance.
+        result = pot.tune(divider_adc, loose, 3, &div);
+        CHECK_EQ(result.status, DIGIPOT_ERR_WIPER);
+        CHECK_EQ(result.n_writes, 0);
+        CHECK_EQ(result.measured, 0);
+        CHECK_EQ(result.error, 0);
+        CHECK(!result.in_tolerance);
+    }
+
+    return host_test_done("tune");
+}
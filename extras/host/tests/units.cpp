@@ -0,0 +1,191 @@
+/*!
+	units.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Integer unit conversion test on in-memory devices. Code-to-milliohm
+	conversions must match the exactly rounded linear model, and
+	milliohm-to-code conversions must pick the nearest code (ties round up),
+	checked against a brute-force search on 64, 256 and 65534-step ladders,
+	including a ladder too large to multiply by its step count in 32 bits.
+	Q16 writes must round to the nearest step, 0xFFFF must reach full
+	scale, and full scale must read back as DIGIPOT_Q16_ONE. The float
+	functions must write the same codes as the integer functions they wrap.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Test first created.
+*/
+
+
+#include <Vulintus_DigiPot.h>
+#include "host_test.h"
+
+
+// CLASSES ***********************************************************************************************************//
+class Memory_DigiPot : public Vulintus_DigiPot
+{
+    public:
+
+        Memory_DigiPot(uint16_t n_steps, uint32_t rab_mohm, uint32_t rw_mohm) : wiper(0)
+        {
+            n_resistors = n_steps;
+            n_wipers = 1;
+            max_resistance.mohm = rab_mohm;
+            wiper_resistance.mohm = rw_mohm;
+        }
+
+        uint16_t wiper;                 // Current wiper value.
+
+        uint8_t begin(void) { return 0; }
+
+        using Vulintus_DigiPot::code_to_mohm;      // Expose the conversions under test.
+        using Vulintus_DigiPot::mohm_to_code;
+
+    protected:
+
+        uint8_t bus_write(uint16_t code, uint8_t wiper_i)
+        {
+            (void) wiper_i;
+            wiper = code;
+            return 0;
+        }
+
+        uint16_t bus_read(uint8_t wiper_i)
+        {
+            (void) wiper_i;
+            return wiper;
+        }
+
+};
+
+
+// Exactly rounded linear model, in 64-bit math.
+static uint32_t model_mohm(Memory_DigiPot *pot, uint16_t code)
+{
+    uint64_t n = pot->n_resistors;
+    return pot->wiper_resistance.mohm + (uint32_t) (((uint64_t) pot->max_resistance.mohm * code + (n >> 1)) / n);
+}
+
+
+// Brute-force nearest code (ties round up).
+static uint16_t nearest_code(Memory_DigiPot *pot, uint32_t mohm)
+{
+    uint16_t best = 0;
+    uint32_t best_err = 0xFFFFFFFF;
+    for (uint32_t code = 0; code <= pot->n_resistors; code++) {
+        uint32_t r = pot->code_to_mohm(code);
+        uint32_t err = (r > mohm) ? (r - mohm) : (mohm - r);
+        if (err <= best_err) {
+            best = code;
+            best_err = err;
+        }
+    }
+    return best;
+}
+
+
+// Check one ladder's conversions in both directions.
+static void check_ladder(Memory_DigiPot *pot, uint32_t n_targets)
+{
+    bool model_matches = true;
+    for (uint32_t code = 0; code <= pot->n_resistors; code++) {
+        if (pot->code_to_mohm(code) != model_mohm(pot, code)) {
+            model_matches = false;
+        }
+    }
+    CHECK(model_matches);
+
+    bool nearest_matches = true;                    // Targets spread over the ladder, past both ends.
+    uint32_t top = pot->code_to_mohm(pot->n_resistors);
+    uint32_t step = top / n_targets + 1;
+    for (uint32_t mohm = 0; mohm < top + 2 * step; mohm += step) {
+        if (pot->mohm_to_code(mohm) != nearest_code(pot, mohm)) {
+            nearest_matches = false;
+        }
+    }
+    CHECK(nearest_matches);
+
+    bool round_trips = true;                        // Every code's own resistance maps back to it.
+    for (uint32_t code = 0; code <= pot->n_resistors; code++) {
+        if (pot->mohm_to_code(pot->code_to_mohm(code)) != code) {
+            round_trips = false;
+        }
+    }
+    CHECK(round_trips);
+
+    CHECK_EQ(pot->mohm_to_code(0), 0);              // Below the wiper resistance.
+    CHECK_EQ(pot->mohm_to_code(0xFFFFFFFE), pot->n_resistors);     // Above full scale.
+}
+
+
+// Check the Q16 and float paths on one ladder.
+static void check_ratio(Memory_DigiPot *pot)
+{
+    bool rounds = true;                             // Every position rounds to the nearest step.
+    bool wrappers_match = true;
+    for (uint32_t ratio = 0; ratio < 0xFFFF; ratio += 97) {
+        uint64_t exact = (uint64_t) ratio * pot->n_resistors;
+        uint16_t expected = (exact + 0x8000) >> 16;
+        pot->set_ratio_q16(ratio);
+        if (pot->wiper != expected) {
+            rounds = false;
+        }
+        pot->set_scaled(ratio / 65536.0);           // The float wrapper writes the same code...
+        if (pot->wiper != expected) {
+            wrappers_match = false;
+        }
+    }
+    CHECK(rounds);
+    CHECK(wrappers_match);
+
+    CHECK_EQ(pot->set_ratio_q16(0xFFFF), DIGIPOT_Q16_ONE);     // 0xFFFF is full scale.
+    CHECK_EQ(pot->wiper, pot->n_resistors);
+    CHECK_EQ(pot->get_ratio_q16(), DIGIPOT_Q16_ONE);
+    CHECK_EQ(pot->get_ratio_q16(0, true), DIGIPOT_Q16_ONE);
+    CHECK_EQ(pot->set_ratio_q16(0), 0);
+    CHECK_EQ(pot->wiper, 0);
+    pot->set_scaled(1.0);
+    CHECK_EQ(pot->wiper, pot->n_resistors);
+    CHECK(pot->get_scaled() == 1.0);
+
+    bool ohms_match = true;                         // ...and so do the resistance wrappers.
+    uint32_t top = pot->code_to_mohm(pot->n_resistors);
+    for (uint32_t mohm = 0; mohm < top; mohm += top / 50 + 7) {
+        uint32_t actual = pot->set_milliohms(mohm);
+        uint16_t code = pot->wiper;
+        float ohms = pot->set_resistance(mohm * 0.001);
+        if ((pot->wiper != code) || (ohms != (float) (actual * 0.001)) || (pot->get_resistance() != ohms)) {
+            ohms_match = false;
+        }
+    }
+    CHECK(ohms_match);
+}
+
+
+int main(void)
+{
+    Memory_DigiPot pot_64(64, 10000000, 75000);     // AD5273-like: 10 kOhm, 64 steps.
+    Memory_DigiPot pot_256(256, 100000000, 75000);  // MCP4xxx-like: 100 kOhm, 256 steps.
+    Memory_DigiPot pot_16bit(0xFFFE, 4000000000UL, 0);     // 4 MOhm over 65534 steps (0xFFFF is DIGIPOT_CODE_INVALID).
+
+    check_ladder(&pot_64, 5000);
+    check_ladder(&pot_256, 5000);
+    check_ladder(&pot_16bit, 200);
+
+    // Rounding at an exact midpoint goes up: codes 10 and 11 on the 256-step ladder.
+    uint32_t lo = pot_256.code_to_mohm(10);
+    uint32_t hi = pot_256.code_to_mohm(11);
+    CHECK_EQ(lo, 75000 + 3906250);
+    CHECK_EQ(hi, 75000 + 4296875);
+    CHECK_EQ(pot_256.mohm_to_code(lo + (hi - lo) / 2), 10);     // Just below the midpoint (the span is odd).
+    CHECK_EQ(pot_256.mohm_to_code(lo + (hi - lo) / 2 + 1), 11);
+    CHECK_EQ(pot_64.code_to_mohm(1), 75000 + 156250);
+    CHECK_EQ(pot_64.mohm_to_code(75000 + 78125), 1);           // Exactly halfway rounds up.
+    CHECK_EQ(pot_64.mohm_to_code(75000 + 78124), 0);
+
+    check_ratio(&pot_64);
+    check_ratio(&pot_256);
+    check_ratio(&pot_16bit);
+
+    return host_test_done("units");
+}
@@ -0,0 +1,112 @@
+/*!
+	Arduino.h (Linux build)
+
+	copyright 2026, Vulintus, Inc.
+
+	Minimal Arduino core for running the Vulintus_DigiPot drivers in "src/" 
+	on Linux single-board computers. Time comes from the monotonic clock. 
+	Pins are only remembered, except that SPI chip select pins attached 
+	with "SPI.attach" pick the spidev device for the next transfers.
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Linux layer first created.
+*/
+
+
+#ifndef VULINTUS_LINUX_ARDUINO_H
+#define VULINTUS_LINUX_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define HIGH        0x1
+#define LOW         0x0
+#define INPUT       0x0
+#define OUTPUT      0x1
+#define LSBFIRST    0
+#define MSBFIRST    1
+
+#define PROGMEM
+#define PSTR(s)                 (s)
+#define F(s)                    (s)
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr)      (*(void * const *)(addr))
+
+#define LINUX_NUM_PINS  256             // Number of remembered digital pins.
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+typedef int (*Linux_ioctl_fn)(int fd, unsigned long request, void *arg);     // ioctl replacement for the bus backends.
+
+
+// FUNCTIONS *********************************************************************************************************//
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint32_t micros(void);
+uint32_t millis(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void noInterrupts(void);
+void interrupts(void);
+void yield(void);
+
+
+// CLASSES ***********************************************************************************************************//
+class Print
+{
+    public:
+
+        virtual size_t write(uint8_t c);
+        virtual size_t write(const uint8_t *buf, size_t n);
+
+        size_t print(const char *str);
+        size_t print(char c);
+        size_t print(long n, int base = 10);
+        size_t print(unsigned long n, int base = 10);
+        size_t print(int n, int base = 10);
+        size_t print(unsigned int n, int base = 10);
+        size_t print(double n, int digits = 2);
+
+        size_t println(void);
+        size_t println(const char *str);
+        size_t println(char c);
+        size_t println(long n, int base = 10);
+        size_t println(unsigned long n, int base = 10);
+        size_t println(int n, int base = 10);
+        size_t println(unsigned int n, int base = 10);
+        size_t println(double n, int digits = 2);
+
+};
+
+
+class Stream : public Print
+{
+    public:
+
+        virtual int available(void);
+        virtual int read(void);
+
+};
+
+
+class HardwareSerial : public Stream
+{
+    public:
+
+        void begin(uint32_t baud);
+        operator bool(void) { return true; }
+
+};
+
+extern HardwareSerial Serial;
+
+#endif      // #ifndef VULINTUS_LINUX_ARDUINO_H
@@ -0,0 +1,197 @@
+/*!
+	Linux_Arduino.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Linux implementation of the Arduino core. See "Arduino.h" in this 
+	folder.
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Linux layer first created.
+		2026-10-17 - Drew Sloan - Chip select pin changes are passed to the 
+		                          spidev backend.
+*/
+
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+
+#include <Arduino.h>
+#include <SPI.h>
+
+
+// ARDUINO CORE ******************************************************************************************************//
+
+static uint8_t _linux_pins[LINUX_NUM_PINS];     // Last value written to each pin.
+
+static struct Linux_pins_init {                 // Start with every pin high (chip selects idle).
+    Linux_pins_init(void) { memset(_linux_pins, HIGH, sizeof(_linux_pins)); }
+} _linux_pins_init;
+
+HardwareSerial Serial;
+
+
+static uint64_t linux_time_ns(void)
+{
+    static uint64_t t0 = 0;                     // Time of the first call.
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = ((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+    if (t0 == 0) {                              // Count from the first call, like a board reset.
+        t0 = ns;
+    }
+    return ns - t0;
+}
+
+
+static void linux_sleep_ns(uint64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec = ns / 1000000000ULL;
+    ts.tv_nsec = ns % 1000000000ULL;
+    while (nanosleep(&ts, &ts) != 0) {          // Resume after signals.
+    }
+}
+
+
+void pinMode(uint8_t /* pin */, uint8_t /* mode */)
+{
+}
+
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if (_linux_pins[pin] == val) {              // Ignore writes that don't change the pin.
+        return;
+    }
+    _linux_pins[pin] = val;                     // Save the new state.
+    for (uint8_t i = 0; i < 4; i++) {           // Let each SPI bus watch its chip select pins.
+        if (SPIClass::buses[i] != NULL) {
+            SPIClass::buses[i]->pin_changed(pin, val);
+        }
+    }
+}
+
+
+int digitalRead(uint8_t pin)
+{
+    return _linux_pins[pin];
+}
+
+
+uint32_t micros(void)
+{
+    return (uint32_t) (linux_time_ns() / 1000);
+}
+
+
+uint32_t millis(void)
+{
+    return (uint32_t) (linux_time_ns() / 1000000);
+}
+
+
+void delay(uint32_t ms)
+{
+    linux_sleep_ns((uint64_t) ms * 1000000);
+}
+
+
+void delayMicroseconds(uint32_t us)
+{
+    linux_sleep_ns((uint64_t) us * 1000);
+}
+
+
+void noInterrupts(void)
+{
+}
+
+
+void interrupts(void)
+{
+}
+
+
+void yield(void)
+{
+    sched_yield();
+}
+
+
+// PRINT/STREAM ******************************************************************************************************//
+
+size_t Print::write(uint8_t c)
+{
+    return fwrite(&c, 1, 1, stdout);
+}
+
+
+size_t Print::write(const uint8_t *buf, size_t n)
+{
+    size_t count = 0;
+    while (n--) {
+        count += write(*buf++);
+    }
+    return count;
+}
+
+
+static size_t print_fmt(Print *p, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static size_t print_fmt(Print *p, const char *fmt, ...)
+{
+    char buf[64];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n < 0) {
+        return 0;
+    }
+    return p->write((const uint8_t *) buf, strlen(buf));
+}
+
+
+static size_t print_base(Print *p, unsigned long n, int base, bool negative)
+{
+    char buf[8 * sizeof(long) + 2];
+    char *str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) {
+        base = 10;
+    }
+    do {
+        uint8_t digit = n % base;
+        n /= base;
+        *--str = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+    } while (n);
+    if (negative) {
+        *--str = '-';
+    }
+    return p->write((const uint8_t *) str, strlen(str));
+}
+
+
+size_t Print::print(const char *str)              { return write((const uint8_t *) str, strlen(str)); }
+size_t Print::print(char c)                       { return write((uint8_t) c); }
+size_t Print::print(long n, int base)             { return (n < 0) ? print_base(this, -n, base, true) : print_base(this, n, base, false); }
+size_t Print::print(unsigned long n, int base)    { return print_base(this, n, base, false); }
+size_t Print::print(int n, int base)              { return print((long) n, base); }
+size_t Print::print(unsigned int n, int base)     { return print((unsigned long) n, base); }
+size_t Print::print(double n, int digits)         { return print_fmt(this, "%.*f", digits, n); }
+
+size_t Print::println(void)                       { return print("\r\n"); }
+size_t Print::println(const char *str)            { return print(str) + println(); }
+size_t Print::println(char c)                     { return print(c) + println(); }
+size_t Print::println(long n, int base)           { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base)  { return print(n, base) + println(); }
+size_t Print::println(int n, int base)            { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base)   { return print(n, base) + println(); }
+size_t Print::println(double n, int digits)       { return print(n, digits) + println(); }
+
+int Stream::available(void)                       { return 0; }
+int Stream::read(void)                            { return -1; }
+
+void HardwareSerial::begin(uint32_t /* baud */)   { }
@@ -0,0 +1,311 @@
+/*!
+	Linux_SPI.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Linux spidev implementation of "SPIClass". See "SPI.h" in this folder.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - spidev backend first created.
+		2026-10-17 - Drew Sloan - Block transfers read back 0xFF inside a 
+		                          batch.
+		2026-10-17 - Drew Sloan - Added "last_error".
+*/
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include <Arduino.h>
+#include <SPI.h>
+
+
+// SPICLASS **********************************************************************************************************//
+
+SPIClass SPI;
+SPIClass *SPIClass::buses[4] = {NULL, NULL, NULL, NULL};
+
+
+SPIClass::SPIClass(void)
+{
+    _n_devs = 0;
+    _active = NULL;
+    _ioctl = NULL;
+    _batching = false;
+    _batch_error = 0;
+    _last_error = 0;
+    reset_stats();
+    for (uint8_t i = 0; i < 4; i++) {           // Register the bus for the chip select hook.
+        if (buses[i] == NULL) {
+            buses[i] = this;
+            break;
+        }
+    }
+}
+
+
+void SPIClass::begin(void)
+{
+}
+
+
+void SPIClass::end(void)
+{
+    for (uint8_t i = 0; i < _n_devs; i++) {     // Close the devices opened here.
+        if (_devs[i].own_fd) {
+            ::close(_devs[i].fd);
+        }
+    }
+    _n_devs = 0;
+    _active = NULL;
+}
+
+
+void SPIClass::beginTransaction(SPISettings settings)
+{
+    _settings = settings;                       // Applied when a chip select pin goes low.
+    _last_error = 0;                            // A new operation starts.
+}
+
+
+void SPIClass::endTransaction(void)
+{
+}
+
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    uint8_t reply = 0xFF;
+    queue(&data, &reply, 1);
+    if (_active != NULL) {                      // The reply is needed now.
+        send(_active);
+    }
+    return reply;
+}
+
+
+uint16_t SPIClass::transfer16(uint16_t data)
+{
+    uint8_t buf[2] = {(uint8_t) (data >> 8), (uint8_t) (data & 0xFF)};
+    queue(buf, buf, 2);
+    if (_active != NULL) {                      // The reply is needed now.
+        send(_active);
+    }
+    return (buf[0] << 8) | buf[1];
+}
+
+
+void SPIClass::transfer(void *buf, size_t count)
+{
+    uint8_t *p = (uint8_t *) buf;
+    while (count > 0) {                         // Split blocks bigger than the device buffer.
+        uint16_t n = (count > LINUX_SPI_BATCH_BYTES) ? LINUX_SPI_BATCH_BYTES : count;
+        queue(p, _batching ? NULL : p, n);      // Replies arrive when chip select goes high.
+        if (_batching) {                        // Replies to held operations are dropped...
+            memset(p, 0xFF, n);                 // ...so read back an idle MISO line, not the sent bytes.
+        }
+        p += n;
+        count -= n;
+    }
+}
+
+
+bool SPIClass::attach(uint8_t pin_cs, const char *path)
+{
+    int fd = ::open(path, O_RDWR);
+    if (fd < 0) {
+        return false;
+    }
+    if (!attach(pin_cs, fd)) {
+        ::close(fd);
+        return false;
+    }
+    _devs[_n_devs - 1].own_fd = true;
+    return true;
+}
+
+
+bool SPIClass::attach(uint8_t pin_cs, int fd)
+{
+    if (_n_devs >= LINUX_SPI_MAX_DEVICES) {
+        return false;
+    }
+    Linux_SPI_device *dev = &_devs[_n_devs++];
+    dev->pin = pin_cs;
+    dev->fd = fd;
+    dev->own_fd = false;
+    dev->mode = -1;                             // Set the mode before the first transfer.
+    dev->selected = false;
+    dev->n_xfers = 0;
+    dev->len = 0;
+    return true;
+}
+
+
+void SPIClass::set_ioctl(Linux_ioctl_fn fn)
+{
+    _ioctl = fn;
+}
+
+
+void SPIClass::begin_batch(void)
+{
+    _batching = true;
+    _batch_error = 0;
+}
+
+
+uint8_t SPIClass::end_batch(void)
+{
+    _batching = false;
+    for (uint8_t i = 0; i < _n_devs; i++) {     // One system call per device used.
+        if (!_devs[i].selected) {               // A device still selected is sent when its operation ends.
+            send(&_devs[i]);
+        }
+    }
+    return _batch_error;
+}
+
+
+uint8_t SPIClass::last_error(void)
+{
+    return _last_error;
+}
+
+
+void SPIClass::reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+
+void SPIClass::pin_changed(uint8_t pin, uint8_t val)
+{
+    for (uint8_t i = 0; i < _n_devs; i++) {
+        Linux_SPI_device *dev = &_devs[i];
+        if (dev->pin != pin) {
+            continue;
+        }
+        if ((val == LOW) && !dev->selected) {   // Start of an operation.
+            uint8_t error = set_mode(dev);
+            if (error && !_last_error) {
+                _last_error = error;
+            }
+            dev->selected = true;
+            _active = dev;
+        }
+        else if ((val == HIGH) && dev->selected) {  // End of an operation.
+            dev->selected = false;
+            if (_active == dev) {
+                _active = NULL;
+            }
+            if (dev->n_xfers == 0) {
+                continue;
+            }
+            if (_batching) {                    // Toggle chip select before the next held operation.
+                dev->xfers[dev->n_xfers - 1].cs_change = 1;
+            }
+            else {
+                send(dev);
+            }
+        }
+    }
+}
+
+
+void SPIClass::queue(const uint8_t *tx, uint8_t *dest, uint16_t len)
+{
+    Linux_SPI_device *dev = _active;
+    if (dev == NULL) {                          // No device is selected.
+        stats.dropped++;
+        if (dest != NULL) {
+            memset(dest, 0xFF, len);            // Idle (pulled-up) MISO.
+        }
+        return;
+    }
+    if ((dev->n_xfers >= LINUX_SPI_MAX_XFERS) || ((dev->len + len) > LINUX_SPI_BATCH_BYTES)) {
+        send(dev);                              // Full: send what's held first (chip select stays low).
+    }
+    struct spi_ioc_transfer *xfer = &dev->xfers[dev->n_xfers];
+    memset(xfer, 0, sizeof(*xfer));
+    memcpy(&dev->tx[dev->len], tx, len);
+    xfer->tx_buf = (uintptr_t) &dev->tx[dev->len];
+    xfer->rx_buf = (uintptr_t) &dev->rx[dev->len];
+    xfer->len = len;
+    xfer->speed_hz = _settings.clock;
+    xfer->bits_per_word = 8;
+    dev->dest[dev->n_xfers++] = dest;
+    dev->len += len;
+}
+
+
+uint8_t SPIClass::send(Linux_SPI_device *dev)
+{
+    if (dev->n_xfers == 0) {
+        return 0;
+    }
+    dev->xfers[dev->n_xfers - 1].cs_change = dev->selected;     // Hold chip select low if the operation isn't over.
+    stats.ioctls++;
+    stats.transfers += dev->n_xfers;
+    stats.bytes += dev->len;
+    if (dev->n_xfers > stats.max_batch) {
+        stats.max_batch = dev->n_xfers;
+    }
+    int result = call(dev->fd, SPI_IOC_MESSAGE(dev->n_xfers), dev->xfers);
+    uint8_t error = 0;
+    if (result < 0) {
+        stats.errors++;
+        error = 4;                              // Bus error.
+    }
+    for (uint8_t i = 0; i < dev->n_xfers; i++) {    // Hand back the replies.
+        if (dev->dest[i] != NULL) {
+            if (error) {
+                memset(dev->dest[i], 0xFF, dev->xfers[i].len);
+            }
+            else {
+                memcpy(dev->dest[i], (uint8_t *) (uintptr_t) dev->xfers[i].rx_buf, dev->xfers[i].len);
+            }
+        }
+    }
+    dev->n_xfers = 0;
+    dev->len = 0;
+    if (error && !_batch_error) {               // Remember the first error for "end_batch"...
+        _batch_error = error;
+    }
+    if (error && !_last_error) {                // ...and for "last_error".
+        _last_error = error;
+    }
+    return error;
+}
+
+
+uint8_t SPIClass::set_mode(Linux_SPI_device *dev)
+{
+    uint8_t mode = (_settings.data_mode >> 2) & 0x03;   // Arduino SPI_MODEx to spidev SPI_MODE_x.
+    if (_settings.bit_order == LSBFIRST) {
+        mode |= SPI_LSB_FIRST;
+    }
+    if (dev->mode == mode) {                    // Most transactions don't change the mode.
+        return 0;
+    }
+    uint8_t error = send(dev);                  // Held transfers go out in the old mode.
+    stats.mode_sets++;
+    if (call(dev->fd, SPI_IOC_WR_MODE, &mode) < 0) {
+        stats.errors++;
+        dev->mode = -1;
+        return 4;                               // Bus error.
+    }
+    dev->mode = mode;
+    return error;
+}
+
+
+int SPIClass::call(int fd, unsigned long request, void *arg)
+{
+    if (_ioctl != NULL) {
+        return _ioctl(fd, request, arg);
+    }
+    return ::ioctl(fd, request, arg);
+}
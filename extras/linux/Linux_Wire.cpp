@@ -0,0 +1,290 @@
+/*!
+	Linux_Wire.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Linux i2c-dev implementation of "TwoWire". See "Wire.h" in this folder.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Linux layer first created.
+		2026-10-17 - Drew Sloan - "requestFrom" counts reads that can't keep 
+		                          the bus ("send_stop" false).
+		2026-10-17 - Drew Sloan - A message isn't held when the early send 
+		                          before it fails.
+*/
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+
+
+// TWOWIRE ***********************************************************************************************************//
+
+TwoWire Wire;
+
+
+TwoWire::TwoWire(const char *path)
+{
+    _path = path;
+    _fd = -1;
+    _own_fd = false;
+    _ioctl = NULL;
+    _clock = 100000;
+    _tx_len = 0;
+    _rx_len = 0;
+    _rx_pos = 0;
+    _n_msgs = 0;
+    _data_len = 0;
+    _batching = false;
+    _batch_error = 0;
+    reset_stats();
+}
+
+
+void TwoWire::begin(void)
+{
+    if ((_fd < 0) && (_path != NULL)) {         // Open the default adapter if nothing's open yet.
+        open(_path);
+    }
+}
+
+
+void TwoWire::end(void)
+{
+    if (_own_fd && (_fd >= 0)) {
+        ::close(_fd);
+    }
+    _fd = -1;
+    _own_fd = false;
+}
+
+
+void TwoWire::setClock(uint32_t clock)
+{
+    _clock = clock;                             // The kernel sets the adapter's clock.
+}
+
+
+void TwoWire::beginTransmission(uint8_t addr)
+{
+    _tx_addr = addr;
+    _tx_len = 0;
+}
+
+
+size_t TwoWire::write(uint8_t data)
+{
+    if (_tx_len >= BUFFER_LENGTH) {
+        return 0;
+    }
+    _tx_buf[_tx_len++] = data;
+    return 1;
+}
+
+
+size_t TwoWire::write(const uint8_t *buf, size_t n)
+{
+    size_t count = 0;
+    while (n-- && write(*buf++)) {
+        count++;
+    }
+    return count;
+}
+
+
+uint8_t TwoWire::endTransmission(bool send_stop)
+{
+    if (((_tx_addr & 0x7C) == 0x04) && (_tx_len == 0)) {    // Hs master code (0000 1XXX).
+        return 2;                               // Dropped. Nobody acknowledges a master code anyway.
+    }
+    uint8_t len = _tx_len;
+    uint8_t error = queue(_tx_addr, 0, _tx_buf, len);   // Hold the write.
+    _tx_len = 0;
+    if (error || !send_stop) {                  // Without a STOP, the write waits for the next message.
+        return error;
+    }
+    if (_batching && (len > 0)) {               // Batched writes wait for "end_batch"...
+        return 0;
+    }
+    return send();                              // ...everything else goes out now.
+}
+
+
+uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t qty, uint8_t send_stop)
+{
+    if (qty > BUFFER_LENGTH) {
+        qty = BUFFER_LENGTH;
+    }
+    _rx_len = 0;
+    _rx_pos = 0;
+    if (!send_stop) {                           // The system call ends with a STOP regardless...
+        stats.split_reads++;                    // ...so count the split.
+    }
+    if (queue(addr, I2C_M_RD, _rx_buf, qty) || send()) {   // Reads need their data now.
+        return 0;
+    }
+    _rx_len = qty;
+    return qty;
+}
+
+
+int TwoWire::available(void)
+{
+    return _rx_len - _rx_pos;
+}
+
+
+int TwoWire::read(void)
+{
+    if (_rx_pos >= _rx_len) {
+        return -1;
+    }
+    return _rx_buf[_rx_pos++];
+}
+
+
+int TwoWire::peek(void)
+{
+    if (_rx_pos >= _rx_len) {
+        return -1;
+    }
+    return _rx_buf[_rx_pos];
+}
+
+
+bool TwoWire::open(const char *path)
+{
+    end();                                      // Close anything opened before.
+    _fd = ::open(path, O_RDWR);
+    _own_fd = (_fd >= 0);
+    return _own_fd;
+}
+
+
+void TwoWire::attach_fd(int fd)
+{
+    end();                                      // Close anything opened before.
+    _fd = fd;
+}
+
+
+int TwoWire::fd(void)
+{
+    return _fd;
+}
+
+
+void TwoWire::set_ioctl(Linux_ioctl_fn fn)
+{
+    _ioctl = fn;
+}
+
+
+void TwoWire::begin_batch(void)
+{
+    _batching = true;
+    _batch_error = 0;
+}
+
+
+uint8_t TwoWire::end_batch(void)
+{
+    _batching = false;
+    uint8_t error = send();                     // Send whatever is still held.
+    return _batch_error ? _batch_error : error;
+}
+
+
+uint32_t TwoWire::clock(void)
+{
+    return _clock;
+}
+
+
+void TwoWire::reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+
+uint8_t TwoWire::queue(uint8_t addr, uint16_t flags, const uint8_t *buf, uint8_t len)
+{
+    bool read = (flags & I2C_M_RD);
+    if ((_n_msgs >= LINUX_I2C_MAX_MSGS) || (!read && ((_data_len + len) > LINUX_I2C_BATCH_BYTES))) {
+        uint8_t error = send();                 // Full: send what's held first.
+        if (error) {                            // If that failed, drop this message too, so...
+            return error;                       // ...an error always means the message wasn't held.
+        }
+    }
+    struct i2c_msg *msg = &_msgs[_n_msgs++];
+    msg->addr = addr;
+    msg->flags = flags;
+    msg->len = len;
+    if (read) {                                 // Reads land in the receive buffer.
+        msg->buf = (__u8 *) buf;
+    }
+    else {                                      // Writes are copied, since the caller reuses its buffer.
+        msg->buf = &_data[_data_len];
+        memcpy(msg->buf, buf, len);
+        _data_len += len;
+    }
+    return 0;
+}
+
+
+uint8_t TwoWire::send(void)
+{
+    if (_n_msgs == 0) {
+        return 0;
+    }
+    struct i2c_rdwr_ioctl_data rdwr;
+    rdwr.msgs = _msgs;
+    rdwr.nmsgs = _n_msgs;
+    stats.ioctls++;
+    stats.messages += _n_msgs;
+    if (_n_msgs > stats.max_batch) {
+        stats.max_batch = _n_msgs;
+    }
+    for (uint8_t i = 0; i < _n_msgs; i++) {
+        stats.bytes += _msgs[i].len;
+    }
+    int result;
+    if (_fd < 0) {                              // No adapter is open.
+        result = -1;
+        errno = EBADF;
+    }
+    else if (_ioctl != NULL) {
+        result = _ioctl(_fd, I2C_RDWR, &rdwr);
+    }
+    else {
+        result = ::ioctl(_fd, I2C_RDWR, &rdwr);
+    }
+    _n_msgs = 0;
+    _data_len = 0;
+    if (result >= 0) {
+        return 0;
+    }
+    stats.errors++;
+    uint8_t error;
+    switch (errno) {                            // Convert to a Wire "endTransmission" code.
+        case ENXIO:                             // Most adapters report a NACK as ENXIO or EREMOTEIO.
+        case EREMOTEIO:
+            error = 2;
+            break;
+        case ETIMEDOUT:
+            error = 5;
+            break;
+        default:
+            error = 4;
+            break;
+    }
+    if (_batching && !_batch_error) {           // Remember the first error for "end_batch".
+        _batch_error = error;
+    }
+    return error;
+}
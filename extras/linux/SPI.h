@@ -0,0 +1,175 @@
+/*!
+	SPI.h (Linux build)
+
+	copyright 2026, Vulintus, Inc.
+
+	"SPIClass" over Linux spidev devices ("/dev/spidevB.C"). Each spidev
+	device drives one chip select line, so every chip select pin the
+	drivers use is attached to its device with "attach". Pulling an attached
+	pin low (through "digitalWrite") selects that device. Instead of one
+	system call per "transfer", transfers are collected and sent with a
+	single SPI_IOC_MESSAGE ioctl:
+		- Everything between a chip select falling and rising edge (one
+		  logical operation, such as an MCP4xxx command frame) is one
+		  system call, sent at the rising edge. Block transfers get their
+		  replies in place, as usual.
+		- Between "begin_batch" and "end_batch", operations are held per
+		  device, with "cs_change" set on the last transfer of each
+		  operation so chip select still toggles between them. "end_batch"
+		  sends one system call per device used (a spidev message can only
+		  drive its own chip select line). Replies to held operations are
+		  dropped, so only batch writes. Block transfers read back 0xFF
+		  (an idle MISO line) inside a batch, so reads fail their range
+		  check and the MCP4xxx CMDERR bits ("cmd_error") always read as
+		  clear. A command error inside a batch isn't seen.
+		- The drivers cache held writes as if they'd been sent. So when
+		  "end_batch" returns an error, call "clear_cache" on every device
+		  written in the batch. "Vulintus_DigiPotGroup::flush_batch" does
+		  this for a group (this file defines DIGIPOT_SPI_BATCH for it).
+		- A single-byte "transfer" needs its reply right away. It sends what
+		  is held for the selected device, with "cs_change" set on the last
+		  transfer so chip select stays low until the operation ends.
+		- Held transfers are also sent early if they reach LINUX_SPI_MAX_XFERS
+		  transfers or LINUX_SPI_BATCH_BYTES bytes.
+
+	SPI has no acknowledge, but the system call can fail. Replies to a
+	failed call read back 0xFF, and "last_error" keeps the first failure
+	since "beginTransaction" (this file defines DIGIPOT_SPI_ERRORS, so the
+	drivers check it when chip select rises and clear their cached wipers).
+
+	The clock rate and bit count travel with each transfer. The SPI mode
+	(and LSB-first order) takes an SPI_IOC_WR_MODE call, only when it
+	changes. Transfers while no attached pin is low are dropped, and read
+	back 0xFF (an idle MISO line).
+
+	"set_ioctl" replaces the ioctl call, and the file descriptor version of
+	"attach" uses an already-open device. Together they let the backend run
+	against a stand-in device with every system call counted in "stats".
+	See "benchmark/spi_benchmark.cpp".
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Linux layer first created.
+		2026-10-17 - Drew Sloan - Added the spidev backend.
+		2026-10-17 - Drew Sloan - Defines DIGIPOT_SPI_BATCH. Block transfers 
+		                          read back 0xFF inside a batch.
+		2026-10-17 - Drew Sloan - Added "last_error" (DIGIPOT_SPI_ERRORS), so 
+		                          failed unbatched transfers are reported.
+*/
+
+
+#ifndef VULINTUS_LINUX_SPI_H
+#define VULINTUS_LINUX_SPI_H
+
+#include <Arduino.h>
+#include <linux/spi/spidev.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define SPI_MODE0   0x00
+#define SPI_MODE1   0x04
+#define SPI_MODE2   0x08
+#define SPI_MODE3   0x0C
+
+#define LINUX_SPI_MAX_DEVICES   8               // Most spidev devices (chip select pins) per bus.
+#define LINUX_SPI_MAX_XFERS     32              // Most transfers in one SPI_IOC_MESSAGE call.
+#define LINUX_SPI_BATCH_BYTES   512             // Bytes held per device for one call (spidev's default limit is 4096).
+
+#ifndef DIGIPOT_SPI_BATCH
+    #define DIGIPOT_SPI_BATCH           // This SPIClass has "begin_batch"/"end_batch".
+#endif
+
+#ifndef DIGIPOT_SPI_ERRORS
+    #define DIGIPOT_SPI_ERRORS          // This SPIClass reports failed transfers ("last_error").
+#endif
+
+struct Linux_SPI_stats {
+    uint32_t ioctls;            // SPI_IOC_MESSAGE system calls.
+    uint32_t mode_sets;         // SPI_IOC_WR_MODE system calls.
+    uint32_t transfers;         // Transfers sent (one per "transfer" call).
+    uint32_t bytes;             // Bytes sent.
+    uint32_t errors;            // Failed system calls.
+    uint32_t dropped;           // Transfers with no device selected.
+    uint32_t max_batch;         // Most transfers sent in one system call.
+};
+
+
+// CLASSES ***********************************************************************************************************//
+class SPISettings
+{
+    public:
+
+        SPISettings(void) : clock(4000000), bit_order(MSBFIRST), data_mode(SPI_MODE0) { }
+        SPISettings(uint32_t clock, uint8_t bit_order, uint8_t data_mode)
+            : clock(clock), bit_order(bit_order), data_mode(data_mode) { }
+
+        uint32_t clock;
+        uint8_t bit_order;
+        uint8_t data_mode;
+
+};
+
+
+struct Linux_SPI_device {
+    uint8_t pin;                                        // Chip select pin.
+    int fd;                                             // spidev file descriptor.
+    bool own_fd;                                        // Flag indicating the file descriptor was opened here.
+    int16_t mode;                                       // spidev mode last set (-1 if unknown).
+    bool selected;                                      // True while the chip select pin is low.
+    struct spi_ioc_transfer xfers[LINUX_SPI_MAX_XFERS]; // Transfers held for the next system call.
+    uint8_t *dest[LINUX_SPI_MAX_XFERS];                 // Where each transfer's reply goes (NULL to drop it).
+    uint8_t n_xfers;
+    uint8_t tx[LINUX_SPI_BATCH_BYTES];                  // Bytes held for the next system call.
+    uint8_t rx[LINUX_SPI_BATCH_BYTES];                  // Replies.
+    uint16_t len;
+};
+
+
+class SPIClass
+{
+    public:
+
+        SPIClass(void);
+
+        // Arduino API. //
+        void begin(void);
+        void end(void);
+        void beginTransaction(SPISettings settings);
+        void endTransaction(void);
+        uint8_t transfer(uint8_t data);
+        uint16_t transfer16(uint16_t data);
+        void transfer(void *buf, size_t count);
+
+        // Linux-only functions. //
+        bool attach(uint8_t pin_cs, const char *path);  // Open a spidev device for a chip select pin.
+        bool attach(uint8_t pin_cs, int fd);            // Use an already-open spidev device for a chip select pin.
+        void set_ioctl(Linux_ioctl_fn fn);              // Replace the ioctl call (NULL restores the real one).
+        void begin_batch(void);                         // Hold whole operations until "end_batch".
+        uint8_t end_batch(void);                        // Send the held operations, one system call per device (returns 0 on success).
+        uint8_t last_error(void);                       // First failed system call since "beginTransaction" (0 if none).
+        void reset_stats(void);                         // Clear the counters.
+        void pin_changed(uint8_t pin, uint8_t val);     // Chip select hook called by "digitalWrite()".
+        Linux_SPI_stats stats;                          // System call counters.
+
+        static SPIClass *buses[4];                      // All SPI buses, for the chip select hook.
+
+    private:
+
+        Linux_SPI_device _devs[LINUX_SPI_MAX_DEVICES];  // Attached devices.
+        uint8_t _n_devs;
+        Linux_SPI_device *_active;                      // Selected device (NULL if none).
+        SPISettings _settings;                          // Settings from the last "beginTransaction".
+        Linux_ioctl_fn _ioctl;                          // ioctl call (NULL for the real one).
+        bool _batching;                                 // True between "begin_batch" and "end_batch".
+        uint8_t _batch_error;                           // First error in the current batch.
+        uint8_t _last_error;                            // First error since "beginTransaction".
+
+        void queue(const uint8_t *tx, uint8_t *dest, uint16_t len);    // Hold a transfer for the selected device.
+        uint8_t send(Linux_SPI_device *dev);            // Send a device's held transfers in one system call.
+        uint8_t set_mode(Linux_SPI_device *dev);        // Apply the transaction's SPI mode to a device.
+        int call(int fd, unsigned long request, void *arg);    // Make an ioctl call (or the replacement).
+
+};
+
+extern SPIClass SPI;
+
+#endif      // #ifndef VULINTUS_LINUX_SPI_H
@@ -0,0 +1,138 @@
+/*!
+	Wire.h (Linux build)
+
+	copyright 2026, Vulintus, Inc.
+
+	"TwoWire" over a Linux I2C adapter ("/dev/i2c-N", i2c-dev). Instead of
+	one system call per byte or per register, transfers are collected as
+	I2C messages and sent with a single I2C_RDWR ioctl:
+		- "endTransmission(false)" holds its write message, so a following
+		  "requestFrom" sends the write and the read together, joined by a
+		  repeated START.
+		- Between "begin_batch" and "end_batch", completed writes are also
+		  held. So writes to many devices (for example a staged
+		  "Vulintus_DigiPotGroup::flush") go out as one multi-message ioctl.
+		  They return 0 when queued, and "end_batch" returns the first error
+		  for the whole batch. Reads and zero-length writes (address probes)
+		  still go out right away, along with any writes queued before them.
+		- The drivers cache a held write as if it had been sent, and
+		  I2C_RDWR stops at the first message that fails. So when
+		  "end_batch" returns an error, call "clear_cache" on every device
+		  written in the batch. "Vulintus_DigiPotGroup::flush_batch" does
+		  this for a group (this file defines DIGIPOT_I2C_BATCH for it).
+		- A batch is sent early if it reaches LINUX_I2C_MAX_MSGS messages or
+		  LINUX_I2C_BATCH_BYTES bytes of write data.
+
+	A read ends the system call, and every system call ends with a STOP. So
+	a read that shouldn't end with a STOP ("requestFrom(addr, n, false)")
+	still does, and the next message starts with a new START instead of a
+	repeated START. These reads are counted in "stats.split_reads". The
+	adapter's clock is set by the kernel (device tree or
+	module parameters): "setClock" is only recorded, and Hs-mode master
+	codes are dropped.
+
+	"set_ioctl" replaces the ioctl call, and "attach_fd" uses an already-open
+	file descriptor. Together they let the backend run against a stand-in
+	device with every system call counted in "stats". (The i2c-stub kernel
+	module only handles SMBus transfers, so it rejects I2C_RDWR.)
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Linux layer first created.
+		2026-10-17 - Drew Sloan - Defines DIGIPOT_I2C_BATCH. Added 
+		                          "stats.split_reads".
+*/
+
+
+#ifndef VULINTUS_LINUX_WIRE_H
+#define VULINTUS_LINUX_WIRE_H
+
+#include <Arduino.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define BUFFER_LENGTH           32              // Same transmit/receive buffer size as the AVR Wire library.
+#define LINUX_I2C_MAX_MSGS      42              // Most messages in one I2C_RDWR call (I2C_RDWR_IOCTL_MAX_MSGS).
+#define LINUX_I2C_BATCH_BYTES   256             // Write data held for one I2C_RDWR call.
+
+#ifndef DIGIPOT_I2C_BATCH
+    #define DIGIPOT_I2C_BATCH           // This TwoWire has "begin_batch"/"end_batch".
+#endif
+
+#ifndef LINUX_I2C_DEFAULT_DEV
+    #define LINUX_I2C_DEFAULT_DEV   "/dev/i2c-1"    // Adapter opened by "Wire.begin()" (override before compiling).
+#endif
+
+struct Linux_I2C_stats {
+    uint32_t ioctls;            // I2C_RDWR system calls.
+    uint32_t messages;          // Messages sent (each starts with a START or repeated START).
+    uint32_t bytes;             // Data bytes written and read (not counting address bytes).
+    uint32_t errors;            // Failed system calls.
+    uint32_t max_batch;         // Most messages sent in one system call.
+    uint32_t split_reads;       // Reads asked not to end with a STOP, which the system call ends with one anyway.
+};
+
+
+// CLASSES ***********************************************************************************************************//
+class TwoWire : public Stream
+{
+    public:
+
+        TwoWire(const char *path = LINUX_I2C_DEFAULT_DEV);
+
+        // Arduino API. //
+        void begin(void);
+        void end(void);
+        void setClock(uint32_t clock);
+        void beginTransmission(uint8_t addr);
+        uint8_t endTransmission(bool send_stop = true);
+        uint8_t requestFrom(uint8_t addr, uint8_t qty, uint8_t send_stop = 1);
+        size_t write(uint8_t data);
+        size_t write(const uint8_t *buf, size_t n);
+        int available(void);
+        int read(void);
+        int peek(void);
+
+        // Linux-only functions. //
+        bool open(const char *path);            // Open an I2C adapter (closes any adapter opened before).
+        void attach_fd(int fd);                 // Use an already-open file descriptor (not closed by "end").
+        int fd(void);                           // File descriptor in use (-1 if none).
+        void set_ioctl(Linux_ioctl_fn fn);      // Replace the ioctl call (NULL restores the real one).
+        void begin_batch(void);                 // Hold completed writes until "end_batch".
+        uint8_t end_batch(void);                // Send the held writes in one system call (returns the first error; clear the written devices' caches if it fails).
+        uint32_t clock(void);                   // Last clock rate passed to "setClock".
+        void reset_stats(void);                 // Clear the counters.
+        Linux_I2C_stats stats;                  // System call counters.
+
+    private:
+
+        const char *_path;                      // Adapter opened by "begin".
+        int _fd;                                // Adapter file descriptor (-1 if none).
+        bool _own_fd;                           // Flag indicating the file descriptor was opened here.
+        Linux_ioctl_fn _ioctl;                  // ioctl call (NULL for the real one).
+        uint32_t _clock;                        // Last clock rate passed to "setClock".
+
+        uint8_t _tx_addr;                       // Address of the transmission being built.
+        uint8_t _tx_buf[BUFFER_LENGTH];         // Bytes of the transmission being built.
+        uint8_t _tx_len;
+
+        uint8_t _rx_buf[BUFFER_LENGTH];         // Bytes returned by the last "requestFrom".
+        uint8_t _rx_len;
+        uint8_t _rx_pos;
+
+        struct i2c_msg _msgs[LINUX_I2C_MAX_MSGS];   // Messages held for the next system call.
+        uint8_t _n_msgs;
+        uint8_t _data[LINUX_I2C_BATCH_BYTES];   // Write data for the held messages.
+        uint16_t _data_len;
+        bool _batching;                         // True between "begin_batch" and "end_batch".
+        uint8_t _batch_error;                   // First error in the current batch.
+
+        uint8_t queue(uint8_t addr, uint16_t flags, const uint8_t *buf, uint8_t len);     // Hold a message (sending early if full).
+        uint8_t send(void);                     // Send the held messages in one system call.
+
+};
+
+extern TwoWire Wire;
+
+#endif      // #ifndef VULINTUS_LINUX_WIRE_H
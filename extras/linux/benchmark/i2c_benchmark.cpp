@@ -0,0 +1,254 @@
+/*!
+	i2c_benchmark.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Benchmark for the i2c-dev backend against stand-in MCP4661 and MCP40D18
+	devices. The stand-in "ioctl" runs each I2C_RDWR message against the
+	device registers, stops at the first message to an absent address (as
+	the kernel does), and makes one real (trivial) system call per call so
+	that the kernel entry cost is counted. Prints the system calls and
+	messages for the operations in the README table, and the update rate
+	of a staged four-device group flush with and without a batch. Then
+	checks that a failed batch clears the members' cached wipers and keeps
+	their targets staged, so the next flush sends the same values again
+	once the device answers.
+
+	See "extras/linux/README.md" for the build command and results.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Benchmark first created.
+		2026-10-17 - Drew Sloan - The failed batch check no longer restages.
+*/
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <Vulintus_DigiPot.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define N_POTS          4               // Stand-in MCP4661s.
+#define ADDR_FIRST      0x28            // Address of the first MCP4661.
+#define ADDR_MCP40D18   0x2E            // Address of the stand-in MCP40D18.
+#define FD_ADAPTER      100             // Stand-in adapter file descriptor.
+#define N_FLUSHES       50000           // Group flushes per timed test.
+
+
+// STAND-IN DEVICES **************************************************************************************************//
+
+struct Standin_I2C {
+    uint8_t addr;                       // 7-bit address.
+    bool is_mcp40d1x;                   // True for the MCP40D18 (one register behind command byte 0x00).
+    bool present;                       // False to NACK the address.
+    uint16_t reg[16];                   // Register values.
+    uint8_t read_reg;                   // Register selected by the last read command.
+};
+
+static Standin_I2C standin[N_POTS + 1];
+
+
+// Find a stand-in device by address.
+static Standin_I2C *standin_find(uint8_t addr)
+{
+    for (uint8_t i = 0; i <= N_POTS; i++) {
+        if ((standin[i].addr == addr) && standin[i].present) {
+            return &standin[i];
+        }
+    }
+    return NULL;
+}
+
+
+// Run one write message against a stand-in device.
+static void standin_write(Standin_I2C *dev, const uint8_t *buf, uint16_t len)
+{
+    if (dev->is_mcp40d1x) {                     // Command byte, then the wiper value.
+        if (len >= 2) {
+            dev->reg[0] = buf[1] & 0x7F;
+        }
+        return;
+    }
+    for (uint16_t i = 0; i < len; ) {           // MCP4xxx command stream.
+        uint8_t reg = buf[i] >> 4;
+        uint8_t cmd = (buf[i] >> 2) & 0x03;
+        if ((cmd == 0) && ((i + 1) < len)) {    // Write.
+            dev->reg[reg] = ((buf[i] & 0x01) << 8) | buf[i + 1];
+            i += 2;
+        }
+        else if (cmd == 3) {                    // Read (the data comes back in the next message).
+            dev->read_reg = reg;
+            i += 1;
+        }
+        else {                                  // Increment or decrement.
+            dev->reg[reg] += (cmd == 1) ? 1 : -1;
+            i += 1;
+        }
+    }
+}
+
+
+// Run one read message against a stand-in device.
+static void standin_read(Standin_I2C *dev, uint8_t *buf, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        if (dev->is_mcp40d1x) {
+            buf[i] = dev->reg[0];
+        }
+        else {                                  // MCP4xxx: high byte, then low byte, repeating.
+            uint16_t value = dev->reg[dev->read_reg];
+            buf[i] = (i & 1) ? (value & 0xFF) : (0xFE | (value >> 8));
+        }
+    }
+}
+
+
+// Stand-in for ioctl on the adapter.
+static int standin_ioctl(int fd, unsigned long request, void *arg)
+{
+    syscall(SYS_getppid);                       // Pay for one real kernel entry.
+    if (fd != FD_ADAPTER) {
+        errno = EBADF;
+        return -1;
+    }
+    if (request != I2C_RDWR) {
+        errno = ENOTTY;
+        return -1;
+    }
+    struct i2c_rdwr_ioctl_data *rdwr = (struct i2c_rdwr_ioctl_data *) arg;
+    for (uint32_t i = 0; i < rdwr->nmsgs; i++) {
+        struct i2c_msg *msg = &rdwr->msgs[i];
+        Standin_I2C *dev = standin_find(msg->addr);
+        if (dev == NULL) {                      // Nobody acknowledged: the rest of the messages aren't sent.
+            errno = ENXIO;
+            return -1;
+        }
+        if (msg->flags & I2C_M_RD) {
+            standin_read(dev, msg->buf, msg->len);
+        }
+        else {
+            standin_write(dev, msg->buf, msg->len);
+        }
+    }
+    return rdwr->nmsgs;
+}
+
+
+// BENCHMARK *********************************************************************************************************//
+
+static uint8_t n_failed_checks = 0;
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+
+// Print the system calls and messages for one operation, and check them against the README table.
+static void report_calls(const char *name, uint32_t ioctls, uint32_t messages)
+{
+    bool ok = (Wire.stats.ioctls == ioctls) && (Wire.stats.messages == messages);
+    printf("%-48s %2u system calls %2u messages%s\n", name, (unsigned) Wire.stats.ioctls, \
+        (unsigned) Wire.stats.messages, ok ? "" : "   <- expected different counts");
+    n_failed_checks += !ok;
+}
+
+
+static void report_rate(const char *name, double t)
+{
+    printf("%-48s %8.3f system calls/flush %10.0f flushes/s\n", name,
+        (double) Wire.stats.ioctls / N_FLUSHES, N_FLUSHES / t);
+}
+
+
+int main(void)
+{
+    Vulintus_MCP4661 *pots[N_POTS];
+    Vulintus_DigiPotGroup group;
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        standin[i].addr = ADDR_FIRST + i;
+        standin[i].present = true;
+    }
+    standin[N_POTS].addr = ADDR_MCP40D18;
+    standin[N_POTS].is_mcp40d1x = true;
+    standin[N_POTS].present = true;
+    Wire.set_ioctl(standin_ioctl);
+    Wire.attach_fd(FD_ADAPTER);
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        pots[i] = new Vulintus_MCP4661(ADDR_FIRST + i);
+        pots[i]->begin();
+        group.add(pots[i]);
+    }
+    Vulintus_MCP40D18 pot_d1x;
+    pot_d1x.begin();
+
+    // System calls per operation.
+    Wire.reset_stats();
+    pots[0]->set_code(100, 1);
+    report_calls("MCP4661 wiper write", 1, 1);
+    Wire.reset_stats();
+    pots[0]->get_code(1, true);
+    report_calls("MCP4661 wiper read (get_code(w, true))", 1, 2);
+    Wire.reset_stats();
+    pot_d1x.get_code(0, true);
+    report_calls("MCP40D18 wiper read", 1, 2);
+    group.set_staged(true);
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        pots[i]->set_code(10 + i, 0);
+        pots[i]->set_code(20 + i, 1);
+    }
+    Wire.reset_stats();
+    group.flush_batch(&Wire);
+    report_calls("4 x MCP4661, both wipers, staged group flush", 1, 4);
+    group.set_staged(false);
+    Wire.reset_stats();
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        pots[i]->set_code(30 + i, 0);
+    }
+    report_calls("4 x MCP4661 wiper writes, unbatched", 4, 4);
+
+    // Group flush rates, with and without the batch.
+    group.set_staged(true);
+    Wire.reset_stats();
+    double t0 = now_s();
+    for (uint32_t k = 0; k < N_FLUSHES; k++) {
+        for (uint8_t i = 0; i < N_POTS; i++) {
+            pots[i]->set_code(k & 0xFF, 0);
+        }
+        group.flush();
+    }
+    report_rate("staged group flush, unbatched", now_s() - t0);
+    Wire.reset_stats();
+    t0 = now_s();
+    for (uint32_t k = 0; k < N_FLUSHES; k++) {
+        for (uint8_t i = 0; i < N_POTS; i++) {
+            pots[i]->set_code(k & 0xFF, 0);
+        }
+        group.flush_batch(&Wire);
+    }
+    report_rate("staged group flush, batched", now_s() - t0);
+
+    // A failed batch clears the members' caches and keeps their targets staged.
+    standin[1].present = false;                 // The second device stops answering.
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        pots[i]->set_code(200 + i, 0);
+    }
+    uint8_t n_failed = group.flush_batch(&Wire);
+    bool ok = (n_failed == N_POTS) && (standin[0].reg[0] == 200) && (standin[2].reg[0] != 202);
+    standin[1].present = true;
+    ok &= (group.flush_batch(&Wire) == 0);      // The targets were kept staged.
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        ok &= (standin[i].reg[0] == (uint16_t) (200 + i));
+    }
+    printf("%-48s %s\n", "failed batch, then resent", ok ? "ok" : "FAILED");
+    n_failed_checks += !ok;
+
+    return (n_failed_checks > 0);
+}
@@ -0,0 +1,220 @@
+/*!
+	spi_benchmark.cpp
+
+	copyright 2026, Vulintus, Inc.
+
+	Benchmark for the spidev backend against stand-in MCP42xx devices. The
+	stand-in "ioctl" decodes the command stream for each chip select, keeps
+	the wiper registers, and makes one real (trivial) system call per call
+	so that the kernel entry cost is counted. Prints the ioctls per command
+	and the command rate for:
+		- byte-at-a-time "SPI.transfer" commands, as a plain sketch would send,
+		- driver writes ("set_code"), one system call per command,
+		- driver writes inside "begin_batch"/"end_batch".
+	It also checks that a failed batch clears the members' cached wipers
+	and keeps their targets staged, so the next group flush sends the same
+	values again without restaging them, and that a failed
+	unbatched write is reported (DIGIPOT_ERR_BUS) and sent again.
+
+	See "extras/linux/README.md" for the build command and results.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Benchmark first created.
+		2026-10-17 - Drew Sloan - Added the failed batch check.
+		2026-10-17 - Drew Sloan - Added the failed unbatched write check.
+		2026-10-17 - Drew Sloan - The failed batch check no longer restages.
+*/
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <Vulintus_DigiPot.h>
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define N_POTS          4               // Stand-in devices.
+#define PIN_CS_FIRST    10              // Chip select pin of the first device.
+#define FD_FIRST        100             // Stand-in file descriptor of the first device.
+#define N_COMMANDS      200000          // Commands per test.
+#define BATCH_OPS       16              // Operations per device in each batch.
+
+
+// STAND-IN DEVICE ***************************************************************************************************//
+
+struct Standin_MCP42xx {
+    uint16_t reg[16];                   // Register values.
+    uint8_t state;                      // 0 = expecting a command byte, 1 = expecting a data byte.
+    uint8_t hi_byte;                    // Command byte of the command in progress.
+    bool failing;                       // True to fail every message (EIO).
+};
+
+static Standin_MCP42xx standin[N_POTS];
+
+
+// Exchange one byte with a stand-in device.
+static uint8_t standin_byte(Standin_MCP42xx *dev, uint8_t data)
+{
+    if (dev->state == 1) {                      // Data byte of a write or read.
+        dev->state = 0;
+        uint8_t reg = dev->hi_byte >> 4;
+        if (((dev->hi_byte >> 2) & 0x03) == 0) {    // Write.
+            dev->reg[reg] = ((dev->hi_byte & 0x03) << 8) | data;
+            return 0xFF;
+        }
+        return dev->reg[reg] & 0xFF;            // Read (low byte).
+    }
+    uint8_t reg = data >> 4;                    // Command byte.
+    uint8_t cmd = (data >> 2) & 0x03;
+    if ((cmd == 0) || (cmd == 3)) {             // Write or read: a data byte follows.
+        dev->state = 1;
+        dev->hi_byte = data;
+        return 0xFE | ((dev->reg[reg] >> 8) & 0x01);
+    }
+    dev->reg[reg] += (cmd == 1) ? 1 : -1;       // Increment or decrement.
+    return 0xFF;
+}
+
+
+// Stand-in for ioctl on the spidev devices.
+static int standin_ioctl(int fd, unsigned long request, void *arg)
+{
+    syscall(SYS_getppid);                       // Pay for one real kernel entry.
+    if ((fd < FD_FIRST) || (fd >= (FD_FIRST + N_POTS))) {
+        errno = EBADF;
+        return -1;
+    }
+    Standin_MCP42xx *dev = &standin[fd - FD_FIRST];
+    if (request == SPI_IOC_WR_MODE) {
+        return 0;
+    }
+    if ((_IOC_TYPE(request) != SPI_IOC_MAGIC) || (_IOC_NR(request) != 0)) {
+        errno = ENOTTY;
+        return -1;
+    }
+    if (dev->failing) {
+        errno = EIO;
+        return -1;
+    }
+    uint32_t n = _IOC_SIZE(request) / sizeof(struct spi_ioc_transfer);
+    struct spi_ioc_transfer *xfers = (struct spi_ioc_transfer *) arg;
+    int total = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        const uint8_t *tx = (const uint8_t *) (uintptr_t) xfers[i].tx_buf;
+        uint8_t *rx = (uint8_t *) (uintptr_t) xfers[i].rx_buf;
+        for (uint32_t j = 0; j < xfers[i].len; j++) {
+            rx[j] = standin_byte(dev, tx[j]);
+        }
+        total += xfers[i].len;
+        if (xfers[i].cs_change && (i < (n - 1))) {  // Chip select toggles: a new command stream starts.
+            dev->state = 0;
+        }
+    }
+    if (!xfers[n - 1].cs_change) {              // Chip select is released at the end of the message.
+        dev->state = 0;
+    }
+    return total;
+}
+
+
+// BENCHMARK *********************************************************************************************************//
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+
+static void report(const char *name, uint32_t n_commands, double t)
+{
+    printf("%-34s %8.3f ioctls/command %10.0f commands/s\n", name, 
+        (double) SPI.stats.ioctls / n_commands, n_commands / t);
+}
+
+
+int main(void)
+{
+    Vulintus_MCP4251 *pots[N_POTS];
+    SPI.set_ioctl(standin_ioctl);
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        SPI.attach(PIN_CS_FIRST + i, FD_FIRST + i);
+        pots[i] = new Vulintus_MCP4251(PIN_CS_FIRST + i);
+        pots[i]->begin();
+        pots[i]->set_clock(DIGIPOT_SPI_MAX_HZ);
+    }
+
+    // Byte-at-a-time commands, as a plain sketch would send them.
+    SPI.reset_stats();
+    double t0 = now_s();
+    for (uint32_t i = 0; i < N_COMMANDS; i++) {
+        uint8_t pin = PIN_CS_FIRST + (i % N_POTS);
+        SPI.beginTransaction(SPISettings(DIGIPOT_SPI_MAX_HZ, MSBFIRST, SPI_MODE0));
+        digitalWrite(pin, LOW);
+        SPI.transfer((uint8_t) 0x00);           // Write Wiper 0...
+        SPI.transfer((uint8_t) (i & 0xFF));     // ...with the data byte.
+        digitalWrite(pin, HIGH);
+        SPI.endTransaction();
+    }
+    report("SPI.transfer, byte at a time", N_COMMANDS, now_s() - t0);
+
+    // Driver writes, one operation per system call.
+    SPI.reset_stats();
+    t0 = now_s();
+    for (uint32_t i = 0; i < N_COMMANDS; i++) {
+        pots[i % N_POTS]->set_code((i / N_POTS) & 0xFF, 0);
+    }
+    report("set_code", N_COMMANDS, now_s() - t0);
+
+    // Driver writes, batched per device.
+    SPI.reset_stats();
+    t0 = now_s();
+    for (uint32_t i = 0; i < N_COMMANDS; ) {
+        SPI.begin_batch();
+        for (uint8_t j = 0; (j < (BATCH_OPS * N_POTS)) && (i < N_COMMANDS); j++, i++) {
+            pots[i % N_POTS]->set_code((i / N_POTS) & 0xFF, 0);
+        }
+        SPI.end_batch();
+    }
+    report("set_code, batched", N_COMMANDS, now_s() - t0);
+
+    for (uint8_t i = 0; i < N_POTS; i++) {      // Check that every command landed.
+        uint16_t want = ((N_COMMANDS - N_POTS + i) / N_POTS) & 0xFF;
+        if ((standin[i].reg[0] != want) || (pots[i]->get_code(0, true) != want)) {
+            printf("Device %u: wiper %u, expected %u\n", i, standin[i].reg[0], want);
+            return 1;
+        }
+    }
+
+    // A failed batch clears the members' caches and keeps their targets staged.
+    Vulintus_DigiPotGroup group;
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        group.add(pots[i]);
+    }
+    group.set_staged(true);
+    standin[1].failing = true;                  // The second device's messages fail.
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        pots[i]->set_code(200 + i, 0);
+    }
+    uint8_t n_failed = group.flush_batch(&SPI);
+    bool ok = (n_failed == N_POTS) && (standin[0].reg[0] == 200) && (standin[1].reg[0] != 201);
+    standin[1].failing = false;
+    ok &= (group.flush_batch(&SPI) == 0);       // The targets were kept staged.
+    for (uint8_t i = 0; i < N_POTS; i++) {
+        ok &= (standin[i].reg[0] == (uint16_t) (200 + i));
+    }
+    printf("%-34s %s\n", "failed batch, then resent", ok ? "ok" : "FAILED");
+
+    // A failed unbatched write is reported and clears the cache too.
+    group.set_staged(false);
+    standin[1].failing = true;
+    bool ok_single = (pots[1]->set_code(50, 0) == DIGIPOT_CODE_INVALID) && (pots[1]->status() == DIGIPOT_ERR_BUS);
+    standin[1].failing = false;
+    ok_single &= (pots[1]->set_code(50, 0) == 50) && (standin[1].reg[0] == 50);
+    printf("%-34s %s\n", "failed write, then resent", ok_single ? "ok" : "FAILED");
+    return (ok && ok_single) ? 0 : 1;
+}
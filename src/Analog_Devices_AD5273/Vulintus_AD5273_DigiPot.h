@@ -28,6 +28,16 @@
         2024-07-17 - Drew Sloan - Converted to a base MCP4xxx class with 
                                   inheriting classs for the 128 and 256 step 
                                   variants.
+        2026-10-17 - Drew Sloan - Moved the scaled/resistance functions to the 
+                                  base class and added wiper cache updates.
+        2026-10-17 - Drew Sloan - Switched to the shared bus transport.
+        2026-10-17 - Drew Sloan - Added asynchronous (queued) writes and reads.
+        2026-10-17 - Drew Sloan - Part constants now come from the flash 
+                                  descriptor table.
+        2026-10-17 - Drew Sloan - The I2C clock is now set per device (up to 
+                                  400 kHz).
+        2026-10-17 - Drew Sloan - Reads count as a single wait in 
+                                  "worst_case_us" (no command byte).
 
 */
 
@@ -59,33 +69,26 @@ class Vulintus_AD5273_DigiPot : public Vulintus_DigiPot {
         Vulintus_AD5273_DigiPot(AD5273_I2C_addr addr = AD5273I2C_ADDR_L, \
                 TwoWire *i2c_bus = &Wire);
 
-        // Public variables matching "Vulintus_DigiPot" base class. //
-        float wiper_resistance = 60;            // Wiper resistance, in ohms.
-        float max_resistance = 10000;           // Maximum resistance (not counting wiper), in ohms.
-        uint16_t n_resistors = 63;     	        // Number of resistors in the ladder network.  
-
         // Public functions matching "Vulintus_DigiPot" base class. //
-        uint8_t begin(void); 		            // Initialization.          
-
-		float set_scaled(float float_scaled);			        // Write the Wiper 0 value, scaled 0-1.
-		float set_scaled(float float_scaled, uint8_t wiper_i);  // Write the specified wiper value, scaled 0-1.
-		float get_scaled(void);                                 // Read the Wiper 0 value, scaled 0-1.
-        float get_scaled(uint8_t wiper_i);         		        // Read the specified wiper value, scaled 0-1.
-
-        float set_resistance(float float_ohms);					    // Write the Wiper 0 value, in real resistance (ohms).
-		float set_resistance(float float_ohms, uint8_t wiper_i);    // Write the specified wiper value, in real resistance (ohms).
-		float get_resistance(void);                        		    // Read the Wiper 0 value, in real resistance (ohms).
-        float get_resistance(uint8_t wiper_i);         			    // Read the specified wiper value, in real resistance (ohms).
+        uint8_t begin(void); 		        // Initialization.          
+        void *bus_handle(void);             // Bus interface pointer.
+        uint8_t bus_address(void);          // I2C address.
 
         // Public Functions. //
         uint8_t read(void);                     //Read the wiper value.
         uint8_t write(uint8_t value);           //Write the wiper value.
 
+    protected:
+
+        // Protected functions matching "Vulintus_DigiPot" base class. //
+        uint8_t bus_write(uint16_t code, uint8_t wiper_i);     // Write the wiper value to the chip.
+        uint16_t bus_read(uint8_t wiper_i);                     // Read the wiper value from the chip.
+        uint32_t bus_worst_case_us(DigiPot_op op);              // Longest one write or read can take (0 if unbounded).
+
     private:
 
         // Private Constants. //
         static const uint8_t AD5273_CMD = 0x00;             // Command code for read and write operations.
-        static const uint32_t AD5273_I2C_CLKRATE = 400000;  // Clock frequency for I2C communication.         
 
         // Private Variables. //
         TwoWire *_i2c_bus;              // I2C interface pointer.
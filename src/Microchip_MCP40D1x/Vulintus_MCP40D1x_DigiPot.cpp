@@ -18,123 +18,71 @@
 Vulintus_MCP40D1x_DigiPot::Vulintus_MCP40D1x_DigiPot(uint8_t addr, TwoWire *i2c_bus)
     : _i2c_addr(addr)
 {
-    _i2c_bus = &Wire;       // Set the I2C bus to the default.
+    _i2c_bus = i2c_bus;         // Set the I2C bus to the specified bus.
+    load_part(DIGIPOT_PART_MCP40D18);   // Load the part constants from flash (the same for every variant).
 }
 
 
-// Initialization.
-uint8_t Vulintus_MCP40D1x_DigiPot::begin(void)
+// Class constructor (specific part).
+Vulintus_MCP40D1x_DigiPot::Vulintus_MCP40D1x_DigiPot(DigiPot_part part, uint8_t addr, TwoWire *i2c_bus)
+    : _i2c_addr(addr)
 {
-    uint8_t error = 0;                          // Assume no connection error.
-    _i2c_bus->begin();                          // Initialize the I2C bus.
-    _i2c_bus->beginTransmission(_i2c_addr);     // Start an I2C transmission to the chip.
-    error = _i2c_bus->endTransmission();        // Check for an ACK from the chip.
-    return error;                               // Return the error value.
+    _i2c_bus = i2c_bus;         // Set the I2C bus to the specified bus.
+    load_part(part);            // Load the part constants from flash.
 }
 
 
-// Write the Wiper 0 value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP40D1x_DigiPot::set_scaled(float float_scaled)
+// Initialization.
+uint8_t Vulintus_MCP40D1x_DigiPot::begin(void)
 {
-    float_scaled *= (float) n_resistors;    // Calculate the fractional number of steps.
-    uint16_t uint_val = float_scaled;       // Convert the float to a uint16.
-    write(uint_val);                        // Write the value to the specified wiper.
-    float_scaled = get_scaled();            // Read the actual scaled value.
-    return float_scaled;                    // Return the actual scaled value.
+    _bus = Vulintus_DigiPot_Bus::get(_i2c_bus);     // Attach to the shared transport for this bus.
+    if (!bus_ready()) {                             // If no transport is available...
+        return _status;                             // Return the error.
+    }
+    _bus->begin();                                  // Initialize the I2C bus (once per bus).
+    _status = _bus->i2c_probe(_i2c_addr, _clock);                   // Check for an ACK from the chip.
+    if (_status == DIGIPOT_OK) {                    // If the chip responded...
+        fill_cache();                               // Load the current wiper value into the cache.
+    }
+    return _status;                                 // Return the status.
 }
 
 
-// Write the specified wiper value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP40D1x_DigiPot::set_scaled(float float_val, uint8_t wiper_i)
+// Bus interface pointer (Vulintus_DigiPot base class function).
+void *Vulintus_MCP40D1x_DigiPot::bus_handle(void)
 {
-    float_val = set_scaled(float_val);     // Write the value, ignoring the wiper index.
-    return float_val;                      // Return the actual scaled value.
+    return (void *) _i2c_bus;           // Return the I2C bus.
 }
 
 
-// Read the Wiper 0 value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP40D1x_DigiPot::get_scaled(void)
-{
-    float float_val = read();                           // Read the wiper value, ignoring the wiper index.
-    float_val /= (float) n_resistors;                   // Convert the step setting to fractional 0-1.
-    float_val *= max_resistance;                        // Convert the scaled value to resistance (ohms).
-    float_val += wiper_resistance;                      // Add the wiper resistance.
-    float_val /= (wiper_resistance + max_resistance);   // Divide by the wiper resistance and max resistance to get the actual scaled value.
-    return float_val;                                   // Read the scaled value.
-}                        
-
-
-// Read the specified wiper value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP40D1x_DigiPot::get_scaled(uint8_t wiper_i)
+// I2C address (Vulintus_DigiPot base class function).
+uint8_t Vulintus_MCP40D1x_DigiPot::bus_address(void)
 {
-    float float_val = get_scaled();         // Read the scaled value, ignoring the wiper index.
-    return float_val;                       // Return the scaled float value.
-}      		    
-
-
-// Write the Wiper 0 value, in real resistance (ohms).
-float Vulintus_MCP40D1x_DigiPot::set_resistance(float float_val)
-{
-    float_val = set_resistance(float_val, (uint8_t) 0);     // Set the resistance (ohms) on wiper 0.
-    return float_val;                                       // Return the float value.
-}					
-
-
-// Write the specified wiper value, in real resistance (ohms).
-float Vulintus_MCP40D1x_DigiPot::set_resistance(float float_val, uint8_t wiper_i)
-{
-    if (float_val > wiper_resistance) {             // If the specified resistance is greater than the wiper resistance...
-        float_val -= wiper_resistance;              // Subtract the wiper resistance.
-        float_val /= max_resistance;                // Convert the resistance value to scaled, 0-1.
-    }
-    else {                                          // Otherwise, if the specified resistance is less than the wiper resistance...
-        float_val = 0;                              // Set the scaled value to zero.
-    }    
-    float_val = set_scaled(float_val, wiper_i);     // Set the scaled setting.
-    float_val *= max_resistance;                    // Convert the scaled value to resistance (ohms).
-    float_val += wiper_resistance;                  // Add the wiper resistance.
-    return float_val;                               // Return the float value.
-}	
-
-
-// Read the Wiper 0 value, in real resistance (ohms).
-float Vulintus_MCP40D1x_DigiPot::get_resistance(void)
-{
-    float float_val = get_resistance((uint8_t) 0);      // Fetch the resistance from wiper 0.
-}    			
-
-
-// Read the specified wiper value, in real resistance (ohms).
-float Vulintus_MCP40D1x_DigiPot::get_resistance(uint8_t wiper_i)
-{
-    float float_val = get_scaled(wiper_i);              // Read the scaled value of the wiper, 0-1.
-    float_val *= (wiper_resistance + max_resistance);   // Multiply by the wiper resistance and max resistance to get the actual resistance value.
-    return float_val;                                   // Return the float value.
-}		
+    return _i2c_addr;                   // Return the I2C address.
+}
 
 
 //Read the wiper value.
 uint8_t Vulintus_MCP40D1x_DigiPot::read(void)
 {
-    uint8_t reply;                              // Reply and success/error code.
-
-    _i2c_bus->setClock(MCP40D1X_I2C_CLKRATE);   // Set the I2C clockrate.
-    _i2c_bus->beginTransmission(_i2c_addr);     // Start I2C transmission.
-    _i2c_bus->write(MCP40D1X_CMD);              // Send the read/write command code (0).    
-    reply = _i2c_bus->endTransmission(); 	    // End the transmission.
+    uint8_t cmd = MCP40D1X_CMD;                 // Read/write command code (0).
+    uint8_t reply;                              // Returned wiper value.
 
-    if (reply) {                                // If an error occured.
+    if (async()) {                              // If asynchronous mode is on...
+        enqueue(DIGIPOT_OP_READ, 0, 0);         // Queue the read (the value arrives in the callback).
         return 0xFF;                            // Return a value of 255.
     }
-
-    reply = _i2c_bus->requestFrom(_i2c_addr,(uint8_t) 1);  // Request one byte.
-    if (reply) {                                // If at least one byte was returned...
-        reply = _i2c_bus->read();               // Read the returned byte.
+    if (!bus_ready()) {                         // If there's no transport...
+        return 0xFF;                            // Return a value of 255.
     }
-    else {                                      // If no bytes were returned...
-        reply = 0xFF;                           // Return a value of 255.
+    _status = _bus->i2c_write_read(_i2c_addr, &cmd, 1, &reply, 1, _clock);                 // Send the command, then read after a repeated start.
+    if (_status != DIGIPOT_OK) {                // If an error occured...
+        return 0xFF;                            // Return a value of 255.
     }
 
+    if (reply <= n_resistors) {                 // If the value is in range...
+        cache_store(0, reply);                  // Update the wiper cache.
+    }
     return reply;                               // Return the reply.
 }                         
    
@@ -143,13 +91,33 @@ uint8_t Vulintus_MCP40D1x_DigiPot::read(void)
 //Write the wiper value.
 uint8_t Vulintus_MCP40D1x_DigiPot::write(uint8_t value)
 {
-    uint8_t nack;                               // NACK success/error code.
+    uint8_t tx[2] = {MCP40D1X_CMD, value};      // Read/write command code (0) and wiper value.
 
-    _i2c_bus->setClock(MCP40D1X_I2C_CLKRATE);   // Set the I2C clockrate.
-    _i2c_bus->beginTransmission(_i2c_addr);     // Start I2C transmission.
-    _i2c_bus->write(MCP40D1X_CMD);              // Send the read/write command code (0).    
-    _i2c_bus->write(value);                     // Write the wiper value.
-    nack = _i2c_bus->endTransmission(); 	    // End the transmission.
+    if (async()) {                              // If asynchronous mode is on...
+        return enqueue(DIGIPOT_OP_WRITE, value, 0);     // Queue the write.
+    }
+    if (!bus_ready()) {                         // If there's no transport...
+        return _status;                         // Return the error.
+    }
+    _status = _bus->i2c_write(_i2c_addr, tx, 2, _clock);                   // Send the command and value.
 
-    return nack;                                // Return the reply.
-}     
\ No newline at end of file
+    if (_status == DIGIPOT_OK) {                // If the write succeeded...
+        cache_store(0, (value <= n_resistors) ? value : n_resistors);  // Update the wiper cache.
+    }
+    return _status;                             // Return the status.
+}
+
+
+// Write the wiper value to the chip (Vulintus_DigiPot base class function).
+uint8_t Vulintus_MCP40D1x_DigiPot::bus_write(uint16_t code, uint8_t /* wiper_i */)
+{
+    return write(code);                 // Write the value, ignoring the wiper index.
+}
+
+
+// Read the wiper value from the chip (Vulintus_DigiPot base class function).
+uint16_t Vulintus_MCP40D1x_DigiPot::bus_read(uint8_t /* wiper_i */)
+{
+    uint8_t value = read();             // Read the value, ignoring the wiper index.
+    return (_status == DIGIPOT_OK) ? value : DIGIPOT_CODE_INVALID;     // Return the value, or the error value.
+}
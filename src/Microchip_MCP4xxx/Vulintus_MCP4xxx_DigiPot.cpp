@@ -14,119 +14,169 @@
 
 // CLASS FUNCTIONS ***********************************************************// 
 
-// Class constructor (SPI with chip select).
-Vulintus_MCP4xxx_DigiPot::Vulintus_MCP4xxx_DigiPot(uint16_t num_resistors, uint8_t pin_cs, SPIClass *spi_bus)
-    : _pin_cs(pin_cs)
+// Frame constructor.
+Vulintus_MCP4xxx_Frame::Vulintus_MCP4xxx_Frame(void)
 {
-    _spi_bus = &SPI;                    // Set the SPI bus to the default bus.    
+    clear();                            // Start with an empty frame.
 }
 
 
-// Class constructor (I2C with address).
-Vulintus_MCP4xxx_DigiPot::Vulintus_MCP4xxx_DigiPot(uint16_t num_resistors, uint8_t i2c_addr, TwoWire *i2c_bus)
-    : _i2c_addr(i2c_addr)
+// Remove all queued commands.
+void Vulintus_MCP4xxx_Frame::clear(void)
 {
-    _i2c_bus = i2c_bus;                 // Set the I2C bus to the specified bus.
-    n_resistors = num_resistors;        // Set the number of resistors.
+    n_cmds = 0;                         // Reset the command count.
+    _cmd_errors = 0;                    // Clear the command error flags.
 }
 
 
-// Initialization.
-uint8_t Vulintus_MCP4xxx_DigiPot::begin(void)
+// Queue a write command (returns the command index, or -1 if full).
+int8_t Vulintus_MCP4xxx_Frame::write(MCP4xxx_reg reg, uint16_t value)
+{
+    return add(reg | MCP4XXX_CMD_WRITE | ((value >> 8) & 0x01), value);
+}
+
+
+// Queue an increment command.
+int8_t Vulintus_MCP4xxx_Frame::increment(MCP4xxx_reg reg)
+{
+    return add(reg | MCP4XXX_CMD_INCR, 0);
+}
+
+
+// Queue a decrement command.
+int8_t Vulintus_MCP4xxx_Frame::decrement(MCP4xxx_reg reg)
+{
+    return add(reg | MCP4XXX_CMD_DECR, 0);
+}
+
+
+// Queue a read command.
+int8_t Vulintus_MCP4xxx_Frame::read(MCP4xxx_reg reg)
+{
+    return add(reg | MCP4XXX_CMD_READ | 0x01, 0xFF);
+}
+
+
+// Fetch the data returned for a queued command.
+uint16_t Vulintus_MCP4xxx_Frame::reply(uint8_t cmd_i)
 {
-    uint8_t error = 0;                          // Assume no connection error.
-    if (_spi_bus == NULL) {                     // I2C mode (SPI pointer is NULL).
-        _i2c_bus->begin();                      // Initialize the I2C bus.
-        _i2c_bus->beginTransmission(_i2c_addr); // Start an I2C transmission to the chip.
-        error = _i2c_bus->endTransmission();    // Check for an ACK from the chip.
+    if (cmd_i >= n_cmds) {              // If the index is out of range...
+        return 0xFFFF;                  // Return a value of 65535.
     }
-    else {                                      // SPI mode.
-        _spi_bus->begin();                      // Initialize the SPI bus.
-        pinMode(_pin_cs, OUTPUT);               // Set the CS pin mode to output.
-        digitalWrite(_pin_cs, HIGH);            // Set the CS pin high.
-    }    
-    return error;                               // Return the error value.
+    return _reply[cmd_i];               // Return the reply.
 }
 
 
-// Write the Wiper 0 value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP4xxx_DigiPot::set_scaled(float float_scaled)
+// Check if the chip flagged a command error (SPI only; I2C errors are NACKed).
+bool Vulintus_MCP4xxx_Frame::cmd_error(uint8_t cmd_i)
 {
-    float_scaled = set_scaled(float_scaled, (uint8_t) 0);   // Write the value to wiper 0.
-    return float_scaled;                                   // Return the actual scaled value.
+    if (cmd_i >= n_cmds) {              // If the index is out of range...
+        return false;                   // There's no error to report.
+    }
+    return (_cmd_errors >> cmd_i) & 0x01;   // Return the flag.
 }
 
 
-// Write the specified wiper value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP4xxx_DigiPot::set_scaled(float float_scaled, uint8_t wiper_i)
-{    
-    float_scaled *= (float) n_resistors;   // Calculate the fractional number of steps.
-    uint16_t uint_val = float_scaled;       // Convert the float to a uint16.
-    write(uint_val, wiper_i);               // Write the value to the specified wiper.
-    float_scaled = get_scaled(wiper_i);     // Read the actual scaled value.
-    return float_scaled;                    // Return the actual scaled value.
+// Number of bytes in the command stream.
+uint8_t Vulintus_MCP4xxx_Frame::n_bytes(void)
+{
+    uint8_t n = 0;                      // Count the bytes.
+    for (uint8_t i = 0; i < n_cmds; i++) {  // Step through the commands.
+        uint8_t cmd = _hi_byte[i] & 0x0C;   // Grab the command bits.
+        n += ((cmd == MCP4XXX_CMD_WRITE) || (cmd == MCP4XXX_CMD_READ)) ? 2 : 1;    // Writes and reads have a data byte.
+    }
+    return n;                           // Return the count.
 }
 
 
-// Read the Wiper 0 value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP4xxx_DigiPot::get_scaled(void)
+// Add a command to the frame.
+int8_t Vulintus_MCP4xxx_Frame::add(uint8_t hi_byte, uint8_t lo_byte)
 {
-    float float_scaled = get_scaled((uint8_t) 0);   // Read the value from wiper 0.    
-    return float_scaled;                            // Return the float value.
-}                        
+    if (n_cmds >= MCP4XXX_FRAME_MAX_CMDS) {     // If the frame is full...
+        return -1;                              // Return -1 to indicate an error.
+    }
+    _hi_byte[n_cmds] = hi_byte;                 // Save the command byte.
+    _lo_byte[n_cmds] = lo_byte;                 // Save the data byte.
+    _reply[n_cmds] = 0xFFFF;                    // Clear the reply.
+    return n_cmds++;                            // Return the command index.
+}
 
 
-// Read the specified wiper value, scaled 0-1 (Vulintus_DigiPot base class function).
-float Vulintus_MCP4xxx_DigiPot::get_scaled(uint8_t wiper_i)
+
+// Class constructor (SPI with chip select).
+Vulintus_MCP4xxx_DigiPot::Vulintus_MCP4xxx_DigiPot(uint16_t num_resistors, uint8_t pin_cs, SPIClass *spi_bus)
+    : _port(spi_bus), _addr(pin_cs), _cs(pin_cs)
 {
-    float float_scaled = read((uint8_t) wiper_i);           // Read the value from the specified wiper.    
-    float_scaled /= (float) n_resistors;                    // Convert the step setting to fractional 0-1.
-    float_scaled *= max_resistance;                         // Convert the scaled value to resistance (ohms).
-    float_scaled += wiper_resistance;                       // Add the wiper resistance.
-    float_scaled /= (wiper_resistance + max_resistance);    // Divide by the wiper resistance and max resistance to get the actual scaled value.
-    return float_scaled;                                    // Read the value from wiper 0.
-}      		    
+    load_part((num_resistors > 128) ? DIGIPOT_PART_MCP4XXX_SPI_256 : DIGIPOT_PART_MCP4XXX_SPI_128);     // Load the generic (dual-wiper) part.
+    n_resistors = num_resistors;        // Set the number of resistors.
+}
 
 
-// Write the Wiper 0 value, in real resistance (ohms).
-float Vulintus_MCP4xxx_DigiPot::set_resistance(float float_ohms)
+// Class constructor (I2C with address).
+Vulintus_MCP4xxx_DigiPot::Vulintus_MCP4xxx_DigiPot(uint16_t num_resistors, uint8_t i2c_addr, TwoWire *i2c_bus)
+    : _port(i2c_bus), _addr(i2c_addr)
 {
-    float_ohms = set_resistance(float_ohms, (uint8_t) 0);   // Set the resistance (ohms) on wiper 0.
-    return float_ohms;                                      // Return the float value.
-}					
+    load_part((num_resistors > 128) ? DIGIPOT_PART_MCP4XXX_I2C_256 : DIGIPOT_PART_MCP4XXX_I2C_128);     // Load the generic (dual-wiper) part.
+    n_resistors = num_resistors;        // Set the number of resistors.
+}
 
 
-// Write the specified wiper value, in real resistance (ohms).
-float Vulintus_MCP4xxx_DigiPot::set_resistance(float float_ohms, uint8_t wiper_i)
+// Class constructor (specific SPI part, with chip select).
+Vulintus_MCP4xxx_DigiPot::Vulintus_MCP4xxx_DigiPot(DigiPot_part part, uint8_t pin_cs, SPIClass *spi_bus)
+    : _port(spi_bus), _addr(pin_cs), _cs(pin_cs)
 {
-    if (float_ohms > wiper_resistance) {             // If the specified resistance is greater than the wiper resistance...
-        float_ohms -= wiper_resistance;              // Subtract the wiper resistance.
-        float_ohms /= max_resistance;                // Convert the resistance value to scaled, 0-1.
+    load_part(part);                    // Load the part constants from flash.
+}
+
+
+// Class constructor (specific I2C part, with address).
+Vulintus_MCP4xxx_DigiPot::Vulintus_MCP4xxx_DigiPot(DigiPot_part part, uint8_t i2c_addr, TwoWire *i2c_bus)
+    : _port(i2c_bus), _addr(i2c_addr)
+{
+    load_part(part);                    // Load the part constants from flash.
+}
+
+
+// Initialization.
+uint8_t Vulintus_MCP4xxx_DigiPot::begin(void)
+{
+    if (!spi_mode()) {                          // I2C mode.
+        _bus = Vulintus_DigiPot_Bus::get((TwoWire *) _port);     // Attach to the shared transport for this bus.
+    }
+    else {                                      // SPI mode.
+        _bus = Vulintus_DigiPot_Bus::get((SPIClass *) _port);    // Attach to the shared transport for this bus.
+    }
+    if (!bus_ready()) {                         // If no transport is available...
+        return _status;                         // Return the error.
+    }
+    _bus->begin();                              // Initialize the bus (once per bus).
+    if (!spi_mode()) {                          // I2C mode.
+        _status = _bus->i2c_probe(_addr, _clock);                    // Check for an ACK from the chip.
     }
-    else {                                          // Otherwise, if the specified resistance is less than the wiper resistance...
-        float_ohms = 0;                             // Set the scaled value to zero.
+    else {                                      // SPI mode.
+        _bus->spi_cs_init(_cs);                 // Set the CS pin to an output, high, and resolve its port.
+        _status = DIGIPOT_OK;                   // SPI has no acknowledge, so always succeed.
     }    
-    float_ohms = set_scaled(float_ohms, wiper_i);   // Set the scaled setting.
-    float_ohms *= max_resistance;                   // Convert the scaled value to resistance (ohms).
-    float_ohms += wiper_resistance;                 // Add the wiper resistance.
-    return float_ohms;                              // Return the float value.
-}	
+    if (_status == DIGIPOT_OK) {                // If the chip responded...
+        fill_cache();                           // Load the current wiper values into the cache.
+        _status = DIGIPOT_OK;                   // Single-wiper parts NACK the wiper 1 read, which isn't a failure.
+    }
+    return _status;                             // Return the status.
+}
 
 
-// Read the Wiper 0 value, in real resistance (ohms).
-float Vulintus_MCP4xxx_DigiPot::get_resistance(void)
+// Bus interface pointer (Vulintus_DigiPot base class function).
+void *Vulintus_MCP4xxx_DigiPot::bus_handle(void)
 {
-    float float_ohms = get_resistance((uint8_t) 0);     // Fetch the resistance from wiper 0.
-}    			
+    return _port;                       // Return the SPI or I2C bus.
+}
 
 
-// Read the specified wiper value, in real resistance (ohms).
-float Vulintus_MCP4xxx_DigiPot::get_resistance(uint8_t wiper_i)
+// I2C address or SPI chip select pin (Vulintus_DigiPot base class function).
+uint8_t Vulintus_MCP4xxx_DigiPot::bus_address(void)
 {
-    float float_ohms = get_scaled(wiper_i);             // Read the scaled value of the wiper, 0-1.
-    float_ohms *= (max_resistance + wiper_resistance);  // Convert the scaled value to resistance (ohms).
-    return float_ohms;                                  // Return the float value.
-}		
+    return _addr;                       // Return the I2C address or chip select pin.
+}
 
 
 // Read the Wiper 0 value.
@@ -139,31 +189,60 @@ uint16_t Vulintus_MCP4xxx_DigiPot::read(void)
 // Read the specified wiper value.
 uint16_t Vulintus_MCP4xxx_DigiPot::read(uint8_t wiper_i)
 {
+    uint16_t value;
+    if (!wiper_valid(wiper_i)) {        // If the chip doesn't have this wiper...
+        return 0xFFFF;                  // Return a value of 65535.
+    }
+    if (async()) {                      // If asynchronous mode is on...
+        enqueue(DIGIPOT_OP_READ, 0, wiper_i);   // Queue the read (the value arrives in the callback).
+        return 0xFFFF;                  // Return a value of 65535.
+    }
     if (!wiper_i) {
-        return send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_READ, (uint16_t) 0x01FF);
+        _status = send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_READ, (uint16_t) 0x01FF, &value);
     }
     else {
-        return send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_READ, (uint16_t) 0x01FF);
+        _status = send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_READ, (uint16_t) 0x01FF, &value);
     }
+    if (_status != DIGIPOT_OK) {        // If an error occured...
+        return 0xFFFF;                  // Return a value of 65535.
+    }
+    if (value <= n_resistors) {         // If the value is in range...
+        cache_store(wiper_i, value);    // Update the wiper cache.
+    }
+    return value;                       // Return the wiper value.
 }          
 
 
 // Write the Wiper 0 value.
-void Vulintus_MCP4xxx_DigiPot::write(uint16_t value)
+uint8_t Vulintus_MCP4xxx_DigiPot::write(uint16_t value)
 {
-    write(value, (uint8_t) 0);          // Write the value to wiper 0.
+    return write(value, (uint8_t) 0);   // Write the value to wiper 0.
 }     
 
 
 // Write the specified wiper value.
-void Vulintus_MCP4xxx_DigiPot::write(uint16_t value, uint8_t wiper_i)
+uint8_t Vulintus_MCP4xxx_DigiPot::write(uint16_t value, uint8_t wiper_i)
 {
+    uint16_t reply;
+    if (!wiper_valid(wiper_i)) {        // If the chip doesn't have this wiper...
+        return _status;                 // Return the error.
+    }
+    if (async()) {                      // If asynchronous mode is on...
+        return enqueue(DIGIPOT_OP_WRITE, value, wiper_i);   // Queue the write.
+    }
     if (!wiper_i) {
-        send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_WRITE, value);
+        _status = send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_WRITE, value, &reply);
     }
     else {
-        send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_WRITE, value);
+        _status = send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_WRITE, value, &reply);
+    }
+    if (_status == DIGIPOT_OK) {        // If the write succeeded...
+        cache_store(wiper_i, (value <= n_resistors) ? value : n_resistors);     // Update the wiper cache.
     }
+    else {                              // Otherwise...
+        clear_cache();                  // The wiper values are no longer known.
+    }
+    return _status;                     // Return the status.
 }   
 
 
@@ -177,12 +256,24 @@ void Vulintus_MCP4xxx_DigiPot::increment()
 // Increment the specified wiper.
 void Vulintus_MCP4xxx_DigiPot::increment(uint8_t wiper_i)
 {
+    if (!wiper_valid(wiper_i)) {        // If the chip doesn't have this wiper...
+        return;                         // Skip the command.
+    }
+    if (async() || staged()) {          // If writes are queued or staged...
+        step_write(wiper_i, 1);         // Send the step as an absolute write, in order with the other writes.
+        return;
+    }
     if (!wiper_i) {
-        send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_INCR);
+        _status = send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_INCR);
     }
     else {
-        send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_INCR);
+        _status = send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_INCR);
     }
+    if (_status != DIGIPOT_OK) {        // If the command failed...
+        clear_cache();                  // The wiper values are no longer known.
+        return;
+    }
+    cache_step(wiper_i, 1);             // Step the cached wiper value.
 }            
 
 
@@ -196,78 +287,326 @@ void Vulintus_MCP4xxx_DigiPot::decrement()
 // Decrement the specified wiper.
 void Vulintus_MCP4xxx_DigiPot::decrement(uint8_t wiper_i)
 {
+    if (!wiper_valid(wiper_i)) {        // If the chip doesn't have this wiper...
+        return;                         // Skip the command.
+    }
+    if (async() || staged()) {          // If writes are queued or staged...
+        step_write(wiper_i, -1);        // Send the step as an absolute write, in order with the other writes.
+        return;
+    }
     if (!wiper_i) {
-        send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_DECR);
+        _status = send_cmd(MCP4XXX_REG_WIPER0, MCP4XXX_CMD_DECR);
     }
     else {
-        send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_DECR);
+        _status = send_cmd(MCP4XXX_REG_WIPER1, MCP4XXX_CMD_DECR);
+    }
+    if (_status != DIGIPOT_OK) {        // If the command failed...
+        clear_cache();                  // The wiper values are no longer known.
+        return;
     }
+    cache_step(wiper_i, -1);            // Step the cached wiper value.
 }           
 
 
-// Send a command with data.
-uint16_t Vulintus_MCP4xxx_DigiPot::send_cmd(uint8_t addr, uint8_t cmd, uint16_t data)
+// Step a wiper with an absolute write (asynchronous and staged modes).
+void Vulintus_MCP4xxx_DigiPot::step_write(uint8_t wiper_i, int8_t steps)
 {
-    uint8_t hi_byte = addr | cmd | (data >> 8);     // Combine the address, command and MSB to make the high byte.
-    uint8_t lo_byte = data;                         // Grab the bottom 8 bits from the data for the low byte.
-    uint16_t reply;                                 // Transmission success indicator,
+    uint16_t code;                      // Staged target or cached wiper value.
+    if (!target_lookup(wiper_i, &code)) {   // If the wiper value isn't known...
+        _status = DIGIPOT_ERR_UNKNOWN;  // There's no target to step from (a read would jump the queue).
+        return;
+    }
+    if ((steps < 0) && (code == 0)) {   // The chip saturates at zero scale...
+        return;
+    }
+    set_code(code + steps, wiper_i);    // ...and "set_code" clips at full scale.
+}
 
-    if (_spi_bus == NULL) {                         // I2C mode (SPI pointer is NULL).
-        _i2c_bus->setClock(MCP4XXX_I2C_CLKRATE);    // Set the I2C clockrate.
-        _i2c_bus->beginTransmission(_i2c_addr);     // Start I2C transmission.
-        _i2c_bus->write(hi_byte);                   // Send the high byte.
-        if (cmd == MCP4XXX_CMD_READ) {              // If we're reading the register...
-            reply = _i2c_bus->endTransmission();    // End the transmission.
-            if (reply) {                            // If an error occured.
-                return 0xFFFF;                      // Return a value of 65535.
+
+// Send all commands in a frame as a single transaction.
+uint8_t Vulintus_MCP4xxx_DigiPot::send_frame(Vulintus_MCP4xxx_Frame &frame)
+{
+    uint8_t error = 0;                                  // Assume no error.
+    uint8_t cmd;                                        // Command bits.
+    uint8_t hi_byte, lo_byte;                           // Reply bytes.
+
+    if (!frame.n_cmds) {                                // If the frame is empty...
+        return DIGIPOT_OK;                              // There's nothing to send.
+    }
+    if (!bus_ready()) {                                 // If there's no transport...
+        return _status;                                 // Return the error.
+    }
+
+    if (!spi_mode()) {                                  // I2C mode.
+        uint8_t tx[2 * MCP4XXX_FRAME_MAX_CMDS];         // Command stream.
+        uint8_t rx[2 * MCP4XXX_FRAME_MAX_CMDS];         // Read replies (two bytes per command).
+        DigiPot_i2c_seg segs[MCP4XXX_FRAME_MAX_CMDS];   // Write/read segments (each read ends one).
+        uint8_t n_tx = 0;                               // Number of bytes in the stream.
+        uint8_t n_segs = 0;                             // Number of finished segments.
+        bool idempotent = true;                         // Frames with increments/decrements can't be retried.
+        memset(segs, 0, sizeof(segs));                  // Start with empty segments.
+        segs[0].tx = tx;                                // The first segment starts the stream.
+        for (uint8_t i = 0; i < frame.n_cmds; i++) {    // Step through the commands.
+            cmd = frame._hi_byte[i] & 0x0C;             // Grab the command bits.
+            tx[n_tx++] = frame._hi_byte[i];             // Add the command byte.
+            segs[n_segs].n_tx++;
+            if (cmd == MCP4XXX_CMD_WRITE) {             // If this is a write command...
+                tx[n_tx++] = frame._lo_byte[i];         // Add the data byte.
+                segs[n_segs].n_tx++;
             }
-            reply = _i2c_bus->requestFrom(_i2c_addr, (uint8_t) 2);  // Request two bytes.
-            if (reply < 2) {                        // If two bytes weren't returned...
-                while (_i2c_bus->available()) {     // Loop until the I2C buffer is cleared.
-                    _i2c_bus->read();               // Read and discard each byte.
+            else if (cmd == MCP4XXX_CMD_READ) {         // If this is a read command...
+                segs[n_segs].rx = &rx[2 * i];           // Read the reply after a repeated start.
+                segs[n_segs].n_rx = 2;
+                if (++n_segs < MCP4XXX_FRAME_MAX_CMDS) {    // Start the next segment.
+                    segs[n_segs].tx = &tx[n_tx];
                 }
-                return 0xFFFF;                      // Return a value of 65535.
             }
-            hi_byte = _i2c_bus->read();             // Read the high byte.
-            lo_byte = _i2c_bus->read();             // Read the low byte.
+            else {                                      // Otherwise, for increment/decrement...
+                idempotent = false;                     // A repeated step would move the wiper twice.
+            }
+        }
+        if ((n_segs < MCP4XXX_FRAME_MAX_CMDS) && (segs[n_segs].n_tx > 0)) {    // If the frame ends with writes...
+            n_segs++;                                   // Finish the last segment.
+        }
+        error = _bus->i2c_transfer(_addr, segs, n_segs, _clock, idempotent);    // Send the frame (with the timeout and retry policy).
+        for (uint8_t i = 0; i < frame.n_cmds; i++) {    // Step through the commands.
+            cmd = frame._hi_byte[i] & 0x0C;             // Grab the command bits.
+            frame._reply[i] = (!error && (cmd == MCP4XXX_CMD_READ)) ? (((rx[2 * i] << 8) | rx[2 * i + 1]) & 0x01FF) : 0;  // Save the returned data.
+        }
+    }
+    else {                                              // SPI mode.
+        uint8_t buf[2 * MCP4XXX_FRAME_MAX_CMDS];        // Command stream (replies come back in place).
+        uint8_t n = 0;                                  // Number of bytes in the stream.
+        bool has_read = false;                          // Flag indicating the frame reads a register.
+        for (uint8_t i = 0; i < frame.n_cmds; i++) {    // Step through the commands.
+            cmd = frame._hi_byte[i] & 0x0C;             // Grab the command bits.
+            buf[n++] = frame._hi_byte[i];               // Add the command byte.
+            if ((cmd == MCP4XXX_CMD_WRITE) || (cmd == MCP4XXX_CMD_READ)) {  // If this command has a data byte...
+                buf[n++] = frame._lo_byte[i];           // Add the data byte.
+            }
+            has_read |= (cmd == MCP4XXX_CMD_READ);
+        }
+        _bus->spi_select(_cs, spi_clock(has_read), MSBFIRST, SPI_MODE0);    // Start the transaction with this chip's settings.
+        _bus->spi_transfer(buf, n);                     // Send the whole stream in one block.
+        error = _bus->spi_deselect(_cs);                // End the transaction (some cores only report a failed transfer here).
+        n = 0;                                          // Go back to the start of the replies.
+        frame._cmd_errors = 0;                          // Clear the command error flags.
+        for (uint8_t i = 0; i < frame.n_cmds; i++) {    // Step through the commands.
+            cmd = frame._hi_byte[i] & 0x0C;             // Grab the command bits.
+            hi_byte = buf[n++];                         // Grab the reply to the command byte.
+            if (!(hi_byte & MCP4XXX_SPI_CMDERR)) {      // If the chip pulled CMDERR low...
+                frame._cmd_errors |= (1 << i);          // Flag the command.
+            }
+            if ((cmd == MCP4XXX_CMD_WRITE) || (cmd == MCP4XXX_CMD_READ)) {  // If this command has a data byte...
+                lo_byte = buf[n++];                     // Grab the reply to the data byte.
+                frame._reply[i] = ((hi_byte << 8) | lo_byte) & 0x01FF;     // Save the returned data.
+            }
+            else {                                      // Otherwise, for increment/decrement...
+                frame._reply[i] = hi_byte;              // Save the returned status byte.
+            }
+        }
+    }
+
+    _status = (DigiPot_status) error;                   // Save the status.
+    if (error) {                                        // If the transaction failed...
+        clear_cache();                                  // The wiper values are no longer known.
+        return error;                                   // Return the error code.
+    }
+    bool rejected = false;                              // Flag set from the first command the chip rejected.
+    for (uint8_t i = 0; i < frame.n_cmds; i++) {        // Step through the commands to update the wiper cache.
+        uint8_t reg = frame._hi_byte[i] & 0xF0;         // Grab the register address.
+        rejected |= frame.cmd_error(i);                 // After a CMDERR, the chip ignores the rest of the frame.
+        if ((reg != MCP4XXX_REG_WIPER0) && (reg != MCP4XXX_REG_WIPER1)) {  // Skip non-wiper registers.
+            continue;
+        }
+        uint8_t wiper_i = (reg == MCP4XXX_REG_WIPER1);  // Convert the register to a wiper index.
+        if (rejected) {                                 // If this command was rejected or ignored...
+            cache_forget(1 << wiper_i);                 // The wiper value is no longer known.
+            continue;
+        }
+        uint16_t value = ((frame._hi_byte[i] & 0x01) << 8) | frame._lo_byte[i];   // Rebuild the written value.
+        switch (frame._hi_byte[i] & 0x0C) {
+            case MCP4XXX_CMD_WRITE:
+                cache_store(wiper_i, (value <= n_resistors) ? value : n_resistors);
+                break;
+            case MCP4XXX_CMD_INCR:
+                cache_step(wiper_i, 1);
+                break;
+            case MCP4XXX_CMD_DECR:
+                cache_step(wiper_i, -1);
+                break;
+            case MCP4XXX_CMD_READ:
+                if (frame._reply[i] <= n_resistors) {
+                    cache_store(wiper_i, frame._reply[i]);
+                }
+                break;
+        }
+    }
+    if (rejected) {                                     // If the chip rejected a command...
+        _status = DIGIPOT_ERR_BUS;                      // Report an "other" error.
+    }
+    return _status;                                     // Return the status.
+}
+
+
+// Move a wiper with streamed increments/decrements or a write, whichever is cheaper.
+uint16_t Vulintus_MCP4xxx_DigiPot::move_to(uint16_t code, uint8_t wiper_i)
+{
+    uint16_t current;                                   // Current wiper value.
+    if (code > n_resistors) {                           // If the value is out of range...
+        code = n_resistors;                             // Clip it to the top of the ladder.
+    }
+    if (async() || staged() || !cache_lookup(wiper_i, &current)) {  // If writes are queued or staged, or the current wiper value isn't known...
+        return set_code(code, wiper_i);                 // Use an absolute write.
+    }
+    if (current == code) {                              // If the wiper is already there...
+        return code;                                    // Skip the bus entirely.
+    }
+    uint16_t n_steps = (code > current) ? (code - current) : (current - code);  // Count the steps to the target.
+    if ((n_steps > MCP4XXX_FRAME_MAX_CMDS) ||           // If the steps won't fit in a single frame...
+            (bus_cost_ns(n_steps) >= bus_cost_ns(2))) { // ...or they cost at least as much as a 2-byte write...
+        return set_code(code, wiper_i);                 // Use an absolute write.
+    }
+    MCP4xxx_reg reg = wiper_i ? MCP4XXX_REG_WIPER1 : MCP4XXX_REG_WIPER0;    // Grab the wiper register.
+    Vulintus_MCP4xxx_Frame frame;                       // Create a command frame.
+    for (uint16_t i = 0; i < n_steps; i++) {            // Queue one command per step.
+        if (code > current) {
+            frame.increment(reg);
+        }
+        else {
+            frame.decrement(reg);
+        }
+    }
+    if (send_frame(frame)) {                            // Send the steps. If the transaction failed...
+        return DIGIPOT_CODE_INVALID;                    // Return the error value.
+    }
+    return get_code(wiper_i);                           // Return the new cached value.
+}
+
+
+// Estimate the bus time to send a number of command bytes.
+uint32_t Vulintus_MCP4xxx_DigiPot::bus_cost_ns(uint8_t n_bytes)
+{
+    uint32_t n_bits;                                    // Number of clock cycles on the wire.
+    uint32_t cost;                                      // Total cost, in nanoseconds.
+    if (!spi_mode()) {                                  // I2C mode.
+        n_bits = 9 * (1 + (uint32_t) n_bytes) + 2;      // Address byte, command bytes (with ACKs), START and STOP.
+        cost = (n_bits * 1000000UL) / (_clock / 1000);  // Convert the bits to nanoseconds.
+        if (_clock > DIGIPOT_I2C_FAST_HZ) {             // If the bus is in High-speed mode...
+            cost += (10 * 1000000UL) / (DIGIPOT_I2C_FAST_HZ / 1000);   // Add the START and master code, at Fast-mode speed.
+        }
+        cost += (uint32_t) n_bytes * MCP4XXX_I2C_BYTE_OVERHEAD_NS;      // Add the per-byte software overhead.
+    }
+    else {                                              // SPI mode.
+        n_bits = 8 * (uint32_t) n_bytes;                // Command bytes only.
+        cost = (n_bits * 1000000UL) / (_clock / 1000);  // Convert the bits to nanoseconds.
+        cost += (uint32_t) n_bytes * MCP4XXX_SPI_BYTE_OVERHEAD_NS;      // Add the per-byte software overhead.
+    }
+    return cost;                                        // Return the estimated cost.
+}
+
+
+// SPI clock rate for a transaction (reads through a shared SDI/SDO pin are slower).
+uint32_t Vulintus_MCP4xxx_DigiPot::spi_clock(bool has_read)
+{
+    if (has_read && (_clock > DIGIPOT_SPI_MUX_READ_HZ) && (part_flags() & DIGIPOT_PART_FLAG_SDO_MUX)) {
+        return DIGIPOT_SPI_MUX_READ_HZ;                 // Slow down for the shared pin's pull-up.
+    }
+    return _clock;                                      // Otherwise, use the device's clock rate.
+}
+
+
+// Send a command with data.
+DigiPot_status Vulintus_MCP4xxx_DigiPot::send_cmd(uint8_t addr, uint8_t cmd, uint16_t data, uint16_t *reply)
+{
+    uint8_t tx[2];                                  // Command bytes.
+    uint8_t rx[2] = {0, 0};                         // Reply bytes.
+    DigiPot_status status = DIGIPOT_OK;             // Transmission status.
+
+    tx[0] = addr | cmd | (data >> 8);               // Combine the address, command and MSB to make the high byte.
+    tx[1] = data;                                   // Grab the bottom 8 bits from the data for the low byte.
+    if (!bus_ready()) {                             // If there's no transport...
+        return _status;                             // Return the error.
+    }
+
+    if (!spi_mode()) {                              // I2C mode.
+        if (cmd == MCP4XXX_CMD_READ) {              // If we're reading the register...
+            status = _bus->i2c_write_read(_addr, tx, 1, rx, 2, _clock);    // Send the command, then read after a repeated start.
         }
         else {                                      // Otherwise, if we're writing the register...
-            _i2c_bus->write(lo_byte);               // Send the low byte.
-            lo_byte = _i2c_bus->endTransmission();  // End the transmission.
-            hi_byte = 0x00;                         // Clear the high byte.
+            status = _bus->i2c_write(_addr, tx, 2, _clock);                // Send both bytes.
         }
     }
     else {                                          // SPI mode.    
-        _spi_bus->beginTransaction(SPISettings(MCP4XXX_SPI_CLKRATE, MSBFIRST, SPI_MODE0));   // Set the SPI settings for this chip.
-        digitalWrite(_pin_cs, LOW);                 // Set the chip select line low.    
-        hi_byte = _spi_bus->transfer(hi_byte);      // Send the high byte.
-        lo_byte = _spi_bus->transfer(lo_byte);      // Send the low byte.
-        digitalWrite(_pin_cs, HIGH);                // Set the chip select line high. 
-        _spi_bus->endTransaction();                 // Release the SPI bus.        
+        rx[0] = tx[0];                              // Copy the command into the reply buffer.
+        rx[1] = tx[1];
+        _bus->spi_select(_cs, spi_clock(cmd == MCP4XXX_CMD_READ), MSBFIRST, SPI_MODE0);     // Start the transaction with this chip's settings.
+        _bus->spi_transfer(rx, 2);                  // Send both bytes in one block (the reply comes back in place).
+        status = _bus->spi_deselect(_cs);           // End the transaction (some cores only report a failed transfer here).
+        if ((status == DIGIPOT_OK) && !(rx[0] & MCP4XXX_SPI_CMDERR)) {     // If the chip pulled CMDERR low...
+            status = DIGIPOT_ERR_BUS;               // The command was rejected.
+        }
     }
 
-    reply = (uint16_t) (hi_byte << 8) + lo_byte;    // Combine the high and low bytes.
-    reply &= 0x01FF;                                // Kick out all but the bottom 9 bits.
-    return reply;                                   // Return the result.
+    *reply = ((uint16_t) (rx[0] << 8) + rx[1]) & 0x01FF;   // Combine the high and low bytes, keeping the bottom 9 bits.
+    return status;                                  // Return the status.
 }
 
 
 // Send a command without data (increment, decrement).
-void Vulintus_MCP4xxx_DigiPot::send_cmd(uint8_t addr, uint8_t cmd)
+DigiPot_status Vulintus_MCP4xxx_DigiPot::send_cmd(uint8_t addr, uint8_t cmd)
 {
-    uint8_t hi_byte = addr | cmd;           // Combine the address, command and MSB to make the high byte.
+    uint8_t hi_byte = addr | cmd;                       // Combine the address and command to make the high byte.
 
-    if (_spi_bus == NULL) {                             // I2C mode (SPI pointer is NULL).
-        _i2c_bus->setClock(MCP4XXX_I2C_CLKRATE);        // Set the I2C clockrate.
-        _i2c_bus->beginTransmission(_i2c_addr); 	    // Start I2C transmission.
-        _i2c_bus->write(hi_byte);                       // Send the high byte.
-        _i2c_bus->endTransmission(); 	                // End the transmission.
+    if (!bus_ready()) {                                 // If there's no transport...
+        return _status;                                 // Return the error.
     }
-    else {                                              // SPI mode.    
-        _spi_bus->beginTransaction(SPISettings(MCP4XXX_SPI_CLKRATE, MSBFIRST, SPI_MODE0));   // Set the SPI settings for this chip.
-        digitalWrite(_pin_cs, LOW);                     // Set the chip select line low.    
-        _spi_bus->transfer(hi_byte);                    // Send the high byte.
-        digitalWrite(_pin_cs, HIGH);                    // Set the chip select line high. 
-        _spi_bus->endTransaction();                     // Release the SPI bus.
+    if (!spi_mode()) {                                  // I2C mode.
+        return _bus->i2c_write(_addr, &hi_byte, 1, _clock, false);     // Send the command byte (never retried).
     }
-}                
\ No newline at end of file
+    _bus->spi_select(_cs, spi_clock(false), MSBFIRST, SPI_MODE0);  // Start the transaction with this chip's settings.
+    uint8_t reply = _bus->spi_transfer(hi_byte);        // Send the command byte.
+    DigiPot_status status = _bus->spi_deselect(_cs);    // End the transaction (SPI has no acknowledge, but the core may report a failed transfer).
+    if ((status == DIGIPOT_OK) && !(reply & MCP4XXX_SPI_CMDERR)) {     // If the chip pulled CMDERR low...
+        status = DIGIPOT_ERR_BUS;                       // The command was rejected.
+    }
+    return status;                                      // Return the status.
+}
+
+
+// Write a wiper value to the chip (Vulintus_DigiPot base class function).
+uint8_t Vulintus_MCP4xxx_DigiPot::bus_write(uint16_t code, uint8_t wiper_i)
+{
+    return write(code, wiper_i);        // Write the value to the specified wiper.
+}
+
+
+// Read a wiper value from the chip (Vulintus_DigiPot base class function).
+uint16_t Vulintus_MCP4xxx_DigiPot::bus_read(uint8_t wiper_i)
+{
+    return read(wiper_i);               // Read the value from the specified wiper.
+}
+
+
+// Write both wipers in a single transaction (Vulintus_DigiPot base class function).
+uint8_t Vulintus_MCP4xxx_DigiPot::bus_write_multi(const uint16_t *codes, uint8_t wiper_mask)
+{
+    if (async()) {                      // If asynchronous mode is on...
+        return Vulintus_DigiPot::bus_write_multi(codes, wiper_mask);   // Queue one write per wiper.
+    }
+    Vulintus_MCP4xxx_Frame frame;       // Create a command frame.
+    if (wiper_mask & 0x01) {            // If wiper 0 should be written...
+        frame.write(MCP4XXX_REG_WIPER0, codes[0]);
+    }
+    if (wiper_mask & 0x02) {            // If wiper 1 should be written...
+        frame.write(MCP4XXX_REG_WIPER1, codes[1]);
+    }
+    return send_frame(frame);           // Send both writes at once.
+}
+
+
+// Check if the part is on an SPI bus.
+bool Vulintus_MCP4xxx_DigiPot::spi_mode(void)
+{
+    return (part_flags() & DIGIPOT_PART_FLAG_SPI);  // Read the bus flag from the part descriptor.
+}
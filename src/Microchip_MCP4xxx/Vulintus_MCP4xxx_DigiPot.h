@@ -23,6 +23,34 @@
         - MCP4261 -> Dual potentiometer, SPI, EE memory, 8-bit
         - MCP4262 -> Dual rheostat, SPI, E memory, 8-bit
 
+    The bus clock is set per device with "set_clock". SPI parts default to 
+    1 MHz and run at up to 10 MHz, except that the MCP41x1 parts (shared 
+    SDI/SDO pin) drop to 250 kHz for reads. I2C parts default to 400 kHz. On 
+    cores that opt in (DIGIPOT_I2C_HS_MODE, see "Vulintus_DigiPot_Bus.h"), 
+    they run at up to 3.4 MHz in High-speed mode, entered with a master code 
+    at 400 kHz before each transaction. Simulated bus time per operation, 
+    computed by the host simulator ("extras/host") from the clock rate and 
+    the bits on the wire. These are not hardware measurements, and they 
+    leave out core overhead, "setClock" calls and gaps between bytes:
+
+        Bus clock       Write       Read        Both wipers (set_codes)
+        I2C 100 kHz     290 us      480 us      470 us
+        I2C 400 kHz     72.5 us     120 us      117.5 us
+        I2C 3.4 MHz     33.5 us     39.1 us     38.8 us
+        SPI 1 MHz       16 us       16 us       32 us
+        SPI 4 MHz       4 us        4 us        8 us
+        SPI 10 MHz      1.6 us      1.6 us      3.2 us
+
+    Most of the simulated Hs-mode time is the 25 us master code, so Hs-mode 
+    pays off most for reads and multi-command frames.
+
+    In asynchronous ("set_async") and staged ("set_staged") modes, 
+    "increment" and "decrement" are sent as absolute writes of the next 
+    code through "set_code", so they're queued or staged in order with the 
+    other writes instead of going straight to the bus. They step from the 
+    staged target or the cached value. If neither is known, nothing is sent 
+    and the status is DIGIPOT_ERR_UNKNOWN.
+
     Licensed under the Apache License, Version 2.0 (the "License"); you may not 
     use this file except in compliance with the License.
 
@@ -41,6 +69,45 @@
         2024-07-16 - Drew Sloan - Converted to a base MCP4xxx class with 
                                   inheriting classs for the 128 and 256 step 
                                   variants.
+        2026-10-17 - Drew Sloan - Moved the scaled/resistance functions to the 
+                                  base class and added wiper cache updates.
+        2026-10-17 - Drew Sloan - Added "Vulintus_MCP4xxx_Frame" for sending 
+                                  multiple commands in a single transaction.
+        2026-10-17 - Drew Sloan - Added "move_to" to choose between streamed 
+                                  increments/decrements and absolute writes.
+        2026-10-17 - Drew Sloan - Switched to the shared bus transport, with 
+                                  repeated-start register reads.
+        2026-10-17 - Drew Sloan - Added asynchronous (queued) writes and reads.
+        2026-10-17 - Drew Sloan - SPI commands and frames are now sent as a 
+                                  single block transfer.
+        2026-10-17 - Drew Sloan - Frames sent over I2C are counted by the 
+                                  optional bus performance counters.
+        2026-10-17 - Drew Sloan - Added the nonvolatile wiper registers and 
+                                  "Vulintus_MCP4xxx_NV" for EEPROM writes.
+        2026-10-17 - Drew Sloan - Part constants now come from the flash 
+                                  descriptor table. Added the per-part 
+                                  "Vulintus_MCP4xxx_SPI_Part"/"_I2C_Part" 
+                                  classes, and merged the SPI/I2C pointers 
+                                  and the address/chip select pin.
+        2026-10-17 - Drew Sloan - The bus clock is now set per device, with 
+                                  10 MHz SPI and 3.4 MHz (Hs-mode) I2C.
+        2026-10-17 - Drew Sloan - SPI chip select now uses direct port writes.
+        2026-10-17 - Drew Sloan - Hs-mode I2C is opt-in per core, and a failed 
+                                  master code fails the frame.
+        2026-10-17 - Drew Sloan - I2C frames now go through the bus transport, 
+                                  with its timeout and retry policy (frames 
+                                  with increments/decrements aren't retried).
+        2026-10-17 - Drew Sloan - Frames keep the SPI CMDERR bit for each 
+                                  command ("cmd_error").
+        2026-10-17 - Drew Sloan - Increments/decrements are queued or staged 
+                                  as absolute writes in asynchronous and 
+                                  staged modes.
+        2026-10-17 - Drew Sloan - A failed SPI transfer (where the core reports 
+                                  it) fails the command and clears the cache.
+        2026-10-17 - Drew Sloan - A command rejected with CMDERR fails with 
+                                  DIGIPOT_ERR_BUS. In a frame, the wipers it 
+                                  and the commands after it address (which 
+                                  the chip ignores) are marked unknown.
                                         
 */
 
@@ -69,8 +136,63 @@ enum MCP4xxx_I2C_addr : uint8_t {
     MCP4XXX_I2C_ADDR_HHH = 0b0101111,   //0x2F, MCP45x1/45x2/46x1/46x2.
 };
 
+enum MCP4xxx_reg : uint8_t {
+    MCP4XXX_REG_WIPER0      = 0x00,     // Volatile Wiper 0.
+    MCP4XXX_REG_WIPER1      = 0x10,     // Volatile Wiper 1.
+    MCP4XXX_REG_NV_WIPER0   = 0x20,     // Nonvolatile Wiper 0 (EE variants only).
+    MCP4XXX_REG_NV_WIPER1   = 0x30,     // Nonvolatile Wiper 1 (EE variants only).
+    MCP4XXX_REG_TCON        = 0x40,     // Volatile TCON Register.
+    MCP4XXX_REG_STATUS      = 0x50,     // Status Register.
+};
+
+enum MCP4xxx_cmd : uint8_t {
+    MCP4XXX_CMD_WRITE   = 0x00,     // Write data command.
+    MCP4XXX_CMD_READ    = 0x0C,     // Read data command.
+    MCP4XXX_CMD_INCR    = 0x04,     // Increment command.
+    MCP4XXX_CMD_DECR    = 0x08,     // Decrement command.
+};
+
+#define MCP4XXX_FRAME_MAX_CMDS  8   // Maximum number of commands in a single frame.
+#define MCP4XXX_SPI_CMDERR      0x02    // CMDERR bit in the SPI reply to a command byte (reads 0 on an error).
+
 
 // CLASSES ***********************************************************************************************************// 
+class Vulintus_MCP4xxx_Frame {
+
+    public:
+
+        // Constructor. //
+        Vulintus_MCP4xxx_Frame(void);
+
+        // Public variables. //
+        uint8_t n_cmds;                 // Number of queued commands.
+
+        // Public functions. //
+        void clear(void);                                   // Remove all queued commands.
+        int8_t write(MCP4xxx_reg reg, uint16_t value);      // Queue a write command (returns the command index, or -1 if full).
+        int8_t increment(MCP4xxx_reg reg);                  // Queue an increment command.
+        int8_t decrement(MCP4xxx_reg reg);                  // Queue a decrement command.
+        int8_t read(MCP4xxx_reg reg);                       // Queue a read command.
+        uint16_t reply(uint8_t cmd_i);                      // Fetch the data returned for a queued command.
+        bool cmd_error(uint8_t cmd_i);                      // Check if the chip flagged a command error (SPI only; I2C errors are NACKed).
+        uint8_t n_bytes(void);                              // Number of bytes in the command stream.
+
+    private:
+
+        // Private variables. //
+        uint8_t _hi_byte[MCP4XXX_FRAME_MAX_CMDS];       // Command byte (address, command, and data MSB).
+        uint8_t _lo_byte[MCP4XXX_FRAME_MAX_CMDS];       // Data byte (write and read commands only).
+        uint16_t _reply[MCP4XXX_FRAME_MAX_CMDS];        // Returned data for each command.
+        uint8_t _cmd_errors;                            // CMDERR flags, one bit per command (SPI only).
+
+        // Private functions. //
+        int8_t add(uint8_t hi_byte, uint8_t lo_byte);   // Add a command to the frame.
+
+        friend class Vulintus_MCP4xxx_DigiPot;
+
+};
+
+
 class Vulintus_MCP4xxx_DigiPot : public Vulintus_DigiPot {
 
 	public:
@@ -79,44 +201,38 @@ class Vulintus_MCP4xxx_DigiPot : public Vulintus_DigiPot {
         Vulintus_MCP4xxx_DigiPot(uint16_t num_resistors, uint8_t pin_cs, SPIClass *spi_bus = &SPI);
         Vulintus_MCP4xxx_DigiPot(uint16_t num_resistors, uint8_t i2c_addr = MCP4XXX_I2C_ADDR_HHL, \
                 TwoWire *i2c_bus = &Wire);
-
-        // Public variables matching "Vulintus_DigiPot" base class. //
-        float wiper_resistance = 75;        // Wiper resistance, in ohms.
-        float max_resistance = 10000;       // Maximum resistance (not counting wiper), in ohms
+        Vulintus_MCP4xxx_DigiPot(DigiPot_part part, uint8_t pin_cs, SPIClass *spi_bus);
+        Vulintus_MCP4xxx_DigiPot(DigiPot_part part, uint8_t i2c_addr, TwoWire *i2c_bus);
 
         // Public functions matching "Vulintus_DigiPot" base class. //
         uint8_t begin(void); 		        // Initialization.       
-
-		float set_scaled(float float_scaled);			        // Write the Wiper 0 value, scaled 0-1.
-		float set_scaled(float float_scaled, uint8_t wiper_i);  // Write the specified wiper value, scaled 0-1.
-		float get_scaled(void);                                 // Read the Wiper 0 value, scaled 0-1.
-        float get_scaled(uint8_t wiper_i);         		        // Read the specified wiper value, scaled 0-1.
-
-        float set_resistance(float float_ohms);					    // Write the Wiper 0 value, in real resistance (ohms).
-		float set_resistance(float float_ohms, uint8_t wiper_i);    // Write the specified wiper value, in real resistance (ohms).
-		float get_resistance(void);                        		    // Read the Wiper 0 value, in real resistance (ohms).
-        float get_resistance(uint8_t wiper_i);         			    // Read the specified wiper value, in real resistance (ohms).
+        void *bus_handle(void);             // Bus interface pointer.
+        uint8_t bus_address(void);          // I2C address or SPI chip select pin.
 
         // Public functions. //
         uint16_t read(void);                            // Read the Wiper 0 value.
         uint16_t read(uint8_t wiper_i);                 // Read the specified wiper value.
-        void write(uint16_t value);                     // Write the Wiper 0 value.
-        void write(uint16_t value, uint8_t wiper_i);    // Write the specified wiper value.
+        uint8_t write(uint16_t value);                  // Write the Wiper 0 value.
+        uint8_t write(uint16_t value, uint8_t wiper_i); // Write the specified wiper value.
         void increment(void);                           // Increment Wiper 0.
         void increment(uint8_t wiper_i);                // Increment the specified wiper.
         void decrement(void);                           // Decrement Wiper 0.
         void decrement(uint8_t wiper_i);                // Decrement the specified wiper.        
+        uint8_t send_frame(Vulintus_MCP4xxx_Frame &frame);  // Send all commands in a frame as a single transaction.
+        uint16_t move_to(uint16_t code, uint8_t wiper_i);   // Move a wiper with streamed increments/decrements or a write, whichever is cheaper.
+
+    protected:
+
+        // Protected functions matching "Vulintus_DigiPot" base class. //
+        uint8_t bus_write(uint16_t code, uint8_t wiper_i);     // Write a wiper value to the chip.
+        uint16_t bus_read(uint8_t wiper_i);                     // Read a wiper value from the chip.
+        uint8_t bus_write_multi(const uint16_t *codes, uint8_t wiper_mask);    // Write both wipers in a single transaction.
 
     private:
 
         // Private constants. // 
-        static const uint32_t MCP4XXX_I2C_CLKRATE = 400000;     // Clock frequency for I2C communication (Hz).
-        static const uint32_t MCP4XXX_SPI_CLKRATE = 1000000;    // Clock frequency for SPI communication (Hz).
-
-        static const uint8_t MCP4XXX_REG_WIPER0  = 0x00;    // Volatile Wiper 0.
-        static const uint8_t MCP4XXX_REG_WIPER1  = 0x10;    // Volatile Wiper 1.
-        static const uint8_t MCP4XXX_REG_TCON    = 0x40;    // Volatile TCON Register.
-        static const uint8_t MCP4XXX_REG_STATUS  = 0x50;    // Status Register.
+        static const uint16_t MCP4XXX_I2C_BYTE_OVERHEAD_NS = 2000;  // Approximate software overhead per I2C byte (ns).
+        static const uint16_t MCP4XXX_SPI_BYTE_OVERHEAD_NS = 1000;  // Approximate software overhead per SPI byte (ns).
 
         static const uint8_t MCP4XXX_STATUS_SHDN = 0x02;    // Hardware Shutdown pin Status bit.
 
@@ -129,21 +245,20 @@ class Vulintus_MCP4xxx_DigiPot : public Vulintus_DigiPot {
         static const uint8_t MCP4XXX_TCON_R1W    = 0x20;    // Resistor 1 Wiper (P1W pin) Connect Control bit.
         static const uint8_t MCP4XXX_TCON_R1B    = 0x10;    // Resistor 1 Terminal B (P1B pin) Connect Control bit.
 
-        static const uint8_t MCP4XXX_CMD_WRITE   = 0x00;    // Write data command.
-        static const uint8_t MCP4XXX_CMD_READ    = 0x0C;    // Read data command.
-        static const uint8_t MCP4XXX_CMD_INCR    = 0x04;    // Increment command.
-        static const uint8_t MCP4XXX_CMD_DECR    = 0x08;    // Decrement command.
-
         // Private variables. // 
-        SPIClass *_spi_bus = NULL;	    // SPI interface pointer.
-        uint8_t _pin_cs;                // Chip select pin.
-
-        TwoWire *_i2c_bus = NULL;       // I2C interface pointer.
-        uint8_t _i2c_addr;              // I2C address.    
+        void *_port;                    // SPI or I2C interface pointer (the part descriptor selects the bus).
+        uint8_t _addr;                  // I2C address or chip select pin.
+        DigiPot_cs _cs;                 // Chip select pin, resolved to its port register (SPI only).
 
         // Private functions. // 
-        uint16_t send_cmd(uint8_t addr, uint8_t cmd, uint16_t data);     // Send a command with data.
-        void send_cmd(uint8_t addr, uint8_t cmd);                        // Send a command without data (increment, decrement).
+        DigiPot_status send_cmd(uint8_t addr, uint8_t cmd, uint16_t data, uint16_t *reply);  // Send a command with data.
+        DigiPot_status send_cmd(uint8_t addr, uint8_t cmd);              // Send a command without data (increment, decrement).
+        uint32_t bus_cost_ns(uint8_t n_bytes);                           // Estimate the bus time to send a number of command bytes.
+        bool spi_mode(void);                                             // Check if the part is on an SPI bus.
+        uint32_t spi_clock(bool has_read);                               // SPI clock rate for a transaction (reads through a shared SDI/SDO pin are slower).
+        void step_write(uint8_t wiper_i, int8_t steps);                  // Step a wiper with an absolute write (asynchronous and staged modes).
+
+        friend class Vulintus_MCP4xxx_NV;
 
 };
 
@@ -199,7 +314,41 @@ class Vulintus_MCP4xxx_I2C_256_DigiPot : public Vulintus_MCP4xxx_DigiPot {
 
 };
 
+
+
+// Specific parts (Vulintus_MCP4131...Vulintus_MCP4662), which load their descriptors from flash.
+template <DigiPot_part PART> class Vulintus_MCP4xxx_SPI_Part : public Vulintus_MCP4xxx_DigiPot {
+
+    public:
+    
+        Vulintus_MCP4xxx_SPI_Part(uint8_t pin_cs, SPIClass *spi_bus = &SPI) 
+            : Vulintus_MCP4xxx_DigiPot(PART, pin_cs, spi_bus)
+        { 
+            //empty
+        }
+
+};
+
+
+template <DigiPot_part PART> class Vulintus_MCP4xxx_I2C_Part : public Vulintus_MCP4xxx_DigiPot {
+
+    public:
+    
+        Vulintus_MCP4xxx_I2C_Part(uint8_t i2c_addr = MCP4XXX_I2C_ADDR_HHL, TwoWire *i2c_bus = &Wire) 
+            : Vulintus_MCP4xxx_DigiPot(PART, i2c_addr, i2c_bus)
+        { 
+            //empty
+        }
+
+};
+
         
 
+// Compile-time specialized variants of the MCP4xxx drivers.
+#include "./Vulintus_MCP4xxx_Static.h"
+
+// Nonvolatile (EEPROM) wiper writes for the EE variants.
+#include "./Vulintus_MCP4xxx_NV.h"
+
 
 #endif      // #ifndef VULINTUS_MCP4XXX_DIGIPOT_H
\ No newline at end of file
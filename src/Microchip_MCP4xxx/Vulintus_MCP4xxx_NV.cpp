@@ -0,0 +1,253 @@
+/*
+
+    Vulintus_MCP4xxx_NV.cpp
+
+    Copyright 2026, Vulintus, Inc.
+
+    See "Vulintus_MCP4xxx_NV.h" for documentation and change log.
+
+*/
+
+
+#include "./Vulintus_MCP4xxx_NV.h"      // Library header.
+
+
+// CLASS FUNCTIONS ***********************************************************//
+
+// Class constructor.
+Vulintus_MCP4xxx_NV::Vulintus_MCP4xxx_NV(Vulintus_MCP4xxx_DigiPot *pot)
+{
+    _pot = pot;                                     // Save the driver pointer.
+    _window_us = 0;                                 // Write as soon as the EEPROM is idle.
+    _nv[0] = _nv[1] = DIGIPOT_CODE_INVALID;         // The nonvolatile values aren't known yet.
+    _pending_mask = 0;                              // Nothing is pending...
+    _active = false;                                // ...or being written.
+    _status = DIGIPOT_OK;
+    n_writes = 0;                                   // Zero the counters.
+    n_coalesced = 0;
+    n_skipped = 0;
+    n_failed = 0;
+}
+
+
+// Request a nonvolatile Wiper 0 write.
+DigiPot_status Vulintus_MCP4xxx_NV::write(uint16_t value)
+{
+    return write(value, 0);
+}
+
+
+// Request a nonvolatile write to the specified wiper.
+DigiPot_status Vulintus_MCP4xxx_NV::write(uint16_t value, uint8_t wiper_i)
+{
+    _status = check_part(wiper_i);                  // Check for the nonvolatile wiper.
+    if (_status != DIGIPOT_OK) {                    // If the part doesn't have it...
+        return _status;                             // Return the error.
+    }
+    if (value > _pot->n_resistors) {                // If the value is past full scale...
+        value = _pot->n_resistors;                  // Clamp it, as the chip would.
+    }
+    uint8_t bit = 1 << wiper_i;                     // Pending-request bit for this wiper.
+    if (_pending_mask & bit) {                      // If a request is already waiting...
+        _pending[wiper_i] = value;                  // Replace it (the window keeps its original start).
+        n_coalesced++;
+    }
+    else if (value == _nv[wiper_i]) {               // Otherwise, if the EEPROM already holds (or is writing) this value...
+        n_skipped++;                                // There's nothing to do.
+    }
+    else {                                          // Otherwise...
+        _pending[wiper_i] = value;                  // Record the request.
+        _request_us[wiper_i] = micros();            // Start the coalescing window.
+        _pending_mask |= bit;
+    }
+    return step(false);                             // Start the write now, if possible.
+}
+
+
+// Read the nonvolatile Wiper 0 value.
+uint16_t Vulintus_MCP4xxx_NV::read(void)
+{
+    return read(0);
+}
+
+
+// Read the specified nonvolatile wiper value.
+uint16_t Vulintus_MCP4xxx_NV::read(uint8_t wiper_i)
+{
+    _status = check_part(wiper_i);                  // Check for the nonvolatile wiper.
+    if (_status != DIGIPOT_OK) {                    // If the part doesn't have it...
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    if (busy()) {                                   // If the stored value is about to change...
+        _status = DIGIPOT_PENDING;                  // Report that a write is pending.
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    Vulintus_MCP4xxx_Frame frame;                   // Build a single-command frame.
+    frame.read(wiper_i ? MCP4XXX_REG_NV_WIPER1 : MCP4XXX_REG_NV_WIPER0);
+    _status = (DigiPot_status) _pot->send_frame(frame);     // Send it.
+    if (_status != DIGIPOT_OK) {                    // If the read failed...
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    _nv[wiper_i] = frame.reply(0);                  // Remember the stored value.
+    return _nv[wiper_i];                            // Return it.
+}
+
+
+// Advance pending writes (returns DIGIPOT_PENDING until all are done).
+DigiPot_status Vulintus_MCP4xxx_NV::poll(void)
+{
+    return step(false);
+}
+
+
+// Write everything pending now, blocking until done.
+DigiPot_status Vulintus_MCP4xxx_NV::flush(void)
+{
+    uint32_t t_start = micros();                    // Grab the start time.
+    uint32_t t_limit = 3 * MCP4XXX_NV_TWC_US;       // One write per wiper, plus margin.
+    DigiPot_status status;
+    while ((status = step(true)) == DIGIPOT_PENDING) {  // Loop until everything is written.
+        if ((micros() - t_start) > t_limit) {       // If the chip never finished...
+            _status = DIGIPOT_ERR_TIMEOUT;          // Report a timeout.
+            return _status;
+        }
+        delayMicroseconds(MCP4XXX_NV_POLL_US);      // Wait between STATUS polls.
+    }
+    return status;                                  // Return the final status.
+}
+
+
+// Check for pending or in-progress writes.
+bool Vulintus_MCP4xxx_NV::busy(void)
+{
+    return (_active || _pending_mask);
+}
+
+
+// Read the STATUS register.
+uint16_t Vulintus_MCP4xxx_NV::read_status(void)
+{
+    Vulintus_MCP4xxx_Frame frame;                   // Build a single-command frame.
+    frame.read(MCP4XXX_REG_STATUS);
+    _status = (DigiPot_status) _pot->send_frame(frame);     // Send it.
+    if (_status != DIGIPOT_OK) {                    // If the read failed...
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    return frame.reply(0);                          // Return the register value.
+}
+
+
+// Check if WiperLock is set for a wiper.
+bool Vulintus_MCP4xxx_NV::wiper_locked(uint8_t wiper_i)
+{
+    if (!_pot->wiper_valid(wiper_i)) {              // If the chip doesn't have this wiper...
+        _status = DIGIPOT_ERR_WIPER;                // Report the bad wiper index.
+        return false;
+    }
+    uint16_t value = read_status();                 // Read the STATUS register.
+    if (value == DIGIPOT_CODE_INVALID) {            // If the read failed...
+        return false;                               // The lock state is unknown.
+    }
+    return value & (wiper_i ? MCP4XXX_STATUS_WL1 : MCP4XXX_STATUS_WL0);
+}
+
+
+// Set the coalescing window (0 = write as soon as the EEPROM is idle).
+void Vulintus_MCP4xxx_NV::set_window(uint16_t window_ms)
+{
+    _window_us = 1000UL * window_ms;                // Convert to microseconds.
+}
+
+
+// Status of the last operation.
+DigiPot_status Vulintus_MCP4xxx_NV::status(void)
+{
+    return _status;
+}
+
+
+// Advance pending writes.
+DigiPot_status Vulintus_MCP4xxx_NV::step(bool ignore_window)
+{
+    uint32_t now = micros();                        // Grab the current time.
+    if (_active) {                                  // If a write cycle is in progress...
+        if ((now - _write_us) < MCP4XXX_NV_TWC_US) {    // If tWC hasn't passed yet...
+            if ((now - _poll_us) < MCP4XXX_NV_POLL_US) {    // If the last poll was too recent...
+                return DIGIPOT_PENDING;             // Check again later.
+            }
+            _poll_us = now;                         // Poll the EEWA bit.
+            uint16_t value = read_status();
+            if ((value == DIGIPOT_CODE_INVALID) || (value & MCP4XXX_STATUS_EEWA)) { // If the chip is still busy (or didn't answer)...
+                return DIGIPOT_PENDING;             // Check again later.
+            }
+        }
+        _active = false;                            // The write cycle is done.
+    }
+    for (uint8_t i = 0; i < 2; i++) {               // Step through the wipers.
+        if (!(_pending_mask & (1 << i))) {          // Skip wipers with no request.
+            continue;
+        }
+        if (!ignore_window && ((now - _request_us[i]) < _window_us)) {  // If the window is still open...
+            continue;                               // Keep collecting requests.
+        }
+        _pending_mask &= ~(1 << i);                 // Take the request.
+        if (_pending[i] == _nv[i]) {                // If the EEPROM already holds this value...
+            n_skipped++;                            // Skip the write.
+            continue;
+        }
+        DigiPot_status status = start_write(i);     // Start the write.
+        if (status != DIGIPOT_OK) {                 // If it failed...
+            if (!wiper_locked(i)) {                 // Unless the wiper is locked (which a retry can't fix)...
+                _pending_mask |= (1 << i);          // Keep the request for the next poll.
+            }
+            _status = status;
+            return _status;                         // Return the error.
+        }
+        _status = DIGIPOT_OK;
+        return DIGIPOT_PENDING;                     // Only one write cycle can run at a time.
+    }
+    _status = DIGIPOT_OK;
+    return (_pending_mask ? DIGIPOT_PENDING : DIGIPOT_OK);  // Report any requests still in their window.
+}
+
+
+// Start an EEPROM write cycle.
+DigiPot_status Vulintus_MCP4xxx_NV::start_write(uint8_t wiper_i)
+{
+    Vulintus_MCP4xxx_Frame frame;                   // The write goes out on its own (tWC starts at the STOP or CS rising edge).
+    frame.write(wiper_i ? MCP4XXX_REG_NV_WIPER1 : MCP4XXX_REG_NV_WIPER0, _pending[wiper_i]);
+    DigiPot_status status = (DigiPot_status) _pot->send_frame(frame);
+    if (status != DIGIPOT_OK) {                     // If the write failed (a busy or locked chip NACKs on I2C, or flags CMDERR on SPI)...
+        _nv[wiper_i] = DIGIPOT_CODE_INVALID;        // The stored value is no longer known.
+        n_failed++;
+        return status;
+    }
+    _nv[wiper_i] = _pending[wiper_i];               // The EEPROM now holds the new value.
+    _active = true;                                 // Start timing the write cycle.
+    _write_us = micros();
+    _poll_us = _write_us;
+    n_writes++;
+    return DIGIPOT_OK;
+}
+
+
+// Check that the part has this nonvolatile wiper.
+DigiPot_status Vulintus_MCP4xxx_NV::check_part(uint8_t wiper_i)
+{
+    if (!_pot->wiper_valid(wiper_i)) {              // If the chip doesn't have this wiper...
+        return DIGIPOT_ERR_WIPER;                   // Report the bad wiper index.
+    }
+    switch (_pot->part()) {
+        case DIGIPOT_PART_MCP4XXX_SPI_128:          // Generic drivers don't know if the part has an EEPROM...
+        case DIGIPOT_PART_MCP4XXX_SPI_256:
+        case DIGIPOT_PART_MCP4XXX_I2C_128:
+        case DIGIPOT_PART_MCP4XXX_I2C_256:
+            return DIGIPOT_OK;                      // ...so the chip has to reject the command.
+        default:
+            break;
+    }
+    if (!(_pot->part_flags() & DIGIPOT_PART_FLAG_NV)) {    // If the part is volatile-only...
+        return DIGIPOT_ERR_UNSUPPORTED;             // Report the missing EEPROM.
+    }
+    return DIGIPOT_OK;
+}
@@ -0,0 +1,143 @@
+/*
+
+    Vulintus_MCP4xxx_NV.h
+
+    Copyright 2026, Vulintus, Inc.
+
+    Non-blocking nonvolatile (EEPROM) wiper writes for the EE variants of the
+    Microchip MCP4xxx digital potentiometers/rheostats (MCP414x/416x/424x/426x
+    and MCP454x/456x/464x/466x). Volatile-only parts don't need this helper
+    and pay nothing for it.
+
+    Each EEPROM write takes up to tWC = 10 ms, during which the chip rejects
+    further nonvolatile commands, and the EEPROM is only rated for a limited
+    number of write cycles. So "write" only records the requested value, and
+    "poll" (call it from "loop") does the work:
+        - A write starts once the EEPROM is idle and the coalescing window
+          (see "set_window") has passed since the first request. Requests
+          made in the meantime replace the pending value, so a burst of
+          commits costs a single write cycle.
+        - Values that match what the EEPROM already holds are skipped.
+        - Each write is sent in its own transaction, since the write cycle
+          only starts at the I2C STOP or the SPI chip select rising edge. A
+          write rejected because the EEPROM is busy or the wiper is locked
+          is caught from the reply: I2C chips NACK it, and SPI chips pull the
+          CMDERR bit low.
+        - The EEPROM write-active (EEWA) bit is then polled from STATUS in
+          later transactions, at most once per millisecond. The write is
+          considered done when the bit clears, or once tWC has passed.
+        - A write that fails for any reason other than WiperLock (a busy
+          EEPROM, or a bus error) stays pending and is tried again on the
+          next "poll". Writes to a locked wiper are dropped.
+
+    Parts whose descriptor lacks DIGIPOT_PART_FLAG_NV (the volatile-only 
+    part aliases) are rejected by "write" and "read" with 
+    DIGIPOT_ERR_UNSUPPORTED. Generic drivers don't know their part, so the
+    chip itself rejects the command.
+
+    WiperLock (set with the high-voltage commands on the WLAT/HVC pin) blocks
+    nonvolatile writes to a wiper. "wiper_locked" reports it from STATUS.
+
+        Vulintus_MCP4xxx_I2C_256_DigiPot pot;
+        Vulintus_MCP4xxx_NV pot_nv(&pot);
+
+        pot_nv.set_window(500);         // Save at most once per 500 ms.
+        pot_nv.write(pot.get_code());   // Request a save (returns immediately).
+        pot_nv.poll();                  // Call from "loop".
+
+    Licensed under the Apache License, Version 2.0 (the "License"); you may not
+    use this file except in compliance with the License.
+
+    You may obtain a copy of the License at
+
+    http:// www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+    WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+    License for the specific language governing permissions and limitations
+    under the License.
+
+    UPDATE LOG:
+        2026-10-17 - Drew Sloan - "Vulintus_MCP4xxx_NV" class first created.
+        2026-10-17 - Drew Sloan - NV writes no longer share a transaction with 
+                                  the STATUS read (EEWA isn't set until the 
+                                  STOP/CS rising edge). Rejections are caught 
+                                  by NACK (I2C) or CMDERR (SPI).
+        2026-10-17 - Drew Sloan - Wiper indices the chip doesn't have are 
+                                  rejected with DIGIPOT_ERR_WIPER instead of 
+                                  being folded onto Wiper 1.
+        2026-10-17 - Drew Sloan - Failed writes stay pending unless the wiper is 
+                                  locked, and volatile-only parts are 
+                                  rejected with DIGIPOT_ERR_UNSUPPORTED.
+
+*/
+
+
+#ifndef VULINTUS_MCP4XXX_NV_H
+#define VULINTUS_MCP4XXX_NV_H
+
+
+// Included libraries.//
+#include <Arduino.h>                // Arduino main header.
+
+#include "./Vulintus_MCP4xxx_DigiPot.h"     // MCP4xxx driver.
+
+
+// CLASSES ***********************************************************************************************************//
+class Vulintus_MCP4xxx_NV {
+
+    public:
+
+        // Constructor. //
+        Vulintus_MCP4xxx_NV(Vulintus_MCP4xxx_DigiPot *pot);
+
+        // Public variables. //
+        uint32_t n_writes;              // EEPROM write cycles started.
+        uint32_t n_coalesced;           // Requests replaced by a later request before being written.
+        uint32_t n_skipped;             // Requests dropped because the EEPROM already held the value.
+        uint32_t n_failed;              // Writes rejected by the chip or lost to bus errors.
+
+        // Public functions. //
+        DigiPot_status write(uint16_t value);                   // Request a nonvolatile Wiper 0 write.
+        DigiPot_status write(uint16_t value, uint8_t wiper_i);  // Request a nonvolatile write to the specified wiper.
+        uint16_t read(void);                                    // Read the nonvolatile Wiper 0 value.
+        uint16_t read(uint8_t wiper_i);                         // Read the specified nonvolatile wiper value.
+        DigiPot_status poll(void);                              // Advance pending writes (returns DIGIPOT_PENDING until all are done).
+        DigiPot_status flush(void);                             // Write everything pending now, blocking until done.
+        bool busy(void);                                        // Check for pending or in-progress writes.
+        uint16_t read_status(void);                             // Read the STATUS register.
+        bool wiper_locked(uint8_t wiper_i);                     // Check if WiperLock is set for a wiper.
+        void set_window(uint16_t window_ms);                    // Set the coalescing window (0 = write as soon as the EEPROM is idle).
+        DigiPot_status status(void);                            // Status of the last operation.
+
+    private:
+
+        // Private constants. //
+        static const uint32_t MCP4XXX_NV_TWC_US = 10000;        // Maximum EEPROM write cycle time, tWC (us).
+        static const uint32_t MCP4XXX_NV_POLL_US = 1000;        // Minimum time between STATUS polls (us).
+
+        static const uint16_t MCP4XXX_STATUS_EEWA = 0x10;       // EEPROM Write Active Status bit.
+        static const uint16_t MCP4XXX_STATUS_WL1 = 0x08;        // WiperLock Status bit for Resistor Network 1.
+        static const uint16_t MCP4XXX_STATUS_WL0 = 0x04;        // WiperLock Status bit for Resistor Network 0.
+
+        // Private variables. //
+        Vulintus_MCP4xxx_DigiPot *_pot;     // MCP4xxx driver.
+        uint32_t _window_us;                // Coalescing window (us).
+        uint16_t _pending[2];               // Requested value for each wiper.
+        uint32_t _request_us[2];            // Time of the first request since each wiper's last write.
+        uint16_t _nv[2];                    // Value held by each nonvolatile wiper (DIGIPOT_CODE_INVALID if unknown).
+        uint8_t _pending_mask;              // Wipers with a pending request (bitmask).
+        bool _active;                       // Flag indicating an EEPROM write cycle is in progress.
+        uint32_t _write_us;                 // Start time of the current write cycle.
+        uint32_t _poll_us;                  // Time of the last STATUS poll.
+        DigiPot_status _status;             // Status of the last operation.
+
+        // Private functions. //
+        DigiPot_status step(bool ignore_window);                // Advance pending writes.
+        DigiPot_status start_write(uint8_t wiper_i);            // Start an EEPROM write cycle.
+        DigiPot_status check_part(uint8_t wiper_i);             // Check that the part has this nonvolatile wiper.
+
+};
+
+#endif      // #ifndef VULINTUS_MCP4XXX_NV_H
@@ -0,0 +1,617 @@
+/* 
+
+    Vulintus_MCP4xxx_Static.h
+
+    Copyright 2026, Vulintus, Inc.
+    
+    Compile-time specialized drivers for the Microchip MCP41xx/42xx (SPI) and
+    MCP45xx/46xx (I2C) digital potentiometers/rheostats. Each part is 
+    described by a traits type (part, bus, step count, wiper count, rheostat or 
+    potentiometer, volatile or nonvolatile), so bus selection compiles away, 
+    wiper indices are template arguments checked at compile time, and every
+    call can be inlined. No virtual functions are used.
+
+    Define VULINTUS_DIGIPOT_STATIC before including "Vulintus_DigiPot.h" to 
+    map the Vulintus_MCP4131...Vulintus_MCP4662 names to these templates:
+
+        #define VULINTUS_DIGIPOT_STATIC
+        #include <Vulintus_DigiPot.h>
+
+        Vulintus_MCP4251 pot(PIN_CS);
+        pot.set_code<1>(100);           // Write wiper 1.
+        pot.set_code<2>(100);           // Compile error: the MCP4251 has 2 wipers.
+
+    Wrap a static driver in "Vulintus_DigiPot_Adapter" wherever runtime 
+    polymorphism (Vulintus_DigiPot*) is still needed.
+
+    Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+    use this file except in compliance with the License.
+
+    You may obtain a copy of the License at
+
+    http:// www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS, WITHOUT 
+    WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the 
+    License for the specific language governing permissions and limitations 
+    under the License.
+
+    UPDATE LOG:
+        2026-10-17 - Drew Sloan - Templated drivers first created.
+        2026-10-17 - Drew Sloan - Switched to the shared bus transport.
+        2026-10-17 - Drew Sloan - SPI chip select now uses direct port writes.
+        2026-10-17 - Drew Sloan - Added "set_clock", with the part's clock 
+                                  limits and the slower MCP41x1 reads. 
+                                  Scaled and resistance writes now round to 
+                                  the nearest step.
+        2026-10-17 - Drew Sloan - SPI commands fail if the core reports a 
+                                  failed transfer, or the chip flags CMDERR.
+        2026-10-17 - Drew Sloan - Added "status". Failed writes report the bus 
+                                  error, and the resistances come from the 
+                                  part descriptor.
+                                        
+*/
+
+
+#ifndef VULINTUS_MCP4XXX_STATIC_H
+#define VULINTUS_MCP4XXX_STATIC_H
+
+
+// Included libraries.// 
+#include <Arduino.h>                // Arduino main header.
+#include <SPI.h>		            // Standard Arduino SPI library.
+#include <Wire.h>                   // Arduino I2C library.
+
+#include "../Vulintus_DigiPot.h"                // Vulintus digital potentiometer base class.
+#include "./Vulintus_MCP4xxx_DigiPot.h"         // Register and command definitions.
+
+
+// DEFINITIONS *******************************************************************************************************//
+template <DigiPot_part PART, DigiPot_bus_type BUS, uint16_t STEPS, uint8_t WIPERS, bool RHEOSTAT, bool NV>
+struct MCP4xxx_traits {
+    static const DigiPot_part part = PART;          // Part descriptor index (bus clock limits).
+    static const DigiPot_bus_type bus = BUS;        // Communication bus.
+    static const uint16_t n_steps = STEPS;          // Number of resistors in the ladder (full-scale code).
+    static const uint8_t n_wipers = WIPERS;         // Number of wipers.
+    static const bool rheostat = RHEOSTAT;          // True for rheostats, false for potentiometers.
+    static const bool nonvolatile = NV;             // True for parts with EEPROM.
+};
+
+//                     Part                   Bus              Steps  Wipers  Rheostat  NV
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4131,  DIGIPOT_BUS_SPI,  128,   1,      false,    false>  MCP4131_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4132,  DIGIPOT_BUS_SPI,  128,   1,      true,     false>  MCP4132_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4141,  DIGIPOT_BUS_SPI,  128,   1,      false,    true>   MCP4141_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4142,  DIGIPOT_BUS_SPI,  128,   1,      true,     true>   MCP4142_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4151,  DIGIPOT_BUS_SPI,  256,   1,      false,    false>  MCP4151_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4152,  DIGIPOT_BUS_SPI,  256,   1,      true,     false>  MCP4152_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4161,  DIGIPOT_BUS_SPI,  256,   1,      false,    true>   MCP4161_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4162,  DIGIPOT_BUS_SPI,  256,   1,      true,     true>   MCP4162_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4231,  DIGIPOT_BUS_SPI,  128,   2,      false,    false>  MCP4231_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4232,  DIGIPOT_BUS_SPI,  128,   2,      true,     false>  MCP4232_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4241,  DIGIPOT_BUS_SPI,  128,   2,      false,    true>   MCP4241_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4242,  DIGIPOT_BUS_SPI,  128,   2,      true,     true>   MCP4242_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4251,  DIGIPOT_BUS_SPI,  256,   2,      false,    false>  MCP4251_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4252,  DIGIPOT_BUS_SPI,  256,   2,      true,     false>  MCP4252_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4261,  DIGIPOT_BUS_SPI,  256,   2,      false,    true>   MCP4261_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4262,  DIGIPOT_BUS_SPI,  256,   2,      true,     true>   MCP4262_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4531,  DIGIPOT_BUS_I2C,  128,   1,      false,    false>  MCP4531_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4532,  DIGIPOT_BUS_I2C,  128,   1,      true,     false>  MCP4532_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4541,  DIGIPOT_BUS_I2C,  128,   1,      false,    true>   MCP4541_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4542,  DIGIPOT_BUS_I2C,  128,   1,      true,     true>   MCP4542_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4551,  DIGIPOT_BUS_I2C,  256,   1,      false,    false>  MCP4551_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4552,  DIGIPOT_BUS_I2C,  256,   1,      true,     false>  MCP4552_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4561,  DIGIPOT_BUS_I2C,  256,   1,      false,    true>   MCP4561_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4562,  DIGIPOT_BUS_I2C,  256,   1,      true,     true>   MCP4562_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4631,  DIGIPOT_BUS_I2C,  128,   2,      false,    false>  MCP4631_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4632,  DIGIPOT_BUS_I2C,  128,   2,      true,     false>  MCP4632_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4641,  DIGIPOT_BUS_I2C,  128,   2,      false,    true>   MCP4641_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4642,  DIGIPOT_BUS_I2C,  128,   2,      true,     true>   MCP4642_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4651,  DIGIPOT_BUS_I2C,  256,   2,      false,    false>  MCP4651_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4652,  DIGIPOT_BUS_I2C,  256,   2,      true,     false>  MCP4652_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4661,  DIGIPOT_BUS_I2C,  256,   2,      false,    true>   MCP4661_traits;
+typedef MCP4xxx_traits<DIGIPOT_PART_MCP4662,  DIGIPOT_BUS_I2C,  256,   2,      true,     true>   MCP4662_traits;
+
+
+// CLASSES ***********************************************************************************************************// 
+
+// Bus access, specialized per bus type so the unused bus compiles away.
+template <DigiPot_bus_type BUS> class MCP4xxx_static_bus;
+
+
+template <> class MCP4xxx_static_bus<DIGIPOT_BUS_SPI> {
+
+    public:
+
+        MCP4xxx_static_bus(uint8_t pin_cs, SPIClass *spi_bus = &SPI) 
+            : _spi_bus(spi_bus), _bus(NULL), _cs(pin_cs), _clock(DIGIPOT_SPI_DEFAULT_HZ), _sdo_mux(false), \
+              _status(DIGIPOT_OK)
+        { 
+            //empty
+        }
+
+        // Initialization.
+        uint8_t begin(void)
+        {
+            _bus = Vulintus_DigiPot_Bus::get(_spi_bus); // Attach to the shared transport for this bus.
+            if (_bus == NULL) {                         // If no transport is available...
+                return DIGIPOT_ERR_NO_BUS;              // Return the error.
+            }
+            _bus->begin();                              // Initialize the SPI bus (once per bus).
+            _bus->spi_cs_init(_cs);                     // Set the CS pin to an output, high, and resolve its port.
+            return DIGIPOT_OK;                          // SPI has no acknowledge, so always succeed.
+        }
+
+        // Send a 16-bit command, returning the 9-bit reply (or 0xFFFF on error, with the cause in "status").
+        uint16_t command16(uint8_t hi_byte, uint8_t lo_byte)
+        {
+            if (_bus == NULL) {                         // If "begin" hasn't been called...
+                _status = DIGIPOT_ERR_NO_BUS;           // Report a missing bus.
+                return 0xFFFF;                          // Return a value of 65535.
+            }
+            uint8_t buf[2] = {hi_byte, lo_byte};        // Command and data bytes (replies come back in place).
+            _bus->spi_select(_cs, spi_clock((hi_byte & 0x0C) == MCP4XXX_CMD_READ), MSBFIRST, SPI_MODE0);
+            _bus->spi_transfer(buf, 2);                 // Send both bytes in one block.
+            _status = _bus->spi_deselect(_cs);          // End the transaction (returns any transfer error).
+            if ((_status == DIGIPOT_OK) && !(buf[0] & MCP4XXX_SPI_CMDERR)) {   // If the chip pulled CMDERR low...
+                _status = DIGIPOT_ERR_BUS;              // The command was rejected.
+            }
+            if (_status) {                              // If the command failed...
+                return 0xFFFF;                          // Return a value of 65535.
+            }
+            return ((buf[0] << 8) | buf[1]) & 0x01FF;
+        }
+
+        // Send an 8-bit command (increment, decrement).
+        uint8_t command8(uint8_t hi_byte)
+        {
+            if (_bus == NULL) {                         // If "begin" hasn't been called...
+                return DIGIPOT_ERR_NO_BUS;              // Return the error.
+            }
+            _bus->spi_select(_cs, spi_clock(false), MSBFIRST, SPI_MODE0);
+            uint8_t reply = _bus->spi_transfer(hi_byte);    // Send the command byte.
+            uint8_t status = _bus->spi_deselect(_cs);   // End the transaction (returns any transfer error).
+            if ((status == DIGIPOT_OK) && !(reply & MCP4XXX_SPI_CMDERR)) {     // If the chip pulled CMDERR low...
+                status = DIGIPOT_ERR_BUS;               // The command was rejected.
+            }
+            return status;
+        }
+
+        // Write a register, returning 0 on success.
+        uint8_t write(uint8_t hi_byte, uint8_t lo_byte)
+        {
+            command16(hi_byte, lo_byte);                // Send the command.
+            return _status;                             // Return the command's status.
+        }
+
+        // Set the clock rate (already clamped to the part's limit), and note a shared SDI/SDO pin.
+        void set_clock(uint32_t clock, uint8_t part_flags)
+        {
+            _clock = clock;
+            _sdo_mux = (part_flags & DIGIPOT_PART_FLAG_SDO_MUX) != 0;
+        }
+
+        uint32_t get_clock(void) { return _clock; }
+        void *handle(void) { return (void *) _spi_bus; }
+        uint8_t address(void) { return _cs.pin; }
+        DigiPot_status status(void) { return _status; }     // Status of the last "command16".
+
+    private:
+
+        SPIClass *_spi_bus;             // SPI interface pointer.
+        Vulintus_DigiPot_Bus *_bus;     // Shared bus transport.
+        DigiPot_cs _cs;                 // Chip select pin, resolved to its port register.
+        uint32_t _clock;                // Bus clock rate (Hz).
+        bool _sdo_mux;                  // Flag indicating SDI and SDO share one pin (MCP41x1).
+        DigiPot_status _status;         // Status of the last "command16".
+
+        // SPI clock rate for a transaction (reads through a shared SDI/SDO pin are slower).
+        uint32_t spi_clock(bool has_read)
+        {
+            if (has_read && _sdo_mux && (_clock > DIGIPOT_SPI_MUX_READ_HZ)) {
+                return DIGIPOT_SPI_MUX_READ_HZ;         // Slow down for the shared pin's pull-up.
+            }
+            return _clock;
+        }
+
+};
+
+
+template <> class MCP4xxx_static_bus<DIGIPOT_BUS_I2C> {
+
+    public:
+
+        MCP4xxx_static_bus(uint8_t i2c_addr = MCP4XXX_I2C_ADDR_HHL, TwoWire *i2c_bus = &Wire) 
+            : _i2c_bus(i2c_bus), _bus(NULL), _i2c_addr(i2c_addr), _clock(DIGIPOT_I2C_FAST_HZ), _status(DIGIPOT_OK)
+        { 
+            //empty
+        }
+
+        // Initialization.
+        uint8_t begin(void)
+        {
+            _bus = Vulintus_DigiPot_Bus::get(_i2c_bus); // Attach to the shared transport for this bus.
+            if (_bus == NULL) {                         // If no transport is available...
+                return DIGIPOT_ERR_NO_BUS;              // Return the error.
+            }
+            _bus->begin();                              // Initialize the I2C bus (once per bus).
+            return _bus->i2c_probe(_i2c_addr, _clock);     // Check for an ACK from the chip.
+        }
+
+        // Send a read command, returning the 9-bit reply (or 0xFFFF on error, with the cause in "status"). I2C reads only send the command byte.
+        uint16_t command16(uint8_t hi_byte, uint8_t /* lo_byte */)
+        {
+            uint8_t rx[2];                              // Reply bytes.
+            if (_bus == NULL) {                         // If "begin" hasn't been called...
+                _status = DIGIPOT_ERR_NO_BUS;           // Report a missing bus.
+                return 0xFFFF;                          // Return a value of 65535.
+            }
+            _status = _bus->i2c_write_read(_i2c_addr, &hi_byte, 1, rx, 2, _clock);    // Send the command and read the reply.
+            if (_status) {                              // If the read failed...
+                return 0xFFFF;                          // Return a value of 65535.
+            }
+            return ((rx[0] << 8) | rx[1]) & 0x01FF;
+        }
+
+        // Send an 8-bit command (increment, decrement).
+        uint8_t command8(uint8_t hi_byte)
+        {
+            if (_bus == NULL) {                         // If "begin" hasn't been called...
+                return DIGIPOT_ERR_NO_BUS;              // Return the error.
+            }
+            return _bus->i2c_write(_i2c_addr, &hi_byte, 1, _clock, false);  // Never retried (not idempotent).
+        }
+
+        // Write a register, returning 0 on success.
+        uint8_t write(uint8_t hi_byte, uint8_t lo_byte)
+        {
+            uint8_t tx[2] = {hi_byte, lo_byte};         // Command and data bytes.
+            if (_bus == NULL) {                         // If "begin" hasn't been called...
+                return DIGIPOT_ERR_NO_BUS;              // Return the error.
+            }
+            return _bus->i2c_write(_i2c_addr, tx, 2, _clock);
+        }
+
+        // Set the clock rate (already clamped to the part's limit).
+        void set_clock(uint32_t clock, uint8_t /* part_flags */)
+        {
+            _clock = clock;
+        }
+
+        uint32_t get_clock(void) { return _clock; }
+        void *handle(void) { return (void *) _i2c_bus; }
+        uint8_t address(void) { return _i2c_addr; }
+        DigiPot_status status(void) { return _status; }     // Status of the last "command16".
+
+    private:
+
+        TwoWire *_i2c_bus;              // I2C interface pointer.
+        Vulintus_DigiPot_Bus *_bus;     // Shared bus transport.
+        uint8_t _i2c_addr;              // I2C address.
+        uint32_t _clock;                // Bus clock rate (Hz).
+        DigiPot_status _status;         // Status of the last "command16".
+
+};
+
+
+// Driver, specialized on the part traits.
+template <class TRAITS> class Vulintus_MCP4xxx_Static {
+
+	public:
+
+        typedef TRAITS traits;          // Part traits.
+
+		// Constructor (same arguments as the matching runtime driver). // 
+        template <class... ARGS>
+        Vulintus_MCP4xxx_Static(ARGS... args) 
+            : _bus(args...)
+        {
+            _cache_valid = 0;           // No wiper values are known yet.
+            _status = DIGIPOT_OK;       // No errors yet.
+            DigiPot_part_desc desc;     // Part descriptor.
+            digipot_part_read(TRAITS::part, &desc);     // Load the part's typical resistances from flash.
+            wiper_resistance = desc.wiper_ohms;
+            max_resistance = digipot_rab_ohms(DIGIPOT_RAB_10K);    // Default to the 10 kOhm option (made for every supported part).
+            _bus.set_clock((TRAITS::bus == DIGIPOT_BUS_SPI) ? DIGIPOT_SPI_DEFAULT_HZ : DIGIPOT_I2C_FAST_HZ, \
+                    digipot_part_flags(TRAITS::part));     // Default bus clock rate.
+        }
+
+        // Copy constructors (declared so copies of non-const drivers don't match the constructor template). //
+        Vulintus_MCP4xxx_Static(const Vulintus_MCP4xxx_Static &) = default;
+        Vulintus_MCP4xxx_Static(Vulintus_MCP4xxx_Static &) = default;
+
+        // Public variables. //
+        float wiper_resistance;         // Wiper resistance, in ohms (typical value from the part descriptor).
+        float max_resistance;           // Maximum resistance (not counting wiper), in ohms.
+
+        // Initialization.
+        uint8_t begin(void)
+        {
+            uint8_t error = _bus.begin();               // Initialize the bus and check for the chip.
+            _status = (DigiPot_status) error;           // Save the status.
+            _cache_valid = 0;                           // Forget any cached values.
+            if (!error) {                               // If the chip responded...
+                for (uint8_t i = 0; i < TRAITS::n_wipers; i++) {    // Load the current wiper values.
+                    read_any(i);
+                }
+            }
+            return error;
+        }
+
+        // Set the bus clock rate, in Hz (0 for the part's maximum; returns the rate used).
+        uint32_t set_clock(uint32_t clock)
+        {
+            uint32_t max_clock = digipot_part_max_clock(TRAITS::part);     // Fetch the part's limit.
+            if ((TRAITS::bus == DIGIPOT_BUS_I2C) && (max_clock > DIGIPOT_I2C_MAX_HZ)) {   // If the core can't run I2C that fast...
+                max_clock = DIGIPOT_I2C_MAX_HZ;         // Use the core's limit.
+            }
+            if ((clock == 0) || (clock > max_clock)) {  // If the rate is unset or too fast...
+                clock = max_clock;                      // Use the fastest supported rate.
+            }
+            else if (clock < DIGIPOT_BUS_MIN_HZ) {      // If the rate is too slow...
+                clock = DIGIPOT_BUS_MIN_HZ;             // Use the slowest supported rate.
+            }
+            _bus.set_clock(clock, digipot_part_flags(TRAITS::part));
+            return clock;
+        }
+
+        // Bus clock rate, in Hz.
+        uint32_t get_clock(void) { return _bus.get_clock(); }
+
+        // Select one of the part's end-to-end resistance options.
+        bool set_nominal_resistance(DigiPot_rab rab)
+        {
+            DigiPot_part_desc desc;                     // Part descriptor.
+            uint32_t ohms = digipot_rab_ohms(rab);      // Convert the option to ohms.
+            if ((ohms == 0) || !digipot_part_read(TRAITS::part, &desc) || !(desc.rab_options & rab)) {
+                return false;                           // The part isn't made in this resistance.
+            }
+            max_resistance = ohms;                      // Set the ladder resistance.
+            return true;
+        }
+
+        // Status of the last bus operation (the cause of a 0xFFFF/DIGIPOT_CODE_INVALID return).
+        DigiPot_status status(void) { return _status; }
+
+        // Write a wiper value.
+        template <uint8_t W = 0> uint8_t write(uint16_t value)
+        {
+            static_assert(W < TRAITS::n_wipers, "Wiper index out of range for this part.");
+            return write_any(value, W);
+        }
+
+        // Read a wiper value from the chip (returns 0xFFFF on error).
+        template <uint8_t W = 0> uint16_t read(void)
+        {
+            static_assert(W < TRAITS::n_wipers, "Wiper index out of range for this part.");
+            return read_any(W);
+        }
+
+        // Increment a wiper.
+        template <uint8_t W = 0> uint8_t increment(void)
+        {
+            static_assert(W < TRAITS::n_wipers, "Wiper index out of range for this part.");
+            uint8_t error = _bus.command8(reg(W) | MCP4XXX_CMD_INCR);
+            _status = (DigiPot_status) error;           // Save the status.
+            if (error) {                                // If the command failed...
+                _cache_valid &= ~(1 << W);              // The wiper position is unknown.
+            }
+            else if ((_cache_valid & (1 << W)) && (_cache[W] < TRAITS::n_steps)) {
+                _cache[W]++;
+            }
+            return error;
+        }
+
+        // Decrement a wiper.
+        template <uint8_t W = 0> uint8_t decrement(void)
+        {
+            static_assert(W < TRAITS::n_wipers, "Wiper index out of range for this part.");
+            uint8_t error = _bus.command8(reg(W) | MCP4XXX_CMD_DECR);
+            _status = (DigiPot_status) error;           // Save the status.
+            if (error) {                                // If the command failed...
+                _cache_valid &= ~(1 << W);              // The wiper position is unknown.
+            }
+            else if ((_cache_valid & (1 << W)) && (_cache[W] > 0)) {
+                _cache[W]--;
+            }
+            return error;
+        }
+
+        // Write a wiper value, in steps, skipping the bus if it's unchanged.
+        template <uint8_t W = 0> uint16_t set_code(uint16_t code)
+        {
+            static_assert(W < TRAITS::n_wipers, "Wiper index out of range for this part.");
+            return set_code_any(code, W);
+        }
+
+        // Read a wiper value, in steps, from the cache if possible.
+        template <uint8_t W = 0> uint16_t get_code(void)
+        {
+            static_assert(W < TRAITS::n_wipers, "Wiper index out of range for this part.");
+            return (_cache_valid & (1 << W)) ? _cache[W] : read_any(W);
+        }
+
+        // Write a wiper value, scaled 0-1.
+        template <uint8_t W = 0> float set_scaled(float float_scaled)
+        {
+            if (float_scaled < 0) {
+                float_scaled = 0;
+            }
+            float_scaled = float_scaled * 65536.0 + 0.5;    // Convert to a rounded Q16 position (as the runtime drivers do).
+            uint32_t ratio = (float_scaled >= 65535.0) ? 0xFFFF : (uint32_t) float_scaled;
+            uint16_t code = set_code<W>((ratio * TRAITS::n_steps + 0x8000) >> 16);    // Round to the nearest step.
+            return code_to_scaled(code);
+        }
+
+        // Read a wiper value, scaled 0-1.
+        template <uint8_t W = 0> float get_scaled(void)
+        {
+            return code_to_scaled(get_code<W>());
+        }
+
+        // Write a wiper value, in real resistance (ohms).
+        template <uint8_t W = 0> float set_resistance(float float_ohms)
+        {
+            float_ohms = (float_ohms > wiper_resistance) ? ((float_ohms - wiper_resistance) / max_resistance) : 0;
+            float_ohms = float_ohms * TRAITS::n_steps + 0.5;    // Round to the nearest step.
+            uint16_t code = set_code<W>((float_ohms >= TRAITS::n_steps) ? TRAITS::n_steps : (uint16_t) float_ohms);
+            return code_to_resistance(code);
+        }
+
+        // Read a wiper value, in real resistance (ohms).
+        template <uint8_t W = 0> float get_resistance(void)
+        {
+            return code_to_resistance(get_code<W>());
+        }
+
+        // Runtime-indexed access, used by "Vulintus_DigiPot_Adapter". Out-of-range indices are rejected.
+        uint8_t write_any(uint16_t value, uint8_t wiper_i)
+        {
+            if (wiper_i >= TRAITS::n_wipers) {
+                _status = DIGIPOT_ERR_WIPER;
+                return _status;
+            }
+            if (value > TRAITS::n_steps) {
+                value = TRAITS::n_steps;
+            }
+            uint8_t error = _bus.write(reg(wiper_i) | MCP4XXX_CMD_WRITE | (value >> 8), value & 0xFF);
+            _status = (DigiPot_status) error;
+            if (!error) {
+                _cache[wiper_i] = value;
+                _cache_valid |= (1 << wiper_i);
+            }
+            else {
+                _cache_valid &= ~(1 << wiper_i);
+            }
+            return error;
+        }
+
+        uint16_t read_any(uint8_t wiper_i)
+        {
+            if (wiper_i >= TRAITS::n_wipers) {
+                _status = DIGIPOT_ERR_WIPER;
+                return DIGIPOT_CODE_INVALID;
+            }
+            uint16_t value = _bus.command16(reg(wiper_i) | MCP4XXX_CMD_READ | 0x01, 0xFF);
+            _status = _bus.status();
+            if ((_status == DIGIPOT_OK) && (value > TRAITS::n_steps)) {    // If the chip returned an out-of-range value...
+                _status = DIGIPOT_ERR_BUS;              // Report an "other" error.
+            }
+            if (_status == DIGIPOT_OK) {
+                _cache[wiper_i] = value;
+                _cache_valid |= (1 << wiper_i);
+                return value;
+            }
+            _cache_valid &= ~(1 << wiper_i);
+            return DIGIPOT_CODE_INVALID;
+        }
+
+        uint16_t get_code_any(uint8_t wiper_i)
+        {
+            if (wiper_i >= TRAITS::n_wipers) {
+                _status = DIGIPOT_ERR_WIPER;
+                return DIGIPOT_CODE_INVALID;
+            }
+            return (_cache_valid & (1 << wiper_i)) ? _cache[wiper_i] : read_any(wiper_i);
+        }
+
+        uint16_t set_code_any(uint16_t code, uint8_t wiper_i)
+        {
+            if (wiper_i >= TRAITS::n_wipers) {
+                _status = DIGIPOT_ERR_WIPER;
+                return DIGIPOT_CODE_INVALID;
+            }
+            if (code > TRAITS::n_steps) {
+                code = TRAITS::n_steps;
+            }
+            if ((_cache_valid & (1 << wiper_i)) && (_cache[wiper_i] == code)) {
+                return code;                            // Skip the bus entirely.
+            }
+            return write_any(code, wiper_i) ? DIGIPOT_CODE_INVALID : code;
+        }
+
+        void *bus_handle(void) { return _bus.handle(); }
+        uint8_t bus_address(void) { return _bus.address(); }
+
+    private:
+
+        MCP4xxx_static_bus<TRAITS::bus> _bus;           // Bus access.
+        uint16_t _cache[TRAITS::n_wipers];              // Last known wiper values.
+        uint8_t _cache_valid;                           // Bitmask of known wiper values.
+        DigiPot_status _status;                         // Status of the last bus operation.
+
+        static uint8_t reg(uint8_t wiper_i) 
+        { 
+            return (wiper_i > 0) ? MCP4XXX_REG_WIPER1 : MCP4XXX_REG_WIPER0;
+        }
+
+        float code_to_scaled(uint16_t code)
+        {
+            if (code == DIGIPOT_CODE_INVALID) {
+                return (float) -1;
+            }
+            return (((float) code / TRAITS::n_steps) * max_resistance + wiper_resistance) / (wiper_resistance + max_resistance);
+        }
+
+        float code_to_resistance(uint16_t code)
+        {
+            if (code == DIGIPOT_CODE_INVALID) {
+                return (float) -1;
+            }
+            return ((float) code / TRAITS::n_steps) * max_resistance + wiper_resistance;
+        }
+
+};
+
+
+// Runtime-polymorphic adapter for a static driver.
+template <class DRIVER> class Vulintus_DigiPot_Adapter : public Vulintus_DigiPot {
+
+    public:
+
+        Vulintus_DigiPot_Adapter(DRIVER *driver) 
+            : _driver(driver)
+        {
+            n_resistors = DRIVER::traits::n_steps;      // Copy the part traits.
+            n_wipers = DRIVER::traits::n_wipers;
+            wiper_resistance = driver->wiper_resistance;
+            max_resistance = driver->max_resistance;
+        }
+
+        uint8_t begin(void)
+        {
+            uint8_t error = _driver->begin();           // Initialize the driver (reads the wipers).
+            _status = (DigiPot_status) error;           // Save the status.
+            clear_cache();
+            if (!error) {
+                for (uint8_t i = 0; i < n_wipers; i++) {    // Copy the driver's wiper values into the adapter's cache.
+                    uint16_t code = _driver->get_code_any(i);
+                    if (code <= n_resistors) {
+                        cache_store(i, code);
+                    }
+                }
+            }
+            return error;
+        }
+
+        void *bus_handle(void) { return _driver->bus_handle(); }
+        uint8_t bus_address(void) { return _driver->bus_address(); }
+
+    protected:
+
+        uint8_t bus_write(uint16_t code, uint8_t wiper_i) { return _status = (DigiPot_status) _driver->write_any(code, wiper_i); }
+        uint16_t bus_read(uint8_t wiper_i)
+        {
+            uint16_t code = _driver->read_any(wiper_i); // Read the wiper.
+            _status = _driver->status();                // Save the status.
+            return code;
+        }
+
+    private:
+
+        DRIVER *_driver;                                // Wrapped static driver.
+
+};
+
+
+#endif      // #ifndef VULINTUS_MCP4XXX_STATIC_H
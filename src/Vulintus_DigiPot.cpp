@@ -7,49 +7,1067 @@
 	
 	UPDATE LOG:
 		2024-07-08 - Drew Sloan	- Created "Vulintus_DigiPot" base class.						  
+		2026-10-17 - Drew Sloan - Added the wiper shadow cache.
+		2026-10-17 - Drew Sloan - Added the shared bus transport and status code.
+		2026-10-17 - Drew Sloan - Added asynchronous (queued) mode.
+		2026-10-17 - Drew Sloan - Added the successive-approximation tuner.
+		2026-10-17 - Drew Sloan - Added "code_resistance" for composite pots.
+		2026-10-17 - Drew Sloan - Added optional performance counters.
+		2026-10-17 - Drew Sloan - Added the typed-status "try_" functions.
+		2026-10-17 - Drew Sloan - Added the integer (milliohm and Q16) functions.
+		2026-10-17 - Drew Sloan - Added per-device bus clock rates.
+		2026-10-17 - Drew Sloan - Added "worst_case_us".
+		2026-10-17 - Drew Sloan - Failed flushes keep their staged targets.
 */
 
 
 #include "./Vulintus_DigiPot.h"
 
 
-// Class Constructor. //
+// Class Constructor.
 Vulintus_DigiPot::Vulintus_DigiPot(void)
 {
-
+    wiper_resistance.mohm = 75000;          // Default wiper resistance, 75 ohms.
+    max_resistance.mohm = 10000000;         // Default maximum resistance, 10 kOhms.
+    n_resistors = 128;                      // Default number of resistors in the ladder.
+    n_wipers = 1;                           // Assume a single wiper.
+    _cal = NULL;                            // Use the linear model until a calibration is set.
+    _bus = NULL;                            // The transport is attached in "begin".
+    _status = DIGIPOT_OK;                   // No errors yet.
+    _part = DIGIPOT_PART_NONE;              // No part descriptor until a driver loads one.
+    _clock = DIGIPOT_I2C_FAST_HZ;           // Default bus clock rate.
+    _cache_valid = 0;                       // No wiper values are known yet.
+    _verify_mode = DIGIPOT_VERIFY_NEVER;    // Trust the cache by default.
+    _verify_n = 1;                          // Verify every write if verification is enabled.
+    _verify_count = 0;                      // Reset the write counter.
+    _queue = NULL;                          // Start in blocking mode.
+    _callback = NULL;
+    _callback_context = NULL;
+    _draining = false;
+    _dirty = 0;                             // Nothing is staged...
+    _flushed = 0;
+    _staged_mode = false;                   // ...and writes go straight to the bus.
+    n_superseded = 0;
+    DIGIPOT_STAT(digipot_stats_clear(&_stats));    // Zero the performance counters.
 }
 
 
-// Class Destructor. //
+// Class Destructor.
 Vulintus_DigiPot::~Vulintus_DigiPot(void)
 {
 
 }
 
 
+// Write the Wiper 0 value, scaled 0-1.
+float Vulintus_DigiPot::set_scaled(float float_scaled)
+{
+    return set_scaled(float_scaled, (uint8_t) 0);       // Write the value to wiper 0.
+}
+
+
+// Write the specified wiper value, scaled 0-1.
+float Vulintus_DigiPot::set_scaled(float float_scaled, uint8_t wiper_i)
+{
+    if (float_scaled < 0) {                         // If the scaled value is negative...
+        float_scaled = 0;                           // Set the scaled value to zero.
+    }
+    float_scaled = float_scaled * 65536.0 + 0.5;    // Convert to a rounded Q16 position.
+    uint16_t ratio = (float_scaled >= 65535.0) ? 0xFFFF : (uint16_t) float_scaled;    // Clip it to full scale.
+    if (set_ratio_q16(ratio, wiper_i) == DIGIPOT_Q16_INVALID) {    // Write the value. If the write failed...
+        return (float) -1;                          // Return -1.
+    }
+    return get_scaled(wiper_i, false);              // Return the actual scaled value.
+}
+
+
 // Read the Wiper 0 value, scaled 0-1.
 float Vulintus_DigiPot::get_scaled(void)
 {
-    return (float) -1;
+    return get_scaled((uint8_t) 0, false);          // Read the value from wiper 0.
 }
 
 
 // Read the specified wiper value, scaled 0-1.
 float Vulintus_DigiPot::get_scaled(uint8_t wiper_i)
 {
-    return (float) -1;
+    return get_scaled(wiper_i, false);              // Read the value from the cache, if possible.
+}
+
+
+// Read the specified wiper value, scaled 0-1, optionally from the chip.
+float Vulintus_DigiPot::get_scaled(uint8_t wiper_i, bool hw_read)
+{
+    return mohm_to_scaled(get_milliohms(wiper_i, hw_read));    // Fetch the resistance and scale it.
+}
+
+
+// Write the Wiper 0 value, in real resistance (ohms).
+float Vulintus_DigiPot::set_resistance(float float_ohms)
+{
+    return set_resistance(float_ohms, (uint8_t) 0);     // Set the resistance (ohms) on wiper 0.
+}
+
+
+// Write the specified wiper value, in real resistance (ohms).
+float Vulintus_DigiPot::set_resistance(float float_ohms, uint8_t wiper_i)
+{
+    uint32_t mohm = set_milliohms(digipot_ohms_to_mohm(float_ohms), wiper_i);  // Write the value in milliohms.
+    if (mohm == DIGIPOT_MOHM_INVALID) {             // If the write failed...
+        return (float) -1;                          // Return -1.
+    }
+    return mohm * 0.001;                            // Return the actual resistance.
 }
 
 
-// Read the Wiper 0 value, in real resistance.
+// Read the Wiper 0 value, in real resistance (ohms).
 float Vulintus_DigiPot::get_resistance(void)
 {
-    return (float) -1;
+    return get_resistance((uint8_t) 0, false);      // Fetch the resistance from wiper 0.
 }
 
 
-// Read the specified wiper value, in real resistance.
+// Read the specified wiper value, in real resistance (ohms).
 float Vulintus_DigiPot::get_resistance(uint8_t wiper_i)
 {
-    return (float) -1;
-}
\ No newline at end of file
+    return get_resistance(wiper_i, false);          // Read the value from the cache, if possible.
+}
+
+
+// Read the specified wiper value, in real resistance (ohms), optionally from the chip.
+float Vulintus_DigiPot::get_resistance(uint8_t wiper_i, bool hw_read)
+{
+    uint32_t mohm = get_milliohms(wiper_i, hw_read);    // Fetch the resistance in milliohms.
+    if (mohm == DIGIPOT_MOHM_INVALID) {             // If the read failed...
+        return (float) -1;                          // Return -1.
+    }
+    return mohm * 0.001;                            // Return the resistance.
+}
+
+
+// Write a wiper value, in milliohms (returns the actual resistance).
+uint32_t Vulintus_DigiPot::set_milliohms(uint32_t mohm, uint8_t wiper_i)
+{
+    uint16_t code = set_code(mohm_to_code(mohm), wiper_i);     // Write the nearest code.
+    return code_to_mohm(code);                      // Return the actual resistance.
+}
+
+
+// Read a wiper value, in milliohms.
+uint32_t Vulintus_DigiPot::get_milliohms(uint8_t wiper_i, bool hw_read)
+{
+    return code_to_mohm(get_code(wiper_i, hw_read));    // Fetch the wiper value and convert it.
+}
+
+
+// Write a wiper position, 0-0xFFFF (0xFFFF is full scale; returns the actual position, 0-DIGIPOT_Q16_ONE).
+uint32_t Vulintus_DigiPot::set_ratio_q16(uint16_t ratio, uint8_t wiper_i)
+{
+    uint16_t code = ((uint32_t) ratio * n_resistors + 0x8000) >> 16;   // Round to the nearest step (no division needed).
+    if (ratio == 0xFFFF) {                          // 1.0 doesn't fit in 16 bits, so 0xFFFF stands for full scale...
+        code = n_resistors;                         // ...even on ladders longer than 0x8000 steps.
+    }
+    code = set_code(code, wiper_i);                 // Write the value to the specified wiper.
+    return code_to_q16(code);                       // Return the actual position.
+}
+
+
+// Read a wiper position, 0-DIGIPOT_Q16_ONE.
+uint32_t Vulintus_DigiPot::get_ratio_q16(uint8_t wiper_i, bool hw_read)
+{
+    return code_to_q16(get_code(wiper_i, hw_read)); // Fetch the wiper value and convert it.
+}
+
+
+// Write the Wiper 0 value, in steps.
+uint16_t Vulintus_DigiPot::set_code(uint16_t code)
+{
+    return set_code(code, (uint8_t) 0);             // Write the value to wiper 0.
+}
+
+
+// Write the specified wiper value, in steps.
+uint16_t Vulintus_DigiPot::set_code(uint16_t code, uint8_t wiper_i)
+{
+    if (!wiper_valid(wiper_i)) {                    // If the chip doesn't have this wiper...
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    uint8_t i = wiper_i;                            // Grab the cache index for this wiper.
+    if (code > n_resistors) {                       // If the value is out of range...
+        code = n_resistors;                         // Clip it to the top of the ladder.
+    }
+    if (_staged_mode && (_dirty & (1 << i))) {      // If a target is already staged for this wiper...
+        _staged[i] = code;                          // Replace it.
+        n_superseded++;                             // Count the value that will never reach the bus.
+        return code;                                // Return the staged value.
+    }
+    if ((_cache_valid & (1 << i)) && (_wiper_cache[i] == code)) {   // If the wiper is already at this value...
+        DIGIPOT_STAT(_stats.n_skipped_writes++);    // Count the skipped write.
+        return code;                                // Skip the bus write entirely.
+    }
+    if (_staged_mode) {                             // If writes are held until "flush"...
+        _staged[i] = code;                          // Stage the target.
+        _dirty |= (1 << i);                         // Mark the wiper as changed.
+        return code;                                // Return the staged value.
+    }
+    DIGIPOT_STAT(DigiPot_stats_mark mark = stats_mark());  // Start timing the write.
+    uint8_t error = bus_write(code, wiper_i);       // Write the value.
+    DIGIPOT_STAT(stats_add(mark));                  // Charge the write to this device.
+    if (error == DIGIPOT_PENDING) {                 // If the write was queued...
+        cache_store(wiper_i, code);                 // Save the pending value (cleared if the write fails).
+        return code;                                // Return the queued value.
+    }
+    if (error) {                                    // If the write failed...
+        _cache_valid &= ~(1 << i);                  // The wiper value is now unknown.
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    cache_store(wiper_i, code);                     // Save the written value.
+    if (verify_due()) {                             // If this write should be verified...
+        return get_code(wiper_i, true);             // Read back the actual value from the chip.
+    }
+    return code;                                    // Return the written value.
+}
+
+
+// Write several wipers at once, in steps.
+uint8_t Vulintus_DigiPot::set_codes(const uint16_t *codes, uint8_t wiper_mask)
+{
+    uint16_t clipped[DIGIPOT_MAX_WIPERS];           // Range-checked values.
+    uint8_t write_mask = 0;                         // Wipers that actually need a write.
+    if (wiper_mask >> n_wipers) {                   // If the mask includes wipers the chip doesn't have...
+        _status = DIGIPOT_ERR_WIPER;                // Report the bad wiper index.
+        return _status;                             // Return the error code.
+    }
+    if (_staged_mode) {                             // If writes are held until "flush"...
+        for (uint8_t i = 0; i < n_wipers; i++) {    // Stage each specified wiper.
+            if (wiper_mask & (1 << i)) {
+                set_code(codes[i], i);
+            }
+        }
+        return 0;                                   // Nothing was sent, so nothing failed.
+    }
+    for (uint8_t i = 0; i < n_wipers; i++) {        // Step through the wipers.
+        if (!(wiper_mask & (1 << i))) {             // Skip wipers that weren't specified.
+            continue;
+        }
+        clipped[i] = (codes[i] > n_resistors) ? n_resistors : codes[i];     // Clip the value to the top of the ladder.
+        if (!(_cache_valid & (1 << i)) || (_wiper_cache[i] != clipped[i])) {    // If the wiper isn't already at this value...
+            write_mask |= (1 << i);                 // Mark it for writing.
+        }
+        else {                                      // Otherwise...
+            DIGIPOT_STAT(_stats.n_skipped_writes++);    // Count the skipped write.
+        }
+    }
+    if (!write_mask) {                              // If no wipers need to change...
+        return 0;                                   // Skip the bus entirely.
+    }
+    DIGIPOT_STAT(DigiPot_stats_mark mark = stats_mark());  // Start timing the write.
+    uint8_t error = bus_write_multi(clipped, write_mask);   // Write the changed wipers.
+    DIGIPOT_STAT(stats_add(mark));                  // Charge the write to this device.
+    if (error == DIGIPOT_PENDING) {                 // If the writes were queued...
+        for (uint8_t i = 0; i < n_wipers; i++) {    // Step through the wipers.
+            if (write_mask & (1 << i)) {            // If this wiper was queued...
+                cache_store(i, clipped[i]);         // Save the pending value (cleared if the write fails).
+            }
+        }
+        return error;                               // Return the pending status.
+    }
+    if (error) {                                    // If the write failed...
+        _cache_valid &= ~write_mask;                // The wiper values are now unknown.
+        return error;                               // Return the error code.
+    }
+    bool verify = verify_due();                     // Check if this write should be verified.
+    for (uint8_t i = 0; i < n_wipers; i++) {        // Step through the wipers.
+        if (write_mask & (1 << i)) {                // If this wiper was written...
+            cache_store(i, clipped[i]);             // Save the written value.
+            if (verify && (get_code(i, true) != clipped[i])) {  // If verification is due and the read-back doesn't match...
+                error = DIGIPOT_ERR_BUS;            // Report an "other" error.
+            }
+        }
+    }
+    return error;                                   // Return the error code.
+}
+
+
+// Move a wiper to a value using the cheapest command sequence.
+uint16_t Vulintus_DigiPot::move_to(uint16_t code, uint8_t wiper_i)
+{
+    return set_code(code, wiper_i);                 // By default, use an absolute write.
+}
+
+
+// Binary-search the code that best matches a measured target.
+DigiPot_tune_result Vulintus_DigiPot::tune(DigiPot_measure_fn measure, const DigiPot_tune_config &config, \
+        uint8_t wiper_i, void *context)
+{
+    DigiPot_tune_result result;                     // Tuning results.
+    int32_t value;                                  // Measurement at the current code.
+    int32_t best_err = INT32_MAX;                   // Smallest absolute error seen so far.
+    uint16_t best_code = 0;                         // Code with the smallest error.
+    int32_t best_value = 0;                         // Measurement at the best code.
+    uint16_t lo_code = 0, hi_code = n_resistors;    // Codes bracketing the target.
+    int32_t lo_value = INT32_MIN, hi_value = INT32_MAX;     // Measurements at the bracketing codes (flipped if falling).
+    bool rising = (config.direction != DIGIPOT_TUNE_FALLING);   // Measurement direction.
+
+    result.n_writes = 0;                            // Nothing has been written or measured yet.
+    result.n_probes = 0;
+    result.measured = 0;
+    result.error = 0;
+    result.in_tolerance = false;                    // Only set once a final code has been measured.
+    result.monotonic = true;
+    result.status = DIGIPOT_OK;
+    result.code = DIGIPOT_CODE_INVALID;
+
+    if (config.direction == DIGIPOT_TUNE_AUTO) {    // If the direction should be measured...
+        int32_t zero_value, full_value;             // Measurements at each end of the ladder.
+        if (!tune_probe(0, wiper_i, measure, context, config, &result, &zero_value) || 
+                !tune_probe(n_resistors, wiper_i, measure, context, config, &result, &full_value)) {
+            return result;                          // Return if a write failed.
+        }
+        rising = (full_value >= zero_value);        // Check which way the measurement moves.
+        best_code = (abs(zero_value - config.target) <= abs(full_value - config.target)) ? 0 : n_resistors;
+        best_value = (best_code == 0) ? zero_value : full_value;
+        best_err = abs(best_value - config.target);
+        lo_value = rising ? zero_value : -zero_value;   // Both ends are measured, so they seed the bracket.
+        hi_value = rising ? full_value : -full_value;
+        if (lo_value >= (rising ? config.target : -config.target)) {   // If the target is at or below zero...
+            hi_code = 0;                            // There's nothing left to search.
+        }
+        else {                                      // Otherwise...
+            lo_code = 1;                            // Zero is below the target, so search above it.
+        }
+    }
+
+    while (lo_code < hi_code) {                     // Loop until the bracket closes.
+        uint16_t mid = (lo_code + hi_code) >> 1;    // Probe the middle of the bracket.
+        if (!tune_probe(mid, wiper_i, measure, context, config, &result, &value)) {
+            return result;                          // Return if a write failed.
+        }
+        int32_t err = value - config.target;        // Calculate the error.
+        if (abs(err) < best_err) {                  // If this is the best code so far...
+            best_err = abs(err);                    // Save it.
+            best_code = mid;
+            best_value = value;
+        }
+        if (best_err <= config.tolerance) {         // If the error is within tolerance...
+            break;                                  // Stop early.
+        }
+        int32_t v = rising ? value : -value;        // Flip falling measurements so they rise with the code.
+        if ((v < lo_value) || (v > hi_value)) {     // If the measurement falls outside the bracketing measurements...
+            result.monotonic = false;               // The measurement moved against the expected direction.
+        }
+        bool below = (v < (rising ? config.target : -config.target));  // Check if the target is above this code.
+        if (below) {                                // If the target is above this code...
+            lo_code = mid + 1;                      // Search the upper half.
+            lo_value = v;
+        }
+        else {                                      // Otherwise, if the target is at or below this code...
+            hi_code = mid;                          // Search the lower half.
+            hi_value = v;
+        }
+    }
+
+    if ((best_err > config.tolerance) && (hi_value == INT32_MAX)) {     // If the search closed on full scale without measuring it...
+        if (!tune_probe(lo_code, wiper_i, measure, context, config, &result, &value)) {
+            return result;                          // Return if a write failed.
+        }
+        if (abs(value - config.target) < best_err) {    // If it's the best code so far...
+            best_err = abs(value - config.target);  // Save it.
+            best_code = lo_code;
+            best_value = value;
+        }
+    }
+
+    if (get_code(wiper_i) != best_code) {           // If the wiper isn't at the best code...
+        if (!tune_probe(best_code, wiper_i, measure, context, config, &result, &best_value)) {
+            return result;                          // Return if a write failed.
+        }
+    }
+    result.code = best_code;                        // Report the final code.
+    result.measured = best_value;
+    result.error = best_value - config.target;
+    result.in_tolerance = (abs(result.error) <= config.tolerance);
+    return result;                                  // Return the results.
+}
+
+
+// Write a wiper value, in steps, returning the status.
+DigiPot_status Vulintus_DigiPot::try_set_code(uint16_t code, uint8_t wiper_i, uint16_t *actual)
+{
+    uint16_t result = set_code(code, wiper_i);      // Write the value.
+    if (actual != NULL) {                           // If the caller wants the written value...
+        *actual = result;                           // Return it.
+    }
+    return result_status(result == DIGIPOT_CODE_INVALID);  // Return the status.
+}
+
+
+// Read a wiper value, in steps, returning the status.
+DigiPot_status Vulintus_DigiPot::try_get_code(uint16_t *code, uint8_t wiper_i, bool hw_read)
+{
+    *code = get_code(wiper_i, hw_read);             // Read the value.
+    return result_status(*code == DIGIPOT_CODE_INVALID);   // Return the status.
+}
+
+
+// Write a wiper value, scaled 0-1, returning the status.
+DigiPot_status Vulintus_DigiPot::try_set_scaled(float float_scaled, uint8_t wiper_i, float *actual)
+{
+    float result = set_scaled(float_scaled, wiper_i);   // Write the value.
+    if (actual != NULL) {                           // If the caller wants the written value...
+        *actual = result;                           // Return it.
+    }
+    return result_status(result < 0);               // Return the status.
+}
+
+
+// Read a wiper value, scaled 0-1, returning the status.
+DigiPot_status Vulintus_DigiPot::try_get_scaled(float *float_scaled, uint8_t wiper_i, bool hw_read)
+{
+    *float_scaled = get_scaled(wiper_i, hw_read);   // Read the value.
+    return result_status(*float_scaled < 0);        // Return the status.
+}
+
+
+// Write a wiper value, in ohms, returning the status.
+DigiPot_status Vulintus_DigiPot::try_set_resistance(float float_ohms, uint8_t wiper_i, float *actual)
+{
+    float result = set_resistance(float_ohms, wiper_i); // Write the value.
+    if (actual != NULL) {                           // If the caller wants the written value...
+        *actual = result;                           // Return it.
+    }
+    return result_status(result < 0);               // Return the status.
+}
+
+
+// Read a wiper value, in ohms, returning the status.
+DigiPot_status Vulintus_DigiPot::try_get_resistance(float *float_ohms, uint8_t wiper_i, bool hw_read)
+{
+    *float_ohms = get_resistance(wiper_i, hw_read); // Read the value.
+    return result_status(*float_ohms < 0);          // Return the status.
+}
+
+
+// Read the Wiper 0 value, in steps.
+uint16_t Vulintus_DigiPot::get_code(void)
+{
+    return get_code((uint8_t) 0, false);            // Read the value from wiper 0.
+}
+
+
+// Read the specified wiper value, in steps.
+uint16_t Vulintus_DigiPot::get_code(uint8_t wiper_i)
+{
+    return get_code(wiper_i, false);                // Read the value from the cache, if possible.
+}
+
+
+// Read the specified wiper value, in steps, optionally from the chip.
+uint16_t Vulintus_DigiPot::get_code(uint8_t wiper_i, bool hw_read)
+{
+    if (!wiper_valid(wiper_i)) {                    // If the chip doesn't have this wiper...
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    uint8_t i = wiper_i;                            // Grab the cache index for this wiper.
+    if (!hw_read && (_dirty & (1 << i))) {          // If a target is staged and no hardware read was requested...
+        return _staged[i];                          // Return the staged target.
+    }
+    if (!hw_read && (_cache_valid & (1 << i))) {    // If the cached value is known and no hardware read was requested...
+        DIGIPOT_STAT(_stats.n_cache_hits++);        // Count the cache hit.
+        return _wiper_cache[i];                     // Return the cached value.
+    }
+    DIGIPOT_STAT(DigiPot_stats_mark mark = stats_mark());  // Start timing the read.
+    uint16_t code = bus_read(wiper_i);              // Read the value from the chip.
+    DIGIPOT_STAT(stats_add(mark));                  // Charge the read to this device.
+    if (async() && (_status == DIGIPOT_PENDING)) {  // If the read was queued...
+        return DIGIPOT_CODE_INVALID;                // The value will arrive in the callback.
+    }
+    if (code > n_resistors) {                       // If the read failed...
+        _cache_valid &= ~(1 << i);                  // The wiper value is now unknown.
+        if (_status == DIGIPOT_OK) {                // If the bus reported success...
+            _status = DIGIPOT_ERR_BUS;              // The chip returned an out-of-range value.
+        }
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    cache_store(wiper_i, code);                     // Save the read value.
+    return code;                                    // Return the value.
+}
+
+
+// Set when writes are verified with a read-back.
+void Vulintus_DigiPot::set_verify(DigiPot_verify_mode mode, uint16_t n_writes)
+{
+    _verify_mode = mode;                            // Save the verification mode.
+    _verify_n = (n_writes > 0) ? n_writes : 1;      // Save the number of writes between verifications.
+    _verify_count = 0;                              // Reset the write counter.
+}
+
+
+// Use a measured resistance table (NULL for the linear model).
+void Vulintus_DigiPot::set_calibration(Vulintus_DigiPot_Cal *cal)
+{
+    _cal = cal;                                     // Save the table pointer.
+}
+
+
+// Queue writes/reads instead of blocking (NULL to turn off).
+void Vulintus_DigiPot::set_async(Vulintus_DigiPot_Queue *queue, DigiPot_callback callback, void *context)
+{
+    _queue = queue;                                 // Save the queue.
+    _callback = callback;                           // Save the completion callback.
+    _callback_context = context;                    // Save the user pointer.
+}
+
+
+// Hold writes until "flush" (turning off flushes, and stays on if that fails).
+uint8_t Vulintus_DigiPot::set_staged(bool staged)
+{
+    uint8_t error = 0;                              // Assume no error.
+    if (!staged) {                                  // If staged mode is being turned off...
+        error = flush();                            // Send anything still staged.
+        if (error && (error != DIGIPOT_PENDING)) {  // If the write failed...
+            return error;                           // Stay in staged mode, with the targets kept.
+        }
+    }
+    _staged_mode = staged;                          // Save the mode.
+    return error;                                   // Return the error code.
+}
+
+
+// Send the final staged value of each changed wiper (kept staged if the write fails).
+uint8_t Vulintus_DigiPot::flush(void)
+{
+    _flushed = 0;                                   // Nothing has been sent yet.
+    if (!_dirty) {                                  // If nothing is staged...
+        return 0;                                   // Skip the bus entirely.
+    }
+    uint8_t wiper_mask = _dirty;                    // Grab the changed wipers.
+    bool mode = _staged_mode;                       // Send straight to the bus.
+    _dirty = 0;
+    _staged_mode = false;
+    uint8_t error = set_codes(_staged, wiper_mask); // Write all of the changed wipers at once.
+    _staged_mode = mode;                            // Restore the mode.
+    if (error && (error != DIGIPOT_PENDING)) {      // If the write failed...
+        _dirty |= wiper_mask;                       // Keep the targets staged for the next flush.
+    }
+    else {                                          // Otherwise...
+        _flushed = wiper_mask;                      // Remember what was sent, in case its batch fails.
+    }
+    return error;                                   // Return the error code.
+}
+
+
+// Stage the wipers sent by the last "flush" again (their batch failed).
+void Vulintus_DigiPot::restage(void)
+{
+    _dirty |= _flushed;                             // The targets are still in the staged values.
+    _flushed = 0;
+}
+
+
+// Mark all cached wiper values as unknown.
+void Vulintus_DigiPot::clear_cache(void)
+{
+    _cache_valid = 0;                               // Clear all of the valid flags.
+}
+
+
+// Mark some cached wiper values as unknown.
+void Vulintus_DigiPot::cache_forget(uint8_t wiper_mask)
+{
+    _cache_valid &= ~wiper_mask;                    // Clear the valid flags for those wipers.
+}
+
+
+// Part descriptor index (DIGIPOT_PART_NONE for virtual devices).
+DigiPot_part Vulintus_DigiPot::part(void)
+{
+    return _part;                                   // Return the descriptor index.
+}
+
+
+// Bus and memory flags from the part descriptor.
+uint8_t Vulintus_DigiPot::part_flags(void)
+{
+    return digipot_part_flags(_part);               // Read the flags from flash.
+}
+
+
+// Select one of the part's end-to-end resistance options.
+bool Vulintus_DigiPot::set_nominal_resistance(DigiPot_rab rab)
+{
+    DigiPot_part_desc desc;                         // Part descriptor.
+    uint32_t ohms = digipot_rab_ohms(rab);          // Convert the option to ohms.
+    if ((ohms == 0) || !digipot_part_read(_part, &desc)) {     // If the option or the part is invalid...
+        return false;                               // Return false.
+    }
+    if ((_part != DIGIPOT_PART_NONE) && !(desc.rab_options & rab)) {   // If the part isn't made in this resistance...
+        return false;                               // Return false.
+    }
+    max_resistance.mohm = 1000UL * ohms;            // Set the ladder resistance.
+    return true;                                    // Return true.
+}
+
+
+// Set the bus clock rate, in Hz (0 for the part's maximum; returns the rate used).
+uint32_t Vulintus_DigiPot::set_clock(uint32_t clock)
+{
+    uint32_t max_clock = digipot_part_max_clock(_part);    // Fetch the part's limit.
+    if (!(part_flags() & DIGIPOT_PART_FLAG_SPI) && (max_clock > DIGIPOT_I2C_MAX_HZ)) {    // If the core can't run I2C that fast...
+        max_clock = DIGIPOT_I2C_MAX_HZ;             // Use the core's limit.
+    }
+    if ((clock == 0) || (clock > max_clock)) {      // If the rate is unset or too fast...
+        clock = max_clock;                          // Use the fastest supported rate.
+    }
+    else if (clock < DIGIPOT_BUS_MIN_HZ) {          // If the rate is too slow...
+        clock = DIGIPOT_BUS_MIN_HZ;                 // Use the slowest supported rate.
+    }
+    _clock = clock;                                 // Save the rate.
+    return _clock;                                  // Return the rate used.
+}
+
+
+// Bus clock rate, in Hz.
+uint32_t Vulintus_DigiPot::get_clock(void)
+{
+    return _clock;
+}
+
+
+// Bus interface pointer (used to sort devices by bus).
+void *Vulintus_DigiPot::bus_handle(void)
+{
+    return NULL;                                    // No bus by default.
+}
+
+
+// Longest a blocking call can take on a faulty I2C bus, with retries (0 if unbounded).
+uint32_t Vulintus_DigiPot::worst_case_us(DigiPot_call call)
+{
+    uint32_t write_us = bus_worst_case_us(DIGIPOT_OP_WRITE);   // Bound for one write transaction.
+    uint32_t read_us = bus_worst_case_us(DIGIPOT_OP_READ);     // Bound for one read transaction.
+    if ((write_us == 0) || (read_us == 0)) {        // If the core can't enforce a deadline (or this is SPI)...
+        return 0;                                   // The call is unbounded.
+    }
+    uint32_t probe_us = write_us;                   // The address probe waits once, like a write (and isn't retried).
+    if (_verify_mode != DIGIPOT_VERIFY_NEVER) {     // If writes can be verified...
+        write_us += read_us;                        // Any write may read the wiper back.
+    }
+    switch (call) {
+        case DIGIPOT_CALL_WRITE:
+            return write_us;
+        case DIGIPOT_CALL_READ:
+            return read_us;
+        case DIGIPOT_CALL_WRITE_ALL:
+            return n_wipers * write_us;             // One write (and read-back) per wiper, at most.
+        case DIGIPOT_CALL_BEGIN:
+            return probe_us + n_wipers * read_us;   // The probe, then a read of every wiper.
+    }
+    return 0;
+}
+
+
+// Longest one "bus_write" or "bus_read" can take (0 if unbounded).
+uint32_t Vulintus_DigiPot::bus_worst_case_us(DigiPot_op op)
+{
+    if ((_bus == NULL) || (_bus->i2c() == NULL)) {  // If there's no I2C transport...
+        return 0;                                   // There's no deadline to count on.
+    }
+    return _bus->worst_case_us((op == DIGIPOT_OP_READ) ? 2 : 1, _clock);   // A write waits once, a register read twice (write, then read).
+}
+
+
+// I2C address or SPI chip select pin.
+uint8_t Vulintus_DigiPot::bus_address(void)
+{
+    return 0;                                       // No address by default.
+}
+
+
+// Status of the last bus operation.
+DigiPot_status Vulintus_DigiPot::status(void)
+{
+    return _status;                                 // Return the saved status.
+}
+
+
+// Resistance of a wiper code (ohms), without writing it.
+float Vulintus_DigiPot::code_resistance(uint16_t code)
+{
+    uint32_t mohm = code_to_mohm(code);             // Convert the code with the linear model or calibration table.
+    if (mohm == DIGIPOT_MOHM_INVALID) {             // If the code is the error value...
+        return (float) -1;                          // Return -1.
+    }
+    return mohm * 0.001;                            // Return the resistance.
+}
+
+
+// Write several wipers in as few transactions as possible.
+uint8_t Vulintus_DigiPot::bus_write_multi(const uint16_t *codes, uint8_t wiper_mask)
+{
+    uint8_t error;                                  // Error code.
+    for (uint8_t i = 0; i < n_wipers; i++) {        // Step through the wipers.
+        if (wiper_mask & (1 << i)) {                // If this wiper should be written...
+            error = bus_write(codes[i], i);         // Write the value.
+            if (error && (error != DIGIPOT_PENDING)) {  // If the write failed...
+                return error;                       // Return the error code.
+            }
+        }
+    }
+    return async() ? DIGIPOT_PENDING : DIGIPOT_OK;  // Return the pending status, or success.
+}
+
+
+// Count a write and check if it should be verified.
+bool Vulintus_DigiPot::verify_due(void)
+{
+    if (_verify_mode == DIGIPOT_VERIFY_NEVER) {     // If write verification is disabled...
+        return false;                               // No verification is needed.
+    }
+    _verify_count++;                                // Count this write.
+    if ((_verify_mode == DIGIPOT_VERIFY_ON_WRITE) || (_verify_count >= _verify_n)) {
+        _verify_count = 0;                          // Reset the write counter.
+        return true;                                // Verify this write.
+    }
+    return false;                                   // Skip verification.
+}
+
+
+// Convert a call's result to a typed status.
+DigiPot_status Vulintus_DigiPot::result_status(bool failed)
+{
+    if (failed && (_status == DIGIPOT_OK)) {        // If the call returned the error value but the bus reported success...
+        _status = DIGIPOT_ERR_BUS;                  // Report an "other" error.
+    }
+    if (failed || (_status == DIGIPOT_PENDING)) {   // If the call failed or was queued...
+        return _status;                             // Return the error (or pending) status.
+    }
+    return DIGIPOT_OK;                              // Otherwise, return success.
+}
+
+
+// Load the default constants for a part from flash.
+void Vulintus_DigiPot::load_part(DigiPot_part part)
+{
+    DigiPot_part_desc desc;                         // Part descriptor.
+    if (!digipot_part_read(part, &desc)) {          // If the part index is invalid...
+        return;                                     // Keep the current constants.
+    }
+    _part = part;                                   // Save the descriptor index.
+    n_resistors = desc.n_resistors;                 // Copy the defaults.
+    n_wipers = desc.n_wipers;
+    wiper_resistance.mohm = 1000UL * desc.wiper_ohms;
+    max_resistance.mohm = 10000000;                 // Default to the 10 kOhm option (made for every supported part).
+    _clock = (desc.flags & DIGIPOT_PART_FLAG_SPI) ? DIGIPOT_SPI_DEFAULT_HZ : DIGIPOT_I2C_FAST_HZ;   // Default bus clock rate.
+}
+
+
+// Check that a transport is attached (sets the status if not).
+bool Vulintus_DigiPot::bus_ready(void)
+{
+    if (_bus == NULL) {                             // If "begin" hasn't attached a transport...
+        _status = DIGIPOT_ERR_NO_BUS;               // Report a missing bus.
+        return false;                               // Return false.
+    }
+    return true;                                    // Return true.
+}
+
+
+// Check if writes/reads should be queued instead of sent.
+bool Vulintus_DigiPot::async(void)
+{
+    return (_queue != NULL) && !_draining;          // Queue unless a queued transaction is being run.
+}
+
+
+// Check if writes should be held until "flush".
+bool Vulintus_DigiPot::staged(void)
+{
+    return _staged_mode;
+}
+
+
+// Queue a transaction (asynchronous mode).
+DigiPot_status Vulintus_DigiPot::enqueue(DigiPot_op op, uint16_t code, uint8_t wiper_i)
+{
+    _status = _queue->push(this, op, wiper_i, code);    // Add the transaction to the queue.
+    return _status;                                 // Return the pending (or queue full) status.
+}
+
+
+// Run a queued transaction and report the result.
+void Vulintus_DigiPot::run_transaction(const DigiPot_transaction *t)
+{
+    uint16_t data = t->code;                        // Data to report.
+    _draining = true;                               // Send straight to the bus.
+    DIGIPOT_STAT(DigiPot_stats_mark mark = stats_mark());  // Start timing the transaction.
+    if (t->op == DIGIPOT_OP_WRITE) {                // If this is a write...
+        _status = (DigiPot_status) bus_write(t->code, t->wiper_i);  // Write the value.
+        if (_status != DIGIPOT_OK) {                // If the write failed...
+            _cache_valid &= ~(1 << t->wiper_i);     // The wiper value is now unknown.
+        }
+    }
+    else {                                          // Otherwise, if this is a read...
+        data = bus_read(t->wiper_i);                // Read the value (the driver updates the cache).
+        if ((_status == DIGIPOT_OK) && (data > n_resistors)) {  // If the value is out of range...
+            _status = DIGIPOT_ERR_BUS;              // Report an "other" error.
+        }
+    }
+    DIGIPOT_STAT(stats_add(mark));                  // Charge the transaction to this device.
+    _draining = false;                              // Go back to queueing.
+    if (_callback != NULL) {                        // If there's a completion callback...
+        _callback(this, t->op, t->wiper_i, _status, data, _callback_context);  // Report the result.
+    }
+}
+
+
+// Drop a queued transaction without running it, and report the cancellation.
+void Vulintus_DigiPot::cancel_transaction(const DigiPot_transaction *t)
+{
+    if (t->op == DIGIPOT_OP_WRITE) {                // If this is a write...
+        _cache_valid &= ~(1 << t->wiper_i);         // The cache holds the pending value, which never reached the chip.
+    }
+    if (_callback != NULL) {                        // If there's a completion callback...
+        _callback(this, t->op, t->wiper_i, DIGIPOT_ERR_CANCELLED, t->code, _callback_context);    // Report the cancellation.
+    }
+}
+
+
+// Write a code, settle, and measure.
+bool Vulintus_DigiPot::tune_probe(uint16_t code, uint8_t wiper_i, DigiPot_measure_fn measure, void *context, \
+        const DigiPot_tune_config &config, DigiPot_tune_result *result, int32_t *value)
+{
+    uint16_t current;                               // Current wiper value.
+    if (!cache_lookup(wiper_i, &current) || (current != code)) {   // If the wiper isn't already at this code...
+        if (set_code(code, wiper_i) == DIGIPOT_CODE_INVALID) {  // Write the code. If the write failed...
+            result->status = _status;               // Report the bus status.
+            return false;                           // Return false.
+        }
+        if (flush() && !async()) {                  // Send it now if writes are staged. If the write failed...
+            result->status = _status;               // Report the bus status.
+            return false;                           // Return false.
+        }
+        result->n_writes++;                         // Count the write.
+    }
+    if (config.settle_us >= 1000) {                 // If the settling time is long...
+        delay(config.settle_us / 1000);             // Wait for the whole milliseconds.
+    }
+    delayMicroseconds(config.settle_us % 1000);     // Wait for the remaining microseconds.
+    uint8_t n = (config.n_samples > 0) ? config.n_samples : 1;     // Grab the number of samples.
+    int32_t sum = 0;                                // Sum of the measurements.
+    for (uint8_t i = 0; i < n; i++) {               // Take each measurement.
+        sum += measure(context);
+    }
+    *value = sum / n;                               // Average the measurements.
+    result->n_probes++;                             // Count the probe.
+    return true;                                    // Return true.
+}
+
+
+// Check that a wiper exists on the chip (sets the status if not).
+bool Vulintus_DigiPot::wiper_valid(uint8_t wiper_i)
+{
+    if (wiper_i >= n_wipers) {                      // If the wiper index is out of range...
+        _status = DIGIPOT_ERR_WIPER;                // Report the bad wiper index.
+        return false;                               // Return false.
+    }
+    return true;                                    // Return true.
+}
+
+
+// Read all wipers from the chip into the cache.
+void Vulintus_DigiPot::fill_cache(void)
+{
+    _cache_valid = 0;                               // Clear all of the valid flags.
+    for (uint8_t i = 0; i < n_wipers; i++) {        // Step through the wipers.
+        get_code(i, true);                          // Read each wiper from the chip.
+    }
+}
+
+
+// Save a known wiper value in the cache.
+void Vulintus_DigiPot::cache_store(uint8_t wiper_i, uint16_t code)
+{
+    if (wiper_i >= n_wipers) {                      // If the chip doesn't have this wiper...
+        return;                                     // There's nothing to cache.
+    }
+    _wiper_cache[wiper_i] = code;                   // Save the value.
+    _cache_valid |= (1 << wiper_i);                 // Mark the value as known.
+}
+
+
+// Fetch a cached wiper value, if known.
+bool Vulintus_DigiPot::cache_lookup(uint8_t wiper_i, uint16_t *code)
+{
+    if ((wiper_i >= n_wipers) || !(_cache_valid & (1 << wiper_i))) {   // If the wiper doesn't exist or its value isn't known...
+        return false;                               // Return false.
+    }
+    *code = _wiper_cache[wiper_i];                  // Copy out the cached value.
+    return true;                                    // Return true.
+}
+
+
+// Fetch the staged target of a wiper, or its cached value, if known (never touches the bus).
+bool Vulintus_DigiPot::target_lookup(uint8_t wiper_i, uint16_t *code)
+{
+    if ((wiper_i < n_wipers) && (_dirty & (1 << wiper_i))) {   // If a target is staged for this wiper...
+        *code = _staged[wiper_i];                   // Copy out the staged target.
+        return true;                                // Return true.
+    }
+    return cache_lookup(wiper_i, code);             // Otherwise, check the cache.
+}
+
+
+// Step a cached wiper value after an increment/decrement.
+void Vulintus_DigiPot::cache_step(uint8_t wiper_i, int8_t steps)
+{
+    if ((wiper_i >= n_wipers) || !(_cache_valid & (1 << wiper_i))) {   // If the wiper doesn't exist or its value isn't known...
+        return;                                     // There's nothing to update.
+    }
+    uint8_t i = wiper_i;                            // Grab the cache index for this wiper.
+    int16_t code = (int16_t) _wiper_cache[i] + steps;   // Apply the steps.
+    if (code < 0) {                                 // The chip saturates at zero scale...
+        code = 0;
+    }
+    else if (code > (int16_t) n_resistors) {        // ...and at full scale.
+        code = n_resistors;
+    }
+    _wiper_cache[i] = code;                         // Save the new value.
+}
+
+
+// Convert a wiper code to a resistance (milliohms).
+uint32_t Vulintus_DigiPot::code_to_mohm(uint16_t code)
+{
+    if (code == DIGIPOT_CODE_INVALID) {             // If the code is the error value...
+        return DIGIPOT_MOHM_INVALID;                // Return the error value.
+    }
+    if (_cal != NULL) {                             // If a calibration table is set...
+        return _cal->resistance_mohm(code);         // Look up the measured resistance.
+    }
+    if (n_resistors == 0) {                         // If there's no ladder...
+        return wiper_resistance.mohm;               // Only the wiper resistance is left.
+    }
+    uint32_t step_mohm = max_resistance.mohm / n_resistors;    // Whole milliohms per step.
+    uint32_t step_frac = max_resistance.mohm % n_resistors;    // Leftover milliohms per step, in 1/n_resistors units.
+    return wiper_resistance.mohm + step_mohm * code + (step_frac * code + (n_resistors >> 1)) / n_resistors;  // Split so nothing overflows.
+}
+
+
+// Find the wiper code nearest a resistance (milliohms).
+uint16_t Vulintus_DigiPot::mohm_to_code(uint32_t mohm)
+{
+    if (_cal != NULL) {                             // If a calibration table is set...
+        return _cal->nearest_code(mohm);            // Search the measured resistances.
+    }
+    if ((mohm <= wiper_resistance.mohm) || (max_resistance.mohm == 0)) {  // If the target is at or below the wiper resistance...
+        return 0;                                   // Return the bottom of the ladder.
+    }
+    uint32_t span = mohm - wiper_resistance.mohm;   // Resistance needed from the ladder.
+    uint32_t full = max_resistance.mohm;            // Resistance of the full ladder.
+    if (span >= full) {                             // If the target is at or above full scale...
+        return n_resistors;                         // Return the top of the ladder.
+    }
+    uint32_t limit = 0xFFFFFFFF / n_resistors;      // Largest ladder resistance that can be multiplied by the step count.
+    while (full > limit) {                          // Drop low bits until the product fits in 32 bits.
+        full >>= 1;
+        span >>= 1;
+    }
+    uint16_t code = (span * n_resistors + (full >> 1)) / full;     // Estimate the nearest code.
+    while (code < n_resistors) {                    // Check the estimate against the exact model (ties round up).
+        uint32_t lo = code_to_mohm(code);           // Resistance at this code...
+        uint32_t hi = code_to_mohm(code + 1);       // ...and at the next code up.
+        if ((mohm <= lo) || ((2 * (mohm - lo)) < (hi - lo))) {    // If the target is below the midpoint...
+            break;                                  // This code is at least as close.
+        }
+        code++;                                     // Otherwise, step up.
+    }
+    while (code > 0) {
+        uint32_t lo = code_to_mohm(code - 1);       // Resistance at the next code down...
+        uint32_t hi = code_to_mohm(code);           // ...and at this code.
+        if ((mohm > lo) && ((2 * (mohm - lo)) >= (hi - lo))) {    // If the target is at or above the midpoint...
+            break;                                  // This code is at least as close.
+        }
+        code--;                                     // Otherwise, step down.
+    }
+    return code;                                    // Return the nearest code.
+}
+
+
+// Convert a wiper code to a Q16 position.
+uint32_t Vulintus_DigiPot::code_to_q16(uint16_t code)
+{
+    if (code == DIGIPOT_CODE_INVALID) {             // If the code is the error value...
+        return DIGIPOT_Q16_INVALID;                 // Return the error value.
+    }
+    if (n_resistors == 0) {                         // If there's no ladder...
+        return 0;                                   // The wiper can only be at zero.
+    }
+    return (((uint32_t) code << 16) + (n_resistors >> 1)) / n_resistors;  // Return the rounded position.
+}
+
+
+// Convert a resistance (milliohms) to a scaled value, 0-1.
+float Vulintus_DigiPot::mohm_to_scaled(uint32_t mohm)
+{
+    if (mohm == DIGIPOT_MOHM_INVALID) {             // If the resistance is the error value...
+        return (float) -1;                          // Return -1.
+    }
+    return (float) mohm / (float) (wiper_resistance.mohm + max_resistance.mohm);  // Divide by the wiper resistance and max resistance.
+}
+
+
+#if defined(DIGIPOT_STATS)
+
+// Performance counters for this device.
+const DigiPot_stats *Vulintus_DigiPot::stats(void)
+{
+    return &_stats;
+}
+
+
+// Zero the performance counters.
+void Vulintus_DigiPot::reset_stats(void)
+{
+    digipot_stats_clear(&_stats);
+}
+
+
+// Start timing a driver-level read or write.
+DigiPot_stats_mark Vulintus_DigiPot::stats_mark(void)
+{
+    DigiPot_stats_mark mark;                        // Starting point.
+    memset(&mark, 0, sizeof(mark));                 // Start from zero.
+    if (_bus != NULL) {                             // If there's a transport...
+        const DigiPot_stats *bus = _bus->stats();   // Save its counters.
+        mark.n_transactions = bus->n_transactions;
+        mark.n_bytes = bus->n_bytes;
+        mark.n_nacks = bus->n_nacks;
+        mark.n_short_reads = bus->n_short_reads;
+        mark.n_errors = bus->n_errors;
+    }
+    mark.t0 = micros();                             // Save the start time.
+    return mark;                                    // Return the starting point.
+}
+
+
+// Charge a finished read or write to this device.
+void Vulintus_DigiPot::stats_add(const DigiPot_stats_mark &mark)
+{
+    if (_status == DIGIPOT_PENDING) {               // If the call was only queued...
+        return;                                     // It's counted when it runs.
+    }
+    digipot_stats_latency(&_stats, micros() - mark.t0);    // Add the call time to the histogram.
+    if (_bus == NULL) {                             // If there's no transport to charge...
+        digipot_stats_status(&_stats, _status);     // Count the call as one transaction.
+        return;
+    }
+    const DigiPot_stats *bus = _bus->stats();       // Charge everything the bus did during the call.
+    _stats.n_transactions += bus->n_transactions - mark.n_transactions;
+    _stats.n_bytes += bus->n_bytes - mark.n_bytes;
+    _stats.n_nacks += bus->n_nacks - mark.n_nacks;
+    _stats.n_short_reads += bus->n_short_reads - mark.n_short_reads;
+    _stats.n_errors += bus->n_errors - mark.n_errors;
+}
+
+#endif      // #if defined(DIGIPOT_STATS)
@@ -10,6 +10,48 @@
                                   potentiometer library calls under a single 
                                   parent header.
 		2024-07-08 - Drew Sloan	- Created "Vulintus_DigiPot" base class.						  
+		2026-10-17 - Drew Sloan - Added a per-wiper shadow register cache with 
+                                  selectable write verification. Moved the 
+                                  scaled/resistance conversions into the base 
+                                  class.
+		2026-10-17 - Drew Sloan - Added optional per-step calibration tables.
+		2026-10-17 - Drew Sloan - Added opt-in compile-time specialized MCP4xxx 
+                                  aliases (VULINTUS_DIGIPOT_STATIC).
+		2026-10-17 - Drew Sloan - Added the shared bus transport and a common 
+                                  "DigiPot_status" code.
+		2026-10-17 - Drew Sloan - Added the asynchronous transaction queue.
+		2026-10-17 - Drew Sloan - Added the successive-approximation "tune" 
+                                  function.
+		2026-10-17 - Drew Sloan - Added the composite (two-wiper) virtual 
+                                  potentiometer.
+		2026-10-17 - Drew Sloan - Added the startup/bus scan manager.
+		2026-10-17 - Drew Sloan - Added optional per-device performance 
+                                  counters (DIGIPOT_STATS).
+		2026-10-17 - Drew Sloan - Added "try_" functions that return a typed 
+                                  status instead of a sentinel value.
+		2026-10-17 - Drew Sloan - Added staged mode, where writes are held 
+                                  until "flush".
+		2026-10-17 - Drew Sloan - Per-part constants now come from a flash 
+                                  descriptor table, and the part aliases 
+                                  select their descriptors.
+		2026-10-17 - Drew Sloan - Added integer (milliohm and Q16) entry points. 
+                                  The float functions are now thin wrappers, 
+                                  so integer-only sketches don't link the 
+                                  floating-point library.
+		2026-10-17 - Drew Sloan - Added per-device bus clock rates, clamped to 
+                                  each part's maximum.
+		2026-10-17 - Drew Sloan - Added an interrupt-safe wiper command ring.
+		2026-10-17 - Drew Sloan - Out-of-range wiper indices are now rejected 
+                                  (DIGIPOT_ERR_WIPER) instead of addressing 
+                                  the last wiper.
+		2026-10-17 - Drew Sloan - Added "worst_case_us" for each blocking 
+                                  driver call.
+		2026-10-17 - Drew Sloan - A failed "flush" keeps the staged targets, and 
+                                  "set_staged(false)" returns its error.
+		2026-10-17 - Drew Sloan - "set_ratio_q16(0xFFFF)" is full scale on every 
+                                  ladder length.
+		2026-10-17 - Drew Sloan - "tune" with DIGIPOT_TUNE_AUTO starts its bracket 
+                                  from the two end measurements.
 */
 
 
@@ -18,6 +60,81 @@
 
 #include <Arduino.h>                    //Standard Arduino header.
 
+#include "./Vulintus_DigiPot_Bus.h"     // Shared bus transport.
+#include "./Vulintus_DigiPot_Cal.h"     // Per-step resistance calibration tables.
+#include "./Vulintus_DigiPot_Queue.h"   // Asynchronous transaction queue.
+#include "./Vulintus_DigiPot_Parts.h"   // Flash-resident part descriptors.
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define DIGIPOT_MAX_WIPERS      2           // Maximum number of wipers on any supported chip.
+#define DIGIPOT_CODE_INVALID    0xFFFF      // Wiper code returned when a read or write fails.
+#define DIGIPOT_MOHM_INVALID    0xFFFFFFFF  // Resistance (milliohms) returned when a read or write fails.
+#define DIGIPOT_Q16_INVALID     0xFFFFFFFF  // Q16 wiper position returned when a read or write fails.
+#define DIGIPOT_Q16_ONE         0x10000     // Q16 wiper position at full scale (1.0).
+
+inline uint32_t digipot_ohms_to_mohm(float float_ohms)     // Convert ohms to milliohms, rounded and clipped to 32 bits.
+{
+    if (float_ohms <= 0) {                          // If the resistance is zero or negative...
+        return 0;                                   // Return zero.
+    }
+    if (float_ohms >= 4294967.0) {                  // If the resistance won't fit in 32 bits...
+        return (DIGIPOT_MOHM_INVALID - 1);          // Return the largest valid value.
+    }
+    return (uint32_t) (float_ohms * 1000.0 + 0.5);  // Round to the nearest milliohm.
+}
+
+struct DigiPot_ohms {
+    uint32_t mohm;                                  // Resistance, in milliohms (use this directly from integer code).
+    operator float() const {                        // Read as ohms (floating-point).
+        return mohm * 0.001;
+    }
+    DigiPot_ohms &operator=(float float_ohms) {     // Assign in ohms (floating-point).
+        mohm = digipot_ohms_to_mohm(float_ohms);
+        return *this;
+    }
+};
+
+enum DigiPot_verify_mode : uint8_t {
+    DIGIPOT_VERIFY_NEVER    = 0,    // Never read the wiper back after a write (trust the cache).
+    DIGIPOT_VERIFY_ON_WRITE = 1,    // Read the wiper back after every write.
+    DIGIPOT_VERIFY_EVERY_N  = 2,    // Read the wiper back after every N writes.
+};
+
+enum DigiPot_call : uint8_t {      // Blocking driver calls with a worst-case time ("worst_case_us").
+    DIGIPOT_CALL_WRITE      = 0,    // One wiper write ("set_code", "set_scaled", "set_resistance", "set_milliohms", "set_ratio_q16", "move_to"), with its verification read.
+    DIGIPOT_CALL_READ       = 1,    // One wiper read from the chip (the "get_" functions with "hw_read").
+    DIGIPOT_CALL_WRITE_ALL  = 2,    // Every wiper ("set_codes", "flush"), with the verification reads.
+    DIGIPOT_CALL_BEGIN      = 3,    // "begin": the address probe and a read of every wiper.
+};
+
+enum DigiPot_tune_dir : uint8_t {
+    DIGIPOT_TUNE_RISING     = 0,    // The measurement increases with the wiper code.
+    DIGIPOT_TUNE_FALLING    = 1,    // The measurement decreases with the wiper code.
+    DIGIPOT_TUNE_AUTO       = 2,    // Measure both ends of the ladder to find the direction (2 extra writes).
+};
+
+typedef int32_t (*DigiPot_measure_fn)(void *context);      // Measurement callback (e.g. returns ADC counts).
+
+struct DigiPot_tune_config {
+    int32_t target;                 // Target measurement.
+    int32_t tolerance;              // Stop early once the error is within +/- this value.
+    uint32_t settle_us;             // Settling time after each write, before measuring (microseconds).
+    uint8_t n_samples;              // Number of measurements averaged at each code (minimum 1).
+    DigiPot_tune_dir direction;     // Relationship between the wiper code and the measurement.
+};
+
+struct DigiPot_tune_result {
+    uint16_t code;                  // Final wiper code.
+    int32_t measured;               // Measurement at the final code.
+    int32_t error;                  // Measured minus target.
+    uint8_t n_writes;               // Number of wiper writes sent to the chip.
+    uint8_t n_probes;               // Number of codes measured.
+    bool in_tolerance;              // True if the final error is within the tolerance.
+    bool monotonic;                 // False if the measurements contradicted the expected direction.
+    DigiPot_status status;          // Bus status (DIGIPOT_OK unless a write failed).
+};
+
 
 //CLASSES ******************************************************************************************************//
 class Vulintus_DigiPot
@@ -31,26 +148,153 @@ class Vulintus_DigiPot
         ~Vulintus_DigiPot(void);
 
 		// Public Variables. //
-		float wiper_resistance;    	// Wiper resistance, in ohms.
-		float max_resistance;    	// Maximum resistance (not counting wiper), in ohms.
+		DigiPot_ohms wiper_resistance;  // Wiper resistance, in ohms (".mohm" for milliohms).
+		DigiPot_ohms max_resistance;    // Maximum resistance (not counting wiper), in ohms (".mohm" for milliohms).
 		uint16_t n_resistors;     	// Number of resistors in the ladder network.  
+		uint32_t n_superseded;		// Staged targets replaced before reaching the bus.
 
 		// Public Functions. // 
         virtual uint8_t begin(void) = 0;		// Initialization.        
 
-		virtual float set_scaled(float float_scaled) = 0;						// Write the Wiper 0 value, scaled 0-1.
-		virtual float set_scaled(float float_scaled, uint8_t wiper_i) = 0;		// Write the specified wiper value, scaled 0-1.
-		virtual float get_scaled(void);                        					// Read the Wiper 0 value, scaled 0-1.
-        virtual float get_scaled(uint8_t wiper_i);         						// Read the specified wiper value, scaled 0-1.
+		float set_scaled(float float_scaled);						    // Write the Wiper 0 value, scaled 0-1.
+		float set_scaled(float float_scaled, uint8_t wiper_i);		    // Write the specified wiper value, scaled 0-1.
+		float get_scaled(void);                        					// Read the Wiper 0 value, scaled 0-1.
+        float get_scaled(uint8_t wiper_i);         						// Read the specified wiper value, scaled 0-1.
+        float get_scaled(uint8_t wiper_i, bool hw_read);                // Read the specified wiper value, scaled 0-1, optionally from the chip.
+
+		float set_resistance(float float_ohms);						    // Write the Wiper 0 value, in real resistance (ohms).
+		float set_resistance(float float_ohms, uint8_t wiper_i);	    // Write the specified wiper value, in real resistance (ohms).
+		float get_resistance(void);                        				// Read the Wiper 0 value, in real resistance (ohms).
+        float get_resistance(uint8_t wiper_i);         					// Read the specified wiper value, in real resistance (ohms).
+        float get_resistance(uint8_t wiper_i, bool hw_read);            // Read the specified wiper value, in real resistance (ohms), optionally from the chip.
+
+        virtual uint32_t set_milliohms(uint32_t mohm, uint8_t wiper_i = 0);            // Write a wiper value, in milliohms (returns the actual resistance).
+        virtual uint32_t get_milliohms(uint8_t wiper_i = 0, bool hw_read = false);     // Read a wiper value, in milliohms.
+        virtual uint32_t set_ratio_q16(uint16_t ratio, uint8_t wiper_i = 0);           // Write a wiper position, 0-0xFFFF (0xFFFF is full scale; returns the actual position, 0-DIGIPOT_Q16_ONE).
+        virtual uint32_t get_ratio_q16(uint8_t wiper_i = 0, bool hw_read = false);     // Read a wiper position, 0-DIGIPOT_Q16_ONE.
+
+        uint16_t set_code(uint16_t code);                           // Write the Wiper 0 value, in steps.
+        uint16_t set_code(uint16_t code, uint8_t wiper_i);          // Write the specified wiper value, in steps.
+        uint16_t get_code(void);                                    // Read the Wiper 0 value, in steps.
+        uint16_t get_code(uint8_t wiper_i);                         // Read the specified wiper value, in steps.
+        uint16_t get_code(uint8_t wiper_i, bool hw_read);           // Read the specified wiper value, in steps, optionally from the chip.
+        uint8_t set_codes(const uint16_t *codes, uint8_t wiper_mask);   // Write several wipers at once, in steps.
+        virtual uint16_t move_to(uint16_t code, uint8_t wiper_i);       // Move a wiper to a value using the cheapest command sequence.
+
+        DigiPot_status try_set_code(uint16_t code, uint8_t wiper_i = 0, uint16_t *actual = NULL);              // Write a wiper value, in steps, returning the status.
+        DigiPot_status try_get_code(uint16_t *code, uint8_t wiper_i = 0, bool hw_read = false);                // Read a wiper value, in steps, returning the status.
+        DigiPot_status try_set_scaled(float float_scaled, uint8_t wiper_i = 0, float *actual = NULL);          // Write a wiper value, scaled 0-1, returning the status.
+        DigiPot_status try_get_scaled(float *float_scaled, uint8_t wiper_i = 0, bool hw_read = false);         // Read a wiper value, scaled 0-1, returning the status.
+        DigiPot_status try_set_resistance(float float_ohms, uint8_t wiper_i = 0, float *actual = NULL);        // Write a wiper value, in ohms, returning the status.
+        DigiPot_status try_get_resistance(float *float_ohms, uint8_t wiper_i = 0, bool hw_read = false);       // Read a wiper value, in ohms, returning the status.
+        DigiPot_tune_result tune(DigiPot_measure_fn measure, const DigiPot_tune_config &config, \
+                uint8_t wiper_i = 0, void *context = NULL);             // Binary-search the code that best matches a measured target.
 
-		virtual float set_resistance(float float_ohms) = 0;						// Write the Wiper 0 value, in real resistance (ohms).
-		virtual float set_resistance(float float_ohms, uint8_t wiper_i) = 0;	// Write the specified wiper value, in real resistance (ohms).
-		virtual float get_resistance(void);                        				// Read the Wiper 0 value, in real resistance (ohms).
-        virtual float get_resistance(uint8_t wiper_i);         					// Read the specified wiper value, in real resistancev.
+        void set_verify(DigiPot_verify_mode mode, uint16_t n_writes = 1);   // Set when writes are verified with a read-back.
+        void clear_cache(void);                                             // Mark all cached wiper values as unknown.
+        void set_calibration(Vulintus_DigiPot_Cal *cal);                    // Use a measured resistance table (NULL for the linear model).
+        void set_async(Vulintus_DigiPot_Queue *queue, DigiPot_callback callback = NULL, \
+                void *context = NULL);                                      // Queue writes/reads instead of blocking (NULL to turn off).
+        uint8_t set_staged(bool staged);                                    // Hold writes until "flush" (turning off flushes, and stays on if that fails).
+        uint8_t flush(void);                                                // Send the final staged value of each changed wiper (kept staged if the write fails).
+
+        virtual void *bus_handle(void);             // Bus interface pointer (used to sort devices by bus).
+        virtual uint8_t bus_address(void);          // I2C address or SPI chip select pin.
+        DigiPot_status status(void);                // Status of the last bus operation.
+        float code_resistance(uint16_t code);       // Resistance of a wiper code (ohms), without writing it.
+        DigiPot_part part(void);                    // Part descriptor index (DIGIPOT_PART_NONE for virtual devices).
+        uint8_t part_flags(void);                   // Bus and memory flags from the part descriptor.
+        bool set_nominal_resistance(DigiPot_rab rab);   // Select one of the part's end-to-end resistance options.
+        uint32_t set_clock(uint32_t clock);         // Set the bus clock rate, in Hz (0 for the part's maximum; returns the rate used).
+        uint32_t get_clock(void);                   // Bus clock rate, in Hz.
+        virtual uint32_t worst_case_us(DigiPot_call call);  // Longest a blocking call can take on a faulty I2C bus, with retries (0 if unbounded).
+    #if defined(DIGIPOT_STATS)
+        const DigiPot_stats *stats(void);           // Performance counters for this device.
+        void reset_stats(void);                     // Zero the performance counters.
+    #endif
+
+    protected:
+
+        // Protected Variables. //
+        uint8_t n_wipers;           // Number of wipers on the chip.
+        Vulintus_DigiPot_Cal *_cal; // Resistance calibration table (NULL if uncalibrated).
+        Vulintus_DigiPot_Bus *_bus; // Shared bus transport (NULL until "begin" is called).
+        DigiPot_status _status;     // Status of the last bus operation.
+        DigiPot_part _part;         // Part descriptor index.
+        uint32_t _clock;            // Bus clock rate (Hz).
+
+        // Protected Functions. //
+        virtual uint8_t bus_write(uint16_t code, uint8_t wiper_i) = 0;  // Write a wiper value to the chip (returns 0 on success).
+        virtual uint16_t bus_read(uint8_t wiper_i) = 0;                 // Read a wiper value from the chip (returns DIGIPOT_CODE_INVALID on failure).
+        virtual uint8_t bus_write_multi(const uint16_t *codes, uint8_t wiper_mask);    // Write several wipers in as few transactions as possible.
+        virtual uint32_t bus_worst_case_us(DigiPot_op op);              // Longest one "bus_write" or "bus_read" can take (0 if unbounded).
+
+        void load_part(DigiPot_part part);                      // Load the default constants for a part from flash.
+        bool bus_ready(void);                                   // Check that a transport is attached (sets the status if not).
+        bool async(void);                                       // Check if writes/reads should be queued instead of sent.
+        bool staged(void);                                      // Check if writes should be held until "flush".
+        DigiPot_status enqueue(DigiPot_op op, uint16_t code, uint8_t wiper_i);  // Queue a transaction (asynchronous mode).
+        bool wiper_valid(uint8_t wiper_i);                      // Check that a wiper exists on the chip (sets the status if not).
+        void fill_cache(void);                                  // Read all wipers from the chip into the cache.
+        void cache_store(uint8_t wiper_i, uint16_t code);       // Save a known wiper value in the cache.
+        bool cache_lookup(uint8_t wiper_i, uint16_t *code);     // Fetch a cached wiper value, if known.
+        bool target_lookup(uint8_t wiper_i, uint16_t *code);    // Fetch a staged target or cached wiper value, if known.
+        void cache_step(uint8_t wiper_i, int8_t steps);         // Step a cached wiper value after an increment/decrement.
+        void cache_forget(uint8_t wiper_mask);                  // Mark some cached wiper values as unknown.
+        bool verify_due(void);                                  // Count a write and check if it should be verified.
+        DigiPot_status result_status(bool failed);              // Convert a call's result to a typed status.
+        uint32_t code_to_mohm(uint16_t code);                   // Convert a wiper code to a resistance (milliohms).
+        uint16_t mohm_to_code(uint32_t mohm);                   // Find the wiper code nearest a resistance (milliohms).
+        uint32_t code_to_q16(uint16_t code);                    // Convert a wiper code to a Q16 position.
+        float mohm_to_scaled(uint32_t mohm);                    // Convert a resistance (milliohms) to a scaled value, 0-1.
+
+    private:
+
+        // Private Variables. //
+        uint16_t _wiper_cache[DIGIPOT_MAX_WIPERS];  // Last known wiper value for each wiper.
+        uint16_t _staged[DIGIPOT_MAX_WIPERS];       // Staged target for each wiper.
+        uint8_t _cache_valid : DIGIPOT_MAX_WIPERS;  // Bitmask of wipers with a known cached value.
+        uint8_t _dirty : DIGIPOT_MAX_WIPERS;        // Bitmask of wipers with a staged target.
+        uint8_t _flushed : DIGIPOT_MAX_WIPERS;      // Bitmask of wipers sent by the last "flush".
+        uint8_t _draining : 1;                      // Flag indicating a queued transaction is being run.
+        uint8_t _staged_mode : 1;                   // Flag indicating writes are held until "flush".
+        DigiPot_verify_mode _verify_mode;           // Write verification mode.
+        uint16_t _verify_n;                         // Number of writes between verifications.
+        uint16_t _verify_count;                     // Writes since the last verification.
+        Vulintus_DigiPot_Queue *_queue;             // Transaction queue (NULL for blocking mode).
+        DigiPot_callback _callback;                 // Completion callback for queued transactions.
+        void *_callback_context;                    // User pointer passed to the completion callback.
+    #if defined(DIGIPOT_STATS)
+        DigiPot_stats _stats;                       // Performance counters.
+    #endif
+
+        // Private Functions. //
+        void run_transaction(const DigiPot_transaction *t);    // Run a queued transaction and report the result.
+        void cancel_transaction(const DigiPot_transaction *t); // Drop a queued transaction and report the cancellation.
+        void restage(void);                                    // Stage the wipers sent by the last "flush" again (their batch failed).
+        bool tune_probe(uint16_t code, uint8_t wiper_i, DigiPot_measure_fn measure, void *context, \
+                const DigiPot_tune_config &config, DigiPot_tune_result *result, int32_t *value);  // Write a code, settle, and measure.
+
+    #if defined(DIGIPOT_STATS)
+        DigiPot_stats_mark stats_mark(void);                    // Start timing a driver-level read or write.
+        void stats_add(const DigiPot_stats_mark &mark);         // Charge a finished read or write to this device.
+    #endif
+
+        friend class Vulintus_DigiPot_Queue;
+        friend class Vulintus_DigiPotGroup;
 
 };
 
 
+// Multi-device group updates.
+#include "./Vulintus_DigiPotGroup.h"
+
+// Non-blocking wiper ramps.
+#include "./Vulintus_DigiPot_Ramp.h"
+
+// Two-wiper composite (series/parallel/coarse-fine) virtual potentiometers.
+#include "./Vulintus_DigiPot_Composite.h"
+
 // Analog Devices MCP40D17/18/19 (volatile/OTP, I2C).
 #include "./Analog_Devices_AD5273/Vulintus_AD5273_DigiPot.h"
 
@@ -60,49 +304,95 @@ class Vulintus_DigiPot
 // Microchip MCP413X/415X/423X/425X/453X/455X/463X/465X (volatile, SPI or I2C).
 #include "./Microchip_MCP4xxx/Vulintus_MCP4xxx_DigiPot.h"
 
+// Startup manager (one-pass I2C scan, family identification).
+#include "./Vulintus_DigiPot_Manager.h"
+
+// Interrupt-safe wiper command ring.
+#include "./Vulintus_DigiPot_Ring.h"
+
 
 
 // DEFINITIONS ***************************************************************//
 
 #define Vulintus_AD5273   	Vulintus_AD5273_DigiPot   			// Single potentiometer, I2C, OTP, 6-bit.
 
-#define Vulintus_MCP40D17   Vulintus_MCP40D1x_DigiPot   		// Single rheostat, I2C, RAM memory, 7-bit.
-#define Vulintus_MCP40D18   Vulintus_MCP40D1x_DigiPot   		// Single potentiometer, I2C, RAM memory, 7-bit.
-#define Vulintus_MCP40D19   Vulintus_MCP40D1x_DigiPot   		// Single rheostat, I2C, RAM memory, 7-bit.
-
-#define Vulintus_MCP4131    Vulintus_MCP4xxx_SPI_128_DigiPot    // Single potentiometer, SPI, RAM memory, 7-bit.
-#define Vulintus_MCP4132    Vulintus_MCP4xxx_SPI_128_DigiPot    // Single rheostat, SPI, RAM memory, 7-bit.
-#define Vulintus_MCP4141    Vulintus_MCP4xxx_SPI_128_DigiPot    // Single potentiometer, SPI, EE memory, 7-bit.
-#define Vulintus_MCP4142    Vulintus_MCP4xxx_SPI_128_DigiPot    // Single rheostat, SPI, EE memory, 7-bit.
-#define Vulintus_MCP4151    Vulintus_MCP4xxx_SPI_256_DigiPot    // Single potentiometer, SPI, RAM memory, 8-bit.
-#define Vulintus_MCP4152    Vulintus_MCP4xxx_SPI_256_DigiPot    // Single rheostat, SPI, RAM memory, 8-bit.
-#define Vulintus_MCP4161    Vulintus_MCP4xxx_SPI_256_DigiPot    // Single potentiometer, SPI, EE memory, 8-bit.
-#define Vulintus_MCP4162    Vulintus_MCP4xxx_SPI_256_DigiPot    // Single rheostat, SPI, EE memory, 8-bit.
-#define Vulintus_MCP4231    Vulintus_MCP4xxx_SPI_128_DigiPot    // Dual potentiometer, SPI, RAM memory, 7-bit.
-#define Vulintus_MCP4232    Vulintus_MCP4xxx_SPI_128_DigiPot    // Dual rheostat, SPI, RAM memory, 7-bit.
-#define Vulintus_MCP4241    Vulintus_MCP4xxx_SPI_128_DigiPot    // Dual potentiometer, SPI, EE memory, 7-bit.
-#define Vulintus_MCP4242    Vulintus_MCP4xxx_SPI_128_DigiPot    // Dual rheostat, SPI, EE memory, 7-bit.
-#define Vulintus_MCP4251    Vulintus_MCP4xxx_SPI_256_DigiPot    // Dual potentiometer, SPI, RAM memory, 8-bit.
-#define Vulintus_MCP4252    Vulintus_MCP4xxx_SPI_256_DigiPot    // Dual rheostat, SPI, RAM memory, 8-bit.
-#define Vulintus_MCP4261    Vulintus_MCP4xxx_SPI_256_DigiPot    // Dual potentiometer, SPI, EE memory, 8-bit.
-#define Vulintus_MCP4262    Vulintus_MCP4xxx_SPI_256_DigiPot    // Dual rheostat, SPI, E memory, 8-bit.
-
-#define Vulintus_MCP4531    Vulintus_MCP4xxx_I2C_128_DigiPot	// Single potentiometer, I2C, RAM memory, 7-bit.
-#define Vulintus_MCP4532    Vulintus_MCP4xxx_I2C_128_DigiPot	// Single rheostat, I2C, RAM memory, 7-bit.
-#define Vulintus_MCP4541    Vulintus_MCP4xxx_I2C_128_DigiPot 	// Single potentiometer, I2C, EE memory, 7-bit.
-#define Vulintus_MCP4542    Vulintus_MCP4xxx_I2C_128_DigiPot    // Single rheostat, I2C, EE memory, 7-bit.
-#define Vulintus_MCP4551    Vulintus_MCP4xxx_I2C_256_DigiPot    // Single potentiometer, I2C, RAM memory, 8-bit.
-#define Vulintus_MCP4552    Vulintus_MCP4xxx_I2C_256_DigiPot    // Single rheostat, I2C, RAM memory, 8-bit.
-#define Vulintus_MCP4561    Vulintus_MCP4xxx_I2C_256_DigiPot    // Single potentiometer, I2C, EE memory, 8-bit.
-#define Vulintus_MCP4562    Vulintus_MCP4xxx_I2C_256_DigiPot    // Single rheostat, I2C, EE memory, 8-bit.
-#define Vulintus_MCP4631    Vulintus_MCP4xxx_I2C_128_DigiPot    // Dual potentiometer, I2C, RAM memory, 7-bit. *
-#define Vulintus_MCP4632    Vulintus_MCP4xxx_I2C_128_DigiPot   	// Dual rheostat, I2C, RAM memory, 7-bit.
-#define Vulintus_MCP4641    Vulintus_MCP4xxx_I2C_128_DigiPot    // Dual potentiometer, I2C, EE memory, 7-bit.
-#define Vulintus_MCP4642    Vulintus_MCP4xxx_I2C_128_DigiPot    // Dual rheostat, I2C, EE memory, 7-bit.
-#define Vulintus_MCP4651    Vulintus_MCP4xxx_I2C_256_DigiPot    // Dual potentiometer, I2C, RAM memory, 8-bit.
-#define Vulintus_MCP4652    Vulintus_MCP4xxx_I2C_256_DigiPot    // Dual rheostat, I2C, RAM memory, 8-bit.
-#define Vulintus_MCP4661    Vulintus_MCP4xxx_I2C_256_DigiPot    // Dual potentiometer, I2C, EE memory, 8-bit.
-#define Vulintus_MCP4662    Vulintus_MCP4xxx_I2C_256_DigiPot    // Dual rheostat, I2C, E memory, 8-bit.
+#define Vulintus_MCP40D17   Vulintus_MCP40D1x_Part<DIGIPOT_PART_MCP40D17>   // Single rheostat, I2C, RAM memory, 7-bit.
+#define Vulintus_MCP40D18   Vulintus_MCP40D1x_Part<DIGIPOT_PART_MCP40D18>   // Single potentiometer, I2C, RAM memory, 7-bit.
+#define Vulintus_MCP40D19   Vulintus_MCP40D1x_Part<DIGIPOT_PART_MCP40D19>   // Single rheostat, I2C, RAM memory, 7-bit.
+
+#if defined(VULINTUS_DIGIPOT_STATIC)     // Compile-time specialized MCP4xxx drivers.
+
+    #define Vulintus_MCP4131    Vulintus_MCP4xxx_Static<MCP4131_traits>     // Single potentiometer, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4132    Vulintus_MCP4xxx_Static<MCP4132_traits>     // Single rheostat, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4141    Vulintus_MCP4xxx_Static<MCP4141_traits>     // Single potentiometer, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4142    Vulintus_MCP4xxx_Static<MCP4142_traits>     // Single rheostat, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4151    Vulintus_MCP4xxx_Static<MCP4151_traits>     // Single potentiometer, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4152    Vulintus_MCP4xxx_Static<MCP4152_traits>     // Single rheostat, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4161    Vulintus_MCP4xxx_Static<MCP4161_traits>     // Single potentiometer, SPI, EE memory, 8-bit.
+    #define Vulintus_MCP4162    Vulintus_MCP4xxx_Static<MCP4162_traits>     // Single rheostat, SPI, EE memory, 8-bit.
+    #define Vulintus_MCP4231    Vulintus_MCP4xxx_Static<MCP4231_traits>     // Dual potentiometer, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4232    Vulintus_MCP4xxx_Static<MCP4232_traits>     // Dual rheostat, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4241    Vulintus_MCP4xxx_Static<MCP4241_traits>     // Dual potentiometer, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4242    Vulintus_MCP4xxx_Static<MCP4242_traits>     // Dual rheostat, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4251    Vulintus_MCP4xxx_Static<MCP4251_traits>     // Dual potentiometer, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4252    Vulintus_MCP4xxx_Static<MCP4252_traits>     // Dual rheostat, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4261    Vulintus_MCP4xxx_Static<MCP4261_traits>     // Dual potentiometer, SPI, EE memory, 8-bit.
+    #define Vulintus_MCP4262    Vulintus_MCP4xxx_Static<MCP4262_traits>     // Dual rheostat, SPI, E memory, 8-bit.
+
+    #define Vulintus_MCP4531    Vulintus_MCP4xxx_Static<MCP4531_traits>     // Single potentiometer, I2C, RAM memory, 7-bit.
+    #define Vulintus_MCP4532    Vulintus_MCP4xxx_Static<MCP4532_traits>     // Single rheostat, I2C, RAM memory, 7-bit.
+    #define Vulintus_MCP4541    Vulintus_MCP4xxx_Static<MCP4541_traits>     // Single potentiometer, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4542    Vulintus_MCP4xxx_Static<MCP4542_traits>     // Single rheostat, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4551    Vulintus_MCP4xxx_Static<MCP4551_traits>     // Single potentiometer, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4552    Vulintus_MCP4xxx_Static<MCP4552_traits>     // Single rheostat, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4561    Vulintus_MCP4xxx_Static<MCP4561_traits>     // Single potentiometer, I2C, EE memory, 8-bit.
+    #define Vulintus_MCP4562    Vulintus_MCP4xxx_Static<MCP4562_traits>     // Single rheostat, I2C, EE memory, 8-bit.
+    #define Vulintus_MCP4631    Vulintus_MCP4xxx_Static<MCP4631_traits>     // Dual potentiometer, I2C, RAM memory, 7-bit. *
+    #define Vulintus_MCP4632    Vulintus_MCP4xxx_Static<MCP4632_traits>     // Dual rheostat, I2C, RAM memory, 7-bit.
+    #define Vulintus_MCP4641    Vulintus_MCP4xxx_Static<MCP4641_traits>     // Dual potentiometer, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4642    Vulintus_MCP4xxx_Static<MCP4642_traits>     // Dual rheostat, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4651    Vulintus_MCP4xxx_Static<MCP4651_traits>     // Dual potentiometer, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4652    Vulintus_MCP4xxx_Static<MCP4652_traits>     // Dual rheostat, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4661    Vulintus_MCP4xxx_Static<MCP4661_traits>     // Dual potentiometer, I2C, EE memory, 8-bit.
+    #define Vulintus_MCP4662    Vulintus_MCP4xxx_Static<MCP4662_traits>     // Dual rheostat, I2C, E memory, 8-bit.
+
+#else                                   // Runtime (virtual) MCP4xxx drivers.
+
+    #define Vulintus_MCP4131    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4131>         // Single potentiometer, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4132    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4132>         // Single rheostat, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4141    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4141>         // Single potentiometer, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4142    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4142>         // Single rheostat, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4151    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4151>         // Single potentiometer, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4152    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4152>         // Single rheostat, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4161    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4161>         // Single potentiometer, SPI, EE memory, 8-bit.
+    #define Vulintus_MCP4162    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4162>         // Single rheostat, SPI, EE memory, 8-bit.
+    #define Vulintus_MCP4231    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4231>         // Dual potentiometer, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4232    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4232>         // Dual rheostat, SPI, RAM memory, 7-bit.
+    #define Vulintus_MCP4241    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4241>         // Dual potentiometer, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4242    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4242>         // Dual rheostat, SPI, EE memory, 7-bit.
+    #define Vulintus_MCP4251    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4251>         // Dual potentiometer, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4252    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4252>         // Dual rheostat, SPI, RAM memory, 8-bit.
+    #define Vulintus_MCP4261    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4261>         // Dual potentiometer, SPI, EE memory, 8-bit.
+    #define Vulintus_MCP4262    Vulintus_MCP4xxx_SPI_Part<DIGIPOT_PART_MCP4262>         // Dual rheostat, SPI, E memory, 8-bit.
+
+    #define Vulintus_MCP4531    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4531>         // Single potentiometer, I2C, RAM memory, 7-bit.
+    #define Vulintus_MCP4532    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4532>         // Single rheostat, I2C, RAM memory, 7-bit.
+    #define Vulintus_MCP4541    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4541>         // Single potentiometer, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4542    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4542>         // Single rheostat, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4551    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4551>         // Single potentiometer, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4552    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4552>         // Single rheostat, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4561    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4561>         // Single potentiometer, I2C, EE memory, 8-bit.
+    #define Vulintus_MCP4562    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4562>         // Single rheostat, I2C, EE memory, 8-bit.
+    #define Vulintus_MCP4631    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4631>         // Dual potentiometer, I2C, RAM memory, 7-bit. *
+    #define Vulintus_MCP4632    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4632>         // Dual rheostat, I2C, RAM memory, 7-bit.
+    #define Vulintus_MCP4641    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4641>         // Dual potentiometer, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4642    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4642>         // Dual rheostat, I2C, EE memory, 7-bit.
+    #define Vulintus_MCP4651    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4651>         // Dual potentiometer, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4652    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4652>         // Dual rheostat, I2C, RAM memory, 8-bit.
+    #define Vulintus_MCP4661    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4661>         // Dual potentiometer, I2C, EE memory, 8-bit.
+    #define Vulintus_MCP4662    Vulintus_MCP4xxx_I2C_Part<DIGIPOT_PART_MCP4662>         // Dual rheostat, I2C, E memory, 8-bit.
+
+#endif      // #if defined(VULINTUS_DIGIPOT_STATIC)
 
 
 #endif      // #ifndef VULINTUS_DIGIPOT_H
\ No newline at end of file
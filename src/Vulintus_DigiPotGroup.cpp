@@ -0,0 +1,203 @@
+/*!
+	Vulintus_DigiPotGroup.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPotGroup.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPotGroup.h"
+
+
+// Class Constructor.
+Vulintus_DigiPotGroup::Vulintus_DigiPotGroup(void)
+{
+    n_members = 0;                                  // Start with an empty group.
+}
+
+
+// Add a device to the group (returns the member index, or -1 if full).
+int8_t Vulintus_DigiPotGroup::add(Vulintus_DigiPot *pot)
+{
+    if (n_members >= DIGIPOT_GROUP_MAX_MEMBERS) {   // If the group is full...
+        return -1;                                  // Return -1 to indicate an error.
+    }
+    uint8_t member_i = n_members++;                 // Grab the next member index.
+    _members[member_i] = pot;                       // Save the device pointer.
+
+    // Insert the new member into the bus/address sort order.
+    uintptr_t bus = (uintptr_t) pot->bus_handle();  // Grab the device's bus.
+    uint8_t addr = pot->bus_address();              // Grab the device's address.
+    uint8_t j = member_i;                           // Start at the end of the list.
+    while (j > 0) {                                 // Shift later-sorting members up.
+        Vulintus_DigiPot *prev = _members[_order[j - 1]];
+        uintptr_t prev_bus = (uintptr_t) prev->bus_handle();
+        if ((prev_bus < bus) || ((prev_bus == bus) && (prev->bus_address() <= addr))) {
+            break;
+        }
+        _order[j] = _order[j - 1];
+        j--;
+    }
+    _order[j] = member_i;                           // Insert the new member.
+    return member_i;                                // Return the member index.
+}
+
+
+// Fetch a pointer to a device in the group.
+Vulintus_DigiPot *Vulintus_DigiPotGroup::member(uint8_t member_i)
+{
+    if (member_i >= n_members) {                    // If the index is out of range...
+        return NULL;                                // Return a null pointer.
+    }
+    return _members[member_i];                      // Return the device pointer.
+}
+
+
+// Write a batch of wiper targets.
+uint8_t Vulintus_DigiPotGroup::set_codes(const DigiPot_target *targets, uint8_t n_targets, uint8_t *status)
+{
+    uint16_t codes[DIGIPOT_GROUP_MAX_MEMBERS][DIGIPOT_MAX_WIPERS];     // Final target for each wiper.
+    uint8_t masks[DIGIPOT_GROUP_MAX_MEMBERS];                           // Wipers with a target, per device.
+    bool bad_wiper[DIGIPOT_GROUP_MAX_MEMBERS];                          // Flags for devices targeted at a wiper no chip has.
+    uint8_t n_errors = 0;                                               // Number of devices that failed.
+
+    memset(masks, 0, sizeof(masks));                // Start with no targets.
+    memset(bad_wiper, 0, sizeof(bad_wiper));
+    for (uint8_t i = 0; i < n_targets; i++) {       // Step through the targets.
+        const DigiPot_target *t = &targets[i];      // Grab a pointer to the target.
+        if (t->member_i >= n_members) {             // If the device isn't in the group...
+            n_errors++;                             // Count the bad target as a failure.
+            continue;
+        }
+        if (t->wiper_i >= DIGIPOT_MAX_WIPERS) {     // If no supported chip has this wiper...
+            bad_wiper[t->member_i] = true;          // Fail the device's whole batch.
+            continue;
+        }
+        codes[t->member_i][t->wiper_i] = t->code;   // Later targets for the same wiper replace earlier ones.
+        masks[t->member_i] |= (1 << t->wiper_i);    // Mark the wiper as targeted.
+    }
+
+    for (uint8_t i = 0; i < n_members; i++) {       // Step through the devices in bus/address order.
+        uint8_t member_i = _order[i];               // Grab the member index.
+        uint8_t error = 0;                          // Assume no error.
+        if (bad_wiper[member_i]) {                  // If a target was for a wiper no chip has...
+            error = DIGIPOT_ERR_WIPER;              // Reject the device's batch without writing it.
+        }
+        else if (masks[member_i]) {                 // Otherwise, if this device has any targets...
+            error = _members[member_i]->set_codes(codes[member_i], masks[member_i]);   // Write all of its wipers at once (rejected if the chip lacks one).
+        }
+        if (error && (error != DIGIPOT_PENDING)) {  // If the write failed (queued writes aren't failures)...
+            n_errors++;                             // Count the failure.
+        }
+        if (status != NULL) {                       // If a status array was provided...
+            status[member_i] = error;               // Save the device's status.
+        }
+    }
+    return n_errors;                                // Return the number of failed devices.
+}
+
+
+// Hold every member's writes until "flush" (turning off flushes).
+uint8_t Vulintus_DigiPotGroup::set_staged(bool staged)
+{
+    uint8_t n_errors = 0;                           // Number of devices that failed to flush.
+    for (uint8_t i = 0; i < n_members; i++) {       // Step through the devices in bus/address order.
+        uint8_t error = _members[_order[i]]->set_staged(staged);  // Set each device's mode.
+        if (error && (error != DIGIPOT_PENDING)) {  // If the device's flush failed (it stays staged)...
+            n_errors++;                             // Count the failure.
+        }
+    }
+    return n_errors;                                // Return the number of failed devices.
+}
+
+
+// Send every member's staged wipers (returns the number of failed devices).
+uint8_t Vulintus_DigiPotGroup::flush(uint8_t *status)
+{
+    uint8_t n_errors = 0;                           // Number of devices that failed.
+    for (uint8_t i = 0; i < n_members; i++) {       // Step through the devices in bus/address order.
+        uint8_t member_i = _order[i];               // Grab the member index.
+        uint8_t error = _members[member_i]->flush();    // Send the device's changed wipers in one transaction.
+        if (error && (error != DIGIPOT_PENDING)) {  // If the write failed (queued writes aren't failures)...
+            n_errors++;                             // Count the failure.
+        }
+        if (status != NULL) {                       // If a status array was provided...
+            status[member_i] = error;               // Save the device's status.
+        }
+    }
+    return n_errors;                                // Return the number of failed devices.
+}
+
+
+#if defined(DIGIPOT_I2C_BATCH)
+
+// Flush, holding the writes on an I2C bus for one batch (returns the number of failed devices).
+uint8_t Vulintus_DigiPotGroup::flush_batch(TwoWire *i2c_bus, uint8_t *status)
+{
+    uint8_t member_status[DIGIPOT_GROUP_MAX_MEMBERS];  // Status of each device.
+    i2c_bus->begin_batch();                         // Hold the writes on this bus.
+    uint8_t n_errors = flush(member_status);        // Queue every member's staged wipers.
+    uint8_t error = i2c_bus->end_batch();           // Send the held writes.
+    return batch_result((void *) i2c_bus, error ? Vulintus_DigiPot_Bus::i2c_status(error) : DIGIPOT_OK, \
+            member_status, n_errors, status);       // Clear the caches if the batch failed.
+}
+
+#endif
+
+
+#if defined(DIGIPOT_SPI_BATCH)
+
+// Flush, holding the writes on an SPI bus for one batch (returns the number of failed devices).
+uint8_t Vulintus_DigiPotGroup::flush_batch(SPIClass *spi_bus, uint8_t *status)
+{
+    uint8_t member_status[DIGIPOT_GROUP_MAX_MEMBERS];  // Status of each device.
+    spi_bus->begin_batch();                         // Hold the writes on this bus.
+    uint8_t n_errors = flush(member_status);        // Queue every member's staged wipers.
+    uint8_t error = spi_bus->end_batch();           // Send the held writes.
+    return batch_result((void *) spi_bus, error ? DIGIPOT_ERR_BUS : DIGIPOT_OK, \
+            member_status, n_errors, status);       // Clear the caches if the batch failed.
+}
+
+#endif
+
+
+// Apply a batch's result to the members on its bus (returns the number of failed devices).
+uint8_t Vulintus_DigiPotGroup::batch_result(void *bus, DigiPot_status error, uint8_t *member_status, \
+        uint8_t n_errors, uint8_t *status)
+{
+    for (uint8_t i = 0; i < n_members; i++) {       // Step through the devices.
+        if (error && (_members[i]->bus_handle() == bus)) {     // If the batch failed and this device is on the bus...
+            _members[i]->clear_cache();             // The held writes may not have reached it.
+            _members[i]->restage();                 // Keep its targets staged for the next flush.
+            if (member_status[i] == DIGIPOT_OK) {   // If the device hadn't already failed...
+                member_status[i] = error;           // Report the batch error.
+                n_errors++;
+            }
+        }
+        if (status != NULL) {                       // If a status array was provided...
+            status[i] = member_status[i];           // Save the device's status.
+        }
+    }
+    return n_errors;                                // Return the number of failed devices.
+}
+
+
+// Mark every member's cached wiper values as unknown.
+void Vulintus_DigiPotGroup::clear_cache(void)
+{
+    for (uint8_t i = 0; i < n_members; i++) {       // Step through the devices.
+        _members[i]->clear_cache();
+    }
+}
+
+
+// Total staged targets replaced before reaching the bus.
+uint32_t Vulintus_DigiPotGroup::n_superseded(void)
+{
+    uint32_t n = 0;                                 // Running total.
+    for (uint8_t i = 0; i < n_members; i++) {       // Step through the devices.
+        n += _members[i]->n_superseded;
+    }
+    return n;                                       // Return the total.
+}
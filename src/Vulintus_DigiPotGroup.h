@@ -0,0 +1,98 @@
+/*!
+	Vulintus_DigiPotGroup.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Container for updating many digital potentiometers/rheostats on shared 
+	buses with the fewest possible transactions.
+
+	With "set_staged", any number of producers can set the members' wipers
+	during a control cycle without touching the bus. A single "flush" at the
+	end of the cycle then sends only the final value of each changed wiper,
+	one transaction per device, in bus/address order. Each member's
+	"n_superseded" counts the values that never reached the bus. A device
+	whose write fails keeps its staged targets, so the next "flush" sends
+	them again. Turning staged mode off flushes first, and a device whose
+	flush fails stays in staged mode.
+
+	On I2C cores that can hold writes and send them in one batch (the Linux
+	layer defines DIGIPOT_I2C_BATCH), "flush_batch" sends the whole flush
+	for one bus in a single batch. The drivers see the held writes as
+	successful, and the adapter doesn't report which message failed (it
+	stops at the first). So if the batch fails, every member on that bus
+	has its cached wipers cleared, keeps its staged targets for the next
+	flush, and is reported as failed. SPI buses that
+	can batch (DIGIPOT_SPI_BATCH) get the same "flush_batch", with the same
+	handling of a failed batch.
+
+	"set_codes" rejects a device's whole batch with DIGIPOT_ERR_WIPER if any
+	of its targets names a wiper the chip doesn't have. Targets for member
+	indices outside the group are counted as failures.
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPotGroup" class first created.
+		2026-10-17 - Drew Sloan - Added group-wide staged mode and "flush".
+		2026-10-17 - Drew Sloan - Added "flush_batch" and "clear_cache".
+		2026-10-17 - Drew Sloan - Added "flush_batch" for SPI buses.
+		2026-10-17 - Drew Sloan - Failed flushes and batches keep the staged 
+		                          targets.
+*/
+
+
+#ifndef VULINTUS_DIGIPOTGROUP_H
+#define VULINTUS_DIGIPOTGROUP_H
+
+#include <Arduino.h>                    //Standard Arduino header.
+
+#include "./Vulintus_DigiPot.h"         // Vulintus digital potentiometer base class.
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define DIGIPOT_GROUP_MAX_MEMBERS   16      // Maximum number of devices in a group.
+
+struct DigiPot_target {
+    uint8_t member_i;       // Index of the device in the group.
+    uint8_t wiper_i;        // Wiper index on the device.
+    uint16_t code;          // Target wiper value, in steps.
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPotGroup
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPotGroup(void);
+
+		// Public Variables. //
+        uint8_t n_members;      // Number of devices in the group.
+
+		// Public Functions. // 
+        int8_t add(Vulintus_DigiPot *pot);                  // Add a device to the group (returns the member index, or -1 if full).
+        Vulintus_DigiPot *member(uint8_t member_i);         // Fetch a pointer to a device in the group.
+        uint8_t set_codes(const DigiPot_target *targets, uint8_t n_targets, uint8_t *status = NULL);  // Write a batch of wiper targets (returns the number of failed devices and bad member indices).
+        uint8_t set_staged(bool staged);                    // Hold every member's writes until "flush" (turning off flushes, returns the number of failed devices).
+        uint8_t flush(uint8_t *status = NULL);              // Send every member's staged wipers (returns the number of failed devices).
+    #if defined(DIGIPOT_I2C_BATCH)
+        uint8_t flush_batch(TwoWire *i2c_bus, uint8_t *status = NULL);  // Flush, holding the writes on an I2C bus for one batch (returns the number of failed devices).
+    #endif
+    #if defined(DIGIPOT_SPI_BATCH)
+        uint8_t flush_batch(SPIClass *spi_bus, uint8_t *status = NULL); // Flush, holding the writes on an SPI bus for one batch (returns the number of failed devices).
+    #endif
+        void clear_cache(void);                             // Mark every member's cached wiper values as unknown.
+        uint32_t n_superseded(void);                        // Total staged targets replaced before reaching the bus.
+
+    private:
+
+        // Private Variables. //
+        Vulintus_DigiPot *_members[DIGIPOT_GROUP_MAX_MEMBERS];  // Device pointers, in the order they were added.
+        uint8_t _order[DIGIPOT_GROUP_MAX_MEMBERS];              // Member indices sorted by bus and address.
+
+        // Private Functions. //
+        uint8_t batch_result(void *bus, DigiPot_status error, uint8_t *member_status, \
+                uint8_t n_errors, uint8_t *status);             // Apply a batch's result to the members on its bus.
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOTGROUP_H
@@ -0,0 +1,561 @@
+/*!
+	Vulintus_DigiPot_Bus.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Bus.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot_Bus.h"
+
+
+// Shared transports, one per bus interface.
+static Vulintus_DigiPot_Bus digipot_buses[DIGIPOT_MAX_BUSES];
+
+
+// CLASS FUNCTIONS ***********************************************************//
+
+// Class Constructor.
+Vulintus_DigiPot_Bus::Vulintus_DigiPot_Bus(void)
+{
+    type = DIGIPOT_BUS_I2C;                 // Default to I2C.
+    _handle = NULL;                         // Not attached to a bus yet.
+    _begun = false;
+    _timeout_us = 0;                        // Use the core's default timeout.
+    _bound_us = 0;                          // No deadline is enforced yet.
+    _retry.n_retries = 0;                   // Don't retry by default.
+    _retry.backoff_us = 0;
+    _retry.budget_us = 0;
+    _budget_us = 0;
+    memset(_scanned, 0, sizeof(_scanned));  // No addresses have been scanned yet.
+    memset(_present, 0, sizeof(_present));
+    DIGIPOT_STAT(digipot_stats_clear(&_stats));     // Zero the performance counters.
+    invalidate();                           // No settings have been applied yet.
+}
+
+
+// Fetch the shared transport for an I2C bus (NULL if none are free).
+Vulintus_DigiPot_Bus *Vulintus_DigiPot_Bus::get(TwoWire *i2c_bus)
+{
+    return find((void *) i2c_bus, DIGIPOT_BUS_I2C);
+}
+
+
+// Fetch the shared transport for an SPI bus (NULL if none are free).
+Vulintus_DigiPot_Bus *Vulintus_DigiPot_Bus::get(SPIClass *spi_bus)
+{
+    return find((void *) spi_bus, DIGIPOT_BUS_SPI);
+}
+
+
+// Find or claim the transport for a bus.
+Vulintus_DigiPot_Bus *Vulintus_DigiPot_Bus::find(void *handle, DigiPot_bus_type bus_type)
+{
+    if (handle == NULL) {                                   // If there's no bus...
+        return NULL;                                        // There's no transport.
+    }
+    for (uint8_t i = 0; i < DIGIPOT_MAX_BUSES; i++) {       // Step through the transports.
+        if (digipot_buses[i]._handle == handle) {           // If this bus already has a transport...
+            return &digipot_buses[i];                       // Share it.
+        }
+    }
+    for (uint8_t i = 0; i < DIGIPOT_MAX_BUSES; i++) {       // Step through the transports again.
+        if (digipot_buses[i]._handle == NULL) {             // If this transport is unused...
+            digipot_buses[i]._handle = handle;              // Claim it for this bus.
+            digipot_buses[i].type = bus_type;
+            return &digipot_buses[i];
+        }
+    }
+    return NULL;                                            // All transports are in use.
+}
+
+
+// Initialize the bus (only once, no matter how many devices share it).
+void Vulintus_DigiPot_Bus::begin(void)
+{
+    if (_begun) {                           // If the bus is already initialized...
+        return;                             // Skip it.
+    }
+    if (type == DIGIPOT_BUS_I2C) {          // I2C mode.
+        i2c()->begin();                     // Initialize the I2C bus.
+    }
+    else {                                  // SPI mode.
+        spi()->begin();                     // Initialize the SPI bus.
+    }
+    _begun = true;                          // Don't initialize the bus again.
+    invalidate();                           // The bus is at its default settings.
+}
+
+
+// Forget the applied settings (call if other code reconfigures the bus).
+void Vulintus_DigiPot_Bus::invalidate(void)
+{
+    _clock = 0;                             // Force the next transaction to reapply its settings.
+}
+
+
+// Bus interface pointer.
+void *Vulintus_DigiPot_Bus::handle(void)
+{
+    return _handle;
+}
+
+
+// I2C interface pointer (NULL for SPI).
+TwoWire *Vulintus_DigiPot_Bus::i2c(void)
+{
+    return (type == DIGIPOT_BUS_I2C) ? (TwoWire *) _handle : NULL;
+}
+
+
+// SPI interface pointer (NULL for I2C).
+SPIClass *Vulintus_DigiPot_Bus::spi(void)
+{
+    return (type == DIGIPOT_BUS_SPI) ? (SPIClass *) _handle : NULL;
+}
+
+
+// Apply an I2C clock rate (Hs-mode rates also send the master code, so call before each transaction).
+DigiPot_status Vulintus_DigiPot_Bus::i2c_clock(uint32_t clock)
+{
+    uint8_t master_reply = 2;               // Reply to the Hs master code (a NACK is expected).
+    if (clock > DIGIPOT_I2C_FAST_HZ) {      // If this is a High-speed mode rate...
+        i2c_clock(DIGIPOT_I2C_FAST_HZ);     // The master code is sent at Fast-mode speed.
+        i2c()->beginTransmission(DIGIPOT_I2C_HS_MASTER);   // Send the master code.
+        master_reply = i2c()->endTransmission(false);      // Nobody acknowledges it. Keep the bus for a repeated start.
+    }
+    if (clock != _clock) {                  // If the clock rate needs to change...
+        i2c()->setClock(clock);             // Set the I2C clockrate.
+        _clock = clock;                     // Save the new clockrate.
+    }
+    if (master_reply == 2) {                // If the master code got the expected NACK (or wasn't needed)...
+        return DIGIPOT_OK;                  // The bus is ready.
+    }
+    return check_timeout((master_reply == 0) ? DIGIPOT_ERR_BUS : i2c_status(master_reply));    // An ACK or a bus error means Hs-mode wasn't entered.
+}
+
+
+// Check for an ACK from an I2C address (uses the last scan, if it covered the address).
+DigiPot_status Vulintus_DigiPot_Bus::i2c_probe(uint8_t addr, uint32_t clock)
+{
+    addr &= 0x7F;                                       // Limit the address to 7 bits.
+    if (_scanned[addr >> 3] & (1 << (addr & 0x07))) {   // If the last scan covered this address...
+        return i2c_present(addr) ? DIGIPOT_OK : DIGIPOT_ERR_NACK_ADDR;  // Return the scan result.
+    }
+    DIGIPOT_STAT(stats_start());                        // Start timing the transaction.
+    DigiPot_status status = i2c_clock(clock);           // Set the I2C clockrate (and enter Hs-mode, if needed).
+    if (status == DIGIPOT_OK) {                         // If the bus is ready...
+        i2c()->beginTransmission(addr);                 // Start an I2C transmission to the chip.
+        status = check_timeout(i2c_status(i2c()->endTransmission()));  // Check for an ACK from the chip.
+    }
+    DIGIPOT_STAT(stats_end(status, 0));                 // Count the result.
+    return status;                                      // Return the status.
+}
+
+
+// Write bytes to an I2C device (retried only if idempotent).
+DigiPot_status Vulintus_DigiPot_Bus::i2c_write(uint8_t addr, const uint8_t *tx, uint8_t n_tx, uint32_t clock, \
+        bool idempotent)
+{
+    TwoWire *wire = i2c();                              // Grab the I2C interface.
+    DigiPot_status status;                              // Transmission status.
+    uint8_t attempt = 0;                                // Count the attempts.
+    uint32_t t_start;                                   // Start time of each attempt.
+    do {
+        t_start = micros();                             // Save the start time.
+        DIGIPOT_STAT(stats_start());                    // Start timing the transaction.
+        status = i2c_clock(clock);                      // Set the I2C clockrate (and enter Hs-mode, if needed).
+        if (status == DIGIPOT_OK) {                     // If the bus is ready...
+            wire->beginTransmission(addr);              // Start I2C transmission.
+            for (uint8_t i = 0; i < n_tx; i++) {        // Step through the bytes.
+                wire->write(tx[i]);                     // Send each byte.
+            }
+            status = check_timeout(i2c_status(wire->endTransmission()));   // End the transmission.
+        }
+        DIGIPOT_STAT(stats_end(status, n_tx));          // Count the result.
+    } while (idempotent && retry_due(status, attempt++, t_start));     // Repeat failed writes, if allowed.
+    return status;                                      // Return the status.
+}
+
+
+// Probe a list of I2C addresses in one pass (returns the number found).
+uint8_t Vulintus_DigiPot_Bus::i2c_scan(const uint8_t *addrs, uint8_t n_addrs, uint32_t clock)
+{
+    uint8_t n_found = 0;                                // Count the devices found.
+    i2c_forget_scan();                                  // Forget the last scan.
+    for (uint8_t i = 0; i < n_addrs; i++) {             // Step through the addresses.
+        uint8_t addr = addrs[i] & 0x7F;                 // Grab the 7-bit address.
+        uint8_t bit = (1 << (addr & 0x07));             // Find the address in the bitmasks.
+        if (_scanned[addr >> 3] & bit) {                // Skip addresses that are listed twice.
+            continue;
+        }
+        _scanned[addr >> 3] |= bit;                     // Mark the address as scanned.
+        DIGIPOT_STAT(stats_start());                    // Start timing the transaction.
+        DigiPot_status status = i2c_clock(clock);       // Set the I2C clockrate (and enter Hs-mode, if needed).
+        if (status == DIGIPOT_OK) {                     // If the bus is ready...
+            i2c()->beginTransmission(addr);             // Start an I2C transmission to the address.
+            status = check_timeout(i2c_status(i2c()->endTransmission()));  // Check for an ACK.
+        }
+        DIGIPOT_STAT(stats_end(status, 0));             // Count the result.
+        if (status == DIGIPOT_OK) {                     // If a device ACKed...
+            _present[addr >> 3] |= bit;                 // Mark the address as present.
+            n_found++;                                  // Count the device.
+        }
+    }
+    return n_found;                                     // Return the number found.
+}
+
+
+// Check if the last scan found an I2C address.
+bool Vulintus_DigiPot_Bus::i2c_present(uint8_t addr)
+{
+    addr &= 0x7F;                                       // Limit the address to 7 bits.
+    return (_present[addr >> 3] & (1 << (addr & 0x07))) != 0;
+}
+
+
+// Forget the last scan (probes go back to the bus).
+void Vulintus_DigiPot_Bus::i2c_forget_scan(void)
+{
+    memset(_scanned, 0, sizeof(_scanned));              // No addresses are covered by a scan...
+    memset(_present, 0, sizeof(_present));              // ...or present.
+}
+
+
+// Read bytes from an I2C device.
+DigiPot_status Vulintus_DigiPot_Bus::i2c_read(uint8_t addr, uint8_t *rx, uint8_t n_rx, uint32_t clock)
+{
+    DigiPot_status status;                              // Transmission status.
+    uint8_t attempt = 0;                                // Count the attempts.
+    uint32_t t_start;                                   // Start time of each attempt.
+    do {
+        t_start = micros();                             // Save the start time.
+        DIGIPOT_STAT(stats_start());                    // Start timing the transaction.
+        status = i2c_clock(clock);                      // Set the I2C clockrate (and enter Hs-mode, if needed).
+        if (status == DIGIPOT_OK) {                     // If the bus is ready...
+            status = read_bytes(addr, rx, n_rx);        // Read the bytes.
+        }
+        DIGIPOT_STAT(stats_end(status, n_rx));          // Count the result.
+    } while (retry_due(status, attempt++, t_start));    // Repeat failed reads.
+    return status;                                      // Return the status.
+}
+
+
+// Request and read bytes from an I2C device.
+DigiPot_status Vulintus_DigiPot_Bus::read_bytes(uint8_t addr, uint8_t *rx, uint8_t n_rx, bool send_stop)
+{
+    TwoWire *wire = i2c();                              // Grab the I2C interface.
+    if (wire->requestFrom(addr, n_rx, (uint8_t) send_stop) < n_rx) {  // Request the bytes. If too few were returned...
+        while (wire->available()) {                     // Loop until the I2C buffer is cleared.
+            wire->read();                               // Read and discard each byte.
+        }
+        return check_timeout(DIGIPOT_ERR_SHORT_READ);   // Return a short read (or timeout) error.
+    }
+    for (uint8_t i = 0; i < n_rx; i++) {                // Step through the bytes.
+        rx[i] = wire->read();                           // Read each byte.
+    }
+    return DIGIPOT_OK;                                  // Return success.
+}
+
+
+// Write, then read with a repeated start.
+DigiPot_status Vulintus_DigiPot_Bus::i2c_write_read(uint8_t addr, const uint8_t *tx, uint8_t n_tx, \
+        uint8_t *rx, uint8_t n_rx, uint32_t clock)
+{
+    TwoWire *wire = i2c();                              // Grab the I2C interface.
+    DigiPot_status status;                              // Transmission status.
+    uint8_t attempt = 0;                                // Count the attempts.
+    uint32_t t_start;                                   // Start time of each attempt.
+    do {
+        t_start = micros();                             // Save the start time.
+        DIGIPOT_STAT(stats_start());                    // Start timing the transaction.
+        status = i2c_clock(clock);                      // Set the I2C clockrate (and enter Hs-mode, if needed).
+        if (status == DIGIPOT_OK) {                     // If the bus is ready...
+            wire->beginTransmission(addr);              // Start I2C transmission.
+            for (uint8_t i = 0; i < n_tx; i++) {        // Step through the bytes.
+                wire->write(tx[i]);                     // Send each byte.
+            }
+            status = check_timeout(i2c_status(wire->endTransmission(false)));  // End the write without a stop.
+        }
+        if (status == DIGIPOT_OK) {                     // If the write succeeded...
+            status = read_bytes(addr, rx, n_rx);        // Read the reply after a repeated start.
+        }
+        DIGIPOT_STAT(stats_end(status, n_tx + n_rx));   // Count the result.
+    } while (retry_due(status, attempt++, t_start));    // Repeat failed reads.
+    return status;                                      // Return the status.
+}
+
+
+// Run write/read segments as one transaction (retried only if idempotent).
+DigiPot_status Vulintus_DigiPot_Bus::i2c_transfer(uint8_t addr, const DigiPot_i2c_seg *segs, uint8_t n_segs, \
+        uint32_t clock, bool idempotent)
+{
+    TwoWire *wire = i2c();                              // Grab the I2C interface.
+    DigiPot_status status;                              // Transmission status.
+    uint8_t attempt = 0;                                // Count the attempts.
+    uint32_t t_start;                                   // Start time of each attempt.
+    do {
+        uint16_t n_bytes = 0;                           // Count the bytes sent and received.
+        t_start = micros();                             // Save the start time.
+        DIGIPOT_STAT(stats_start());                    // Start timing the transaction.
+        status = i2c_clock(clock);                      // Set the I2C clockrate (and enter Hs-mode, if needed).
+        for (uint8_t s = 0; (s < n_segs) && (status == DIGIPOT_OK); s++) {     // Step through the segments.
+            bool last = (s == n_segs - 1);              // Only the last segment ends with a stop.
+            wire->beginTransmission(addr);              // Start (or restart) the I2C transmission.
+            for (uint8_t i = 0; i < segs[s].n_tx; i++) {    // Step through the bytes.
+                wire->write(segs[s].tx[i]);             // Send each byte.
+            }
+            n_bytes += segs[s].n_tx;
+            if (segs[s].n_rx == 0) {                    // If this segment only writes...
+                status = check_timeout(i2c_status(wire->endTransmission(last)));   // End the write.
+                continue;
+            }
+            status = check_timeout(i2c_status(wire->endTransmission(false)));      // End the write without a stop.
+            if (status == DIGIPOT_OK) {                 // If the write succeeded...
+                status = read_bytes(addr, segs[s].rx, segs[s].n_rx, last);         // Read the reply after a repeated start.
+                n_bytes += segs[s].n_rx;
+            }
+        }
+        DIGIPOT_STAT(stats_end(status, n_bytes));       // Count the result.
+    } while (idempotent && retry_due(status, attempt++, t_start));     // Repeat failed transactions, if allowed.
+    return status;                                      // Return the status.
+}
+
+
+// Convert a Wire "endTransmission" code to a status.
+DigiPot_status Vulintus_DigiPot_Bus::i2c_status(uint8_t wire_error)
+{
+    if (wire_error > DIGIPOT_ERR_TIMEOUT) {             // If the core returned a non-standard code...
+        return DIGIPOT_ERR_BUS;                         // Report an "other" error.
+    }
+    return (DigiPot_status) wire_error;                 // Wire codes 0-5 match the status codes.
+}
+
+
+// Count the blocking Wire calls in an "i2c_transfer".
+uint8_t Vulintus_DigiPot_Bus::i2c_waits(const DigiPot_i2c_seg *segs, uint8_t n_segs)
+{
+    uint8_t n_waits = 0;                                // Count the waits.
+    for (uint8_t s = 0; s < n_segs; s++) {              // Step through the segments.
+        n_waits += (segs[s].n_rx > 0) ? 2 : 1;          // A read segment waits for its write and its read.
+    }
+    return n_waits;                                     // Return the count.
+}
+
+
+// Set the I2C transaction deadline (0 for the core default).
+void Vulintus_DigiPot_Bus::set_timeout(uint32_t timeout_us)
+{
+    _timeout_us = timeout_us;               // Save the deadline.
+    _bound_us = 0;                          // Nothing is enforced until the core accepts it.
+    if ((type != DIGIPOT_BUS_I2C) || (_handle == NULL) || (timeout_us == 0)) {     // If there's no I2C deadline to apply...
+        return;                             // Leave the core alone.
+    }
+    #if defined(WIRE_HAS_TIMEOUT)
+        i2c()->setWireTimeout(timeout_us, true);    // AVR/megaAVR/SAMD cores: abort (and reset the bus) at the deadline.
+        _bound_us = timeout_us;
+    #elif defined(ARDUINO_ARCH_ESP32)
+        uint32_t timeout_ms = (timeout_us / 1000) + ((timeout_us % 1000) > 0);     // ESP32 core: millisecond timeout (rounded up).
+        if (timeout_ms > 0xFFFF) {          // The core takes a 16-bit value.
+            timeout_ms = 0xFFFF;
+        }
+        i2c()->setTimeOut(timeout_ms);
+        _bound_us = (uint32_t) timeout_ms * 1000;
+    #endif
+}
+
+
+// Set the retry policy.
+void Vulintus_DigiPot_Bus::set_retry(const DigiPot_retry_policy &policy)
+{
+    _retry = policy;                        // Save the policy.
+    _budget_us = policy.budget_us;          // Start with a full budget.
+}
+
+
+// Refill the retry budget (call once per loop).
+void Vulintus_DigiPot_Bus::tick(void)
+{
+    _budget_us = _retry.budget_us;          // Restore the full budget.
+}
+
+
+// Longest a transaction call with "n_waits" blocking Wire calls can take, with retries (0 if unbounded).
+uint32_t Vulintus_DigiPot_Bus::worst_case_us(uint8_t n_waits, uint32_t clock)
+{
+    if (_bound_us == 0) {                   // If the core isn't enforcing a deadline...
+        return 0;                           // The core can block indefinitely.
+    }
+    if (clock > DIGIPOT_I2C_FAST_HZ) {      // If the transaction runs in Hs-mode...
+        n_waits++;                          // The master code is a separate wait.
+    }
+    uint32_t attempt_us = (uint32_t) n_waits * _bound_us;  // Every wait can run to the deadline.
+    uint32_t retry_us = 0;                  // Time for all of the retries.
+    for (uint8_t i = 0; i < _retry.n_retries; i++) {    // Step through the retries.
+        retry_us += ((uint32_t) _retry.backoff_us << i) + attempt_us;    // Add each backoff and attempt.
+    }
+    if ((_retry.budget_us > 0) && (retry_us > _retry.budget_us)) {   // If the budget is smaller...
+        retry_us = _retry.budget_us;        // The budget caps the retries.
+    }
+    return attempt_us + retry_us;           // Add the first attempt.
+}
+
+
+// Report a core timeout as DIGIPOT_ERR_TIMEOUT.
+DigiPot_status Vulintus_DigiPot_Bus::check_timeout(DigiPot_status status)
+{
+    #if defined(WIRE_HAS_TIMEOUT)
+        if ((status != DIGIPOT_OK) && (_timeout_us > 0) && i2c()->getWireTimeoutFlag()) {  // If the core hit the deadline...
+            i2c()->clearWireTimeoutFlag();  // Clear the flag.
+            return DIGIPOT_ERR_TIMEOUT;     // Report the timeout.
+        }
+    #endif
+    return status;                          // Otherwise, return the status unchanged.
+}
+
+
+// Check if a failed transaction should be repeated (and wait for the backoff).
+bool Vulintus_DigiPot_Bus::retry_due(DigiPot_status status, uint8_t attempt, uint32_t t_start)
+{
+    if ((status == DIGIPOT_OK) || (status == DIGIPOT_ERR_TOO_LONG) || (attempt >= _retry.n_retries)) {
+        return false;                       // Don't retry successes, oversized writes, or past the retry count.
+    }
+    uint32_t backoff = (uint32_t) _retry.backoff_us << attempt;    // Double the backoff for each retry.
+    uint32_t cost = backoff + (micros() - t_start);    // Estimate the retry time from the failed attempt.
+    if (_retry.budget_us > 0) {             // If retries are budgeted...
+        if (cost > _budget_us) {            // If the budget can't cover another try...
+            return false;                   // Give up.
+        }
+        _budget_us -= cost;                 // Charge the retry to the budget.
+    }
+    if (backoff >= 1000) {                  // If the backoff is long...
+        delay(backoff / 1000);              // Wait for the whole milliseconds.
+    }
+    delayMicroseconds(backoff % 1000);      // Wait for the remaining microseconds.
+    DIGIPOT_STAT(_stats.n_retries++);       // Count the retry.
+    return true;                            // Try again.
+}
+
+
+// Set up a chip select pin (output, high) and resolve its port register.
+void Vulintus_DigiPot_Bus::spi_cs_init(DigiPot_cs &cs)
+{
+    pinMode(cs.pin, OUTPUT);                // Set the CS pin mode to output.
+    digitalWrite(cs.pin, HIGH);             // Set the CS pin high.
+#if defined(DIGIPOT_CS_PORT_AVR)
+    uint8_t port = digitalPinToPort(cs.pin);        // Look up the pin's port.
+    if (port != NOT_A_PIN) {                        // If the pin has a port...
+        cs.out = portOutputRegister(port);          // Save the output register...
+        cs.mask = digitalPinToBitMask(cs.pin);      // ...and the pin's bitmask.
+    }
+#elif defined(DIGIPOT_CS_PORT_SAMD)
+    if (cs.pin < PINS_COUNT) {                      // If the pin is in the pin table...
+        const PinDescription &desc = g_APinDescription[cs.pin];
+        if (desc.ulPinType != PIO_NOT_A_PIN) {      // If the pin has a port...
+            cs.out_set = &(PORT->Group[desc.ulPort].OUTSET.reg);    // Save the set and clear registers...
+            cs.out_clr = &(PORT->Group[desc.ulPort].OUTCLR.reg);
+            cs.mask = (1UL << desc.ulPin);          // ...and the pin's bitmask.
+        }
+    }
+#endif
+}
+
+
+// Start an SPI transaction and pull chip select low.
+void Vulintus_DigiPot_Bus::spi_select(const DigiPot_cs &cs, uint32_t clock, uint8_t bit_order, uint8_t data_mode)
+{
+    if ((clock != _clock) || (bit_order != _bit_order) || (data_mode != _data_mode)) {   // If the settings have changed...
+        _spi_settings = SPISettings(clock, bit_order, data_mode);    // Rebuild the cached settings.
+        _clock = clock;                                             // Save the new settings.
+        _bit_order = bit_order;
+        _data_mode = data_mode;
+    }
+    DIGIPOT_STAT(stats_start());            // Start timing the transaction.
+    spi()->beginTransaction(_spi_settings); // Claim the SPI bus with the cached settings.
+    cs.low();                               // Set the chip select line low.
+}
+
+
+// Release chip select and end the SPI transaction (returns any transfer error).
+DigiPot_status Vulintus_DigiPot_Bus::spi_deselect(const DigiPot_cs &cs)
+{
+    cs.high();                              // Set the chip select line high.
+    DigiPot_status status = spi_status();   // Check for a failed transfer (some cores only send now).
+    spi()->endTransaction();                // Release the SPI bus.
+    DIGIPOT_STAT(stats_end(status, 0));     // Count the transaction (bytes are counted as they're sent).
+    return status;                          // Return the status.
+}
+
+
+// Exchange one byte over SPI.
+uint8_t Vulintus_DigiPot_Bus::spi_transfer(uint8_t data)
+{
+    DIGIPOT_STAT(_stats.n_bytes++);         // Count the byte.
+    return spi()->transfer(data);           // Send the byte and return the reply.
+}
+
+
+// Exchange a block of bytes over SPI (replies replace the sent bytes).
+DigiPot_status Vulintus_DigiPot_Bus::spi_transfer(uint8_t *buf, uint16_t n)
+{
+    if (n == 0) {                           // If there's nothing to send...
+        return DIGIPOT_OK;                  // Skip the transfer.
+    }
+    DIGIPOT_STAT(_stats.n_bytes += n);      // Count the bytes.
+    #if defined(DIGIPOT_SPI_DMA) && defined(ARDUINO_ARCH_SAMD)
+        spi()->transfer(buf, buf, n, true);     // Adafruit SAMD core: DMA transfer, wait for completion.
+    #elif defined(DIGIPOT_SPI_DMA) && defined(TEENSYDUINO)
+        spi()->transfer(buf, buf, n);           // Teensy core: buffered (FIFO/DMA) transfer.
+    #elif defined(DIGIPOT_SPI_DMA) && defined(ARDUINO_ARCH_ESP32)
+        spi()->transferBytes(buf, buf, n);      // ESP32 core: FIFO-backed block transfer.
+    #else
+        spi()->transfer(buf, n);                // Standard Arduino block transfer, in place.
+    #endif
+    return spi_status();                    // Check for a failed transfer.
+}
+
+
+// Check the core for a failed SPI transfer.
+DigiPot_status Vulintus_DigiPot_Bus::spi_status(void)
+{
+    #if defined(DIGIPOT_SPI_ERRORS)
+        return spi()->last_error() ? DIGIPOT_ERR_BUS : DIGIPOT_OK;     // The core reports failed transfers.
+    #else
+        return DIGIPOT_OK;                  // SPI has no acknowledge, so nothing else can be checked.
+    #endif
+}
+
+
+#if defined(DIGIPOT_STATS)
+
+// Performance counters for this bus.
+DigiPot_stats *Vulintus_DigiPot_Bus::stats(void)
+{
+    return &_stats;
+}
+
+
+// Zero the performance counters.
+void Vulintus_DigiPot_Bus::reset_stats(void)
+{
+    digipot_stats_clear(&_stats);
+}
+
+
+// Start timing a transaction.
+void Vulintus_DigiPot_Bus::stats_start(void)
+{
+    _stats_t0 = micros();                   // Save the start time.
+}
+
+
+// Finish timing a transaction and count its result.
+void Vulintus_DigiPot_Bus::stats_end(uint8_t status, uint16_t n_bytes)
+{
+    digipot_stats_latency(&_stats, micros() - _stats_t0);  // Add the transaction time to the histogram.
+    digipot_stats_status(&_stats, status);  // Count the transaction and its result.
+    _stats.n_bytes += n_bytes;              // Count the bytes.
+}
+
+#endif      // #if defined(DIGIPOT_STATS)
@@ -0,0 +1,323 @@
+/*!
+	Vulintus_DigiPot_Bus.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Shared bus transport for Vulintus digital potentiometers/rheostats. Every
+	device on the same TwoWire or SPIClass interface uses the same transport
+	object, which remembers the last clock rate and SPI settings applied to
+	the bus and only reconfigures the hardware when the next device needs
+	something different. Register reads use a repeated start between the
+	command write and the data read. All transport functions return a
+	"DigiPot_status" code.
+
+	Multi-byte SPI command streams are sent with a single block transfer.
+	Define DIGIPOT_SPI_DMA before including the library to use the core's 
+	DMA-capable (or FIFO-backed) block transfer where one exists (Adafruit 
+	SAMD, Teensy, ESP32). Other cores use the standard "transfer(buf, n)".
+
+	"i2c_scan" probes a list of I2C addresses in one pass and remembers which
+	of them answered. Until the next scan (or "i2c_forget_scan"), 
+	"i2c_probe" answers those addresses from the scan results with no bus 
+	traffic. So drivers started after a scan skip their own probe.
+
+	"set_timeout" sets a deadline for each I2C transaction. The Wire
+	library blocks, so the deadline is passed to the core's own timeout
+	where one exists ("setWireTimeout" on AVR/megaAVR/SAMD cores that define
+	WIRE_HAS_TIMEOUT, "setTimeOut" on ESP32). A transaction that times out
+	returns DIGIPOT_ERR_TIMEOUT. "set_retry" sets how many times a failed
+	write or read is repeated, with a doubling backoff between tries. The
+	budget caps the total retry time between calls to "tick", so one faulty
+	device can't stall the loop. The core's deadline applies to each 
+	blocking Wire call ("endTransmission" or "requestFrom"), not to a whole
+	transaction: "i2c_write" and "i2c_read" wait once, "i2c_write_read"
+	twice, "i2c_transfer" once per write segment and twice per read segment
+	("i2c_waits"), and an Hs-mode master code adds one more wait. With a 
+	timeout set, "worst_case_us" gives the longest a transaction call with a
+	given number of waits can take, with its retries, using the deadline the
+	core actually enforces (rounded up to whole milliseconds on ESP32). On
+	cores without a Wire timeout it returns 0 (unbounded). Address probes and
+	non-idempotent commands (increment/decrement) are never retried.
+	"i2c_transfer" runs a list of write/read segments as one transaction,
+	joined by repeated STARTs, under the same timeout and retry policy, for
+	drivers that send several commands and reads in one frame.
+
+	I2C clock rates above Fast-mode (400 kHz) use High-speed mode: before
+	each transaction, "i2c_clock" sends the Hs master code at 400 kHz, then
+	switches to the Hs clock so the transaction starts with a repeated
+	START. Devices drop back to Fast-mode at the STOP, so every Hs
+	transaction repeats the master code (about 25 us) and reprograms the
+	clock twice. The core must hold the bus after the unacknowledged master
+	code. The stock AVR, SAMD and ESP32 Wire libraries send a STOP instead,
+	which drops the devices straight back out of Hs-mode, so I2C is capped
+	at 400 kHz unless the core opts in: define DIGIPOT_I2C_HS_MODE (as a
+	build-wide compiler flag, or in the core's "Wire.h") only for a Wire
+	library that keeps the bus. A master code that fails with anything but
+	the expected NACK fails the transaction.
+
+	SPI chip select pins are resolved to a port register and bitmask once, 
+	in "spi_cs_init", and toggled with direct register writes after that 
+	(AVR and SAMD cores). "digitalWrite" repeats the pin-table lookups on 
+	every call, which costs more than a 16-bit transfer at a fast SCK. 
+	Other cores, pins without a port, and builds that define 
+	DIGIPOT_CS_DIGITALWRITE use "digitalWrite".
+
+	SPI has no acknowledge, so a transfer can only fail where the core says
+	so. An SPIClass that defines DIGIPOT_SPI_ERRORS (the Linux spidev layer,
+	the host build) keeps the first failed transfer since "beginTransaction"
+	in "last_error", and "spi_transfer" and "spi_deselect" then return
+	DIGIPOT_ERR_BUS. The spidev layer only sends at the chip select rising
+	edge, so drivers must check "spi_deselect". On other cores both always
+	return DIGIPOT_OK.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPot_Bus" class first created.
+		2026-10-17 - Drew Sloan - Added block SPI transfers.
+		2026-10-17 - Drew Sloan - Added I2C address scans, with probe results 
+                                  cached until the next scan.
+		2026-10-17 - Drew Sloan - Added optional per-bus performance counters 
+                                  (DIGIPOT_STATS).
+		2026-10-17 - Drew Sloan - Added I2C transaction timeouts and a retry 
+                                  policy with a per-tick time budget.
+		2026-10-17 - Drew Sloan - Added I2C High-speed mode (3.4 MHz).
+		2026-10-17 - Drew Sloan - Chip select pins are toggled through their 
+                                  port registers on AVR and SAMD.
+		2026-10-17 - Drew Sloan - High-speed mode is now opt-in per core 
+                                  (DIGIPOT_I2C_HS_MODE), and a failed master 
+                                  code fails the transaction.
+		2026-10-17 - Drew Sloan - Added "i2c_transfer" for multi-segment 
+                                  frames.
+		2026-10-17 - Drew Sloan - "worst_case_us" now uses the deadline the 
+                                  core actually enforces (0 if none).
+		2026-10-17 - Drew Sloan - "spi_transfer" and "spi_deselect" report 
+                                  failed transfers on cores that define 
+                                  DIGIPOT_SPI_ERRORS.
+		2026-10-17 - Drew Sloan - "worst_case_us" counts every blocking Wire 
+                                  call in a transaction (see "i2c_waits"), 
+                                  including the Hs master code.
+		2026-10-17 - Drew Sloan - Added "i2c_forget_scan", so probes go back to the 
+                                  bus once startup is over.
+		2026-10-17 - Drew Sloan - Added DIGIPOT_ERR_UNSUPPORTED.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_BUS_H
+#define VULINTUS_DIGIPOT_BUS_H
+
+#include <Arduino.h>                    // Standard Arduino header.
+#include <SPI.h>		                // Standard Arduino SPI library.
+#include <Wire.h>                       // Arduino I2C library.
+
+#include "./Vulintus_DigiPot_Stats.h"   // Optional performance counters.
+
+
+// DEFINITIONS *******************************************************************************************************//
+#ifndef DIGIPOT_MAX_BUSES
+    #define DIGIPOT_MAX_BUSES   4       // Maximum number of separate bus interfaces (change with a build-wide -D flag; a #define in the sketch doesn't reach the library).
+#endif
+
+#define DIGIPOT_I2C_FAST_HZ     400000      // I2C Fast-mode clock (the fastest rate without Hs-mode).
+#define DIGIPOT_I2C_HS_HZ       3400000     // I2C High-speed mode clock.
+#define DIGIPOT_I2C_HS_MASTER   0x04        // Hs master code (0000 1XXX), as the 7-bit address "beginTransmission" expects.
+
+#ifndef DIGIPOT_I2C_MAX_HZ
+    #if defined(DIGIPOT_I2C_HS_MODE)
+        #define DIGIPOT_I2C_MAX_HZ  DIGIPOT_I2C_HS_HZ       // The core keeps the bus after the Hs master code.
+    #else
+        #define DIGIPOT_I2C_MAX_HZ  DIGIPOT_I2C_FAST_HZ     // Stock Wire libraries send a STOP after the Hs master code.
+    #endif
+#endif
+
+#if !defined(DIGIPOT_CS_DIGITALWRITE)
+    #if defined(__AVR__)
+        #define DIGIPOT_CS_PORT_AVR                 // Toggle chip select through the AVR PORTx registers.
+    #elif defined(ARDUINO_ARCH_SAMD)
+        #define DIGIPOT_CS_PORT_SAMD                // Toggle chip select through the SAMD OUTSET/OUTCLR registers.
+    #endif
+#endif
+
+#if defined(__AVR__)
+    #define DIGIPOT_FENCE()     __asm__ __volatile__ ("" ::: "memory")      // Single core: only stop the compiler reordering.
+#else
+    #define DIGIPOT_FENCE()     __atomic_thread_fence(__ATOMIC_ACQ_REL)     // Acquire/release barrier (multi-core ESP32, Linux threads).
+#endif
+
+enum DigiPot_bus_type : uint8_t {
+    DIGIPOT_BUS_I2C = 0,            // I2C (TwoWire) bus.
+    DIGIPOT_BUS_SPI = 1,            // SPI (SPIClass) bus.
+};
+
+struct DigiPot_i2c_seg {
+    const uint8_t *tx;              // Bytes to write.
+    uint8_t n_tx;                   // Number of bytes to write.
+    uint8_t *rx;                    // Bytes read after a repeated start (NULL if the segment doesn't read).
+    uint8_t n_rx;                   // Number of bytes to read.
+};
+
+struct DigiPot_retry_policy {
+    uint8_t n_retries;              // Number of times a failed transaction is repeated (0 to disable).
+    uint16_t backoff_us;            // Wait before the first retry (doubles for each retry after that).
+    uint32_t budget_us;             // Total retry time allowed between calls to "tick" (0 for no limit).
+};
+
+struct DigiPot_cs {
+    uint8_t pin;                    // Chip select pin.
+#if defined(DIGIPOT_CS_PORT_AVR)
+    volatile uint8_t *out;          // Port output register (NULL to use "digitalWrite").
+    uint8_t mask;                   // Pin bitmask.
+#elif defined(DIGIPOT_CS_PORT_SAMD)
+    volatile uint32_t *out_set;     // Port output set register (NULL to use "digitalWrite").
+    volatile uint32_t *out_clr;     // Port output clear register.
+    uint32_t mask;                  // Pin bitmask.
+#endif
+
+    DigiPot_cs(uint8_t pin_cs = 0) : pin(pin_cs)
+    {
+    #if defined(DIGIPOT_CS_PORT_AVR)
+        out = NULL;                 // Not resolved until "spi_cs_init".
+    #elif defined(DIGIPOT_CS_PORT_SAMD)
+        out_set = out_clr = NULL;
+    #endif
+    }
+
+    inline void low(void) const                 // Pull the chip select line low.
+    {
+    #if defined(DIGIPOT_CS_PORT_AVR)
+        if (out) {
+            uint8_t sreg = SREG;                // Save the interrupt state.
+            cli();                              // The read-modify-write can't be interrupted.
+            *out &= ~mask;                      // Clear the pin.
+            SREG = sreg;                        // Restore the interrupt state.
+            return;
+        }
+    #elif defined(DIGIPOT_CS_PORT_SAMD)
+        if (out_clr) {
+            *out_clr = mask;                    // Clear the pin (a single atomic write).
+            return;
+        }
+    #endif
+        digitalWrite(pin, LOW);                 // Otherwise, use the core.
+    }
+
+    inline void high(void) const                // Release the chip select line.
+    {
+    #if defined(DIGIPOT_CS_PORT_AVR)
+        if (out) {
+            uint8_t sreg = SREG;                // Save the interrupt state.
+            cli();                              // The read-modify-write can't be interrupted.
+            *out |= mask;                       // Set the pin.
+            SREG = sreg;                        // Restore the interrupt state.
+            return;
+        }
+    #elif defined(DIGIPOT_CS_PORT_SAMD)
+        if (out_set) {
+            *out_set = mask;                    // Set the pin (a single atomic write).
+            return;
+        }
+    #endif
+        digitalWrite(pin, HIGH);                // Otherwise, use the core.
+    }
+};
+
+enum DigiPot_status : uint8_t {
+    DIGIPOT_OK              = 0,    // Success.
+    DIGIPOT_ERR_TOO_LONG    = 1,    // Data too long for the transmit buffer (Wire error 1).
+    DIGIPOT_ERR_NACK_ADDR   = 2,    // Address NACK (Wire error 2).
+    DIGIPOT_ERR_NACK_DATA   = 3,    // Data NACK (Wire error 3).
+    DIGIPOT_ERR_BUS         = 4,    // Other bus error (Wire error 4).
+    DIGIPOT_ERR_TIMEOUT     = 5,    // Bus timeout (Wire error 5).
+    DIGIPOT_ERR_SHORT_READ  = 6,    // Fewer bytes were returned than requested.
+    DIGIPOT_ERR_NO_BUS      = 7,    // No transport ("begin" not called, or too many buses).
+    DIGIPOT_PENDING         = 8,    // Transaction queued (asynchronous mode).
+    DIGIPOT_ERR_QUEUE_FULL  = 9,    // Transaction queue full (asynchronous mode).
+    DIGIPOT_ERR_WIPER       = 10,   // Wiper index out of range for the chip.
+    DIGIPOT_ERR_CANCELLED   = 11,   // Queued transaction dropped by "clear" (asynchronous mode).
+    DIGIPOT_ERR_UNKNOWN     = 12,   // Wiper value unknown, so a relative step can't be queued or staged.
+    DIGIPOT_ERR_UNSUPPORTED = 13,   // The part doesn't have the feature (e.g. nonvolatile wipers).
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPot_Bus
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPot_Bus(void);
+
+		// Public Variables. //
+        DigiPot_bus_type type;              // Bus type.
+
+		// Public Functions. //
+        static Vulintus_DigiPot_Bus *get(TwoWire *i2c_bus);    // Fetch the shared transport for an I2C bus (NULL if none are free).
+        static Vulintus_DigiPot_Bus *get(SPIClass *spi_bus);   // Fetch the shared transport for an SPI bus (NULL if none are free).
+
+        void begin(void);                   // Initialize the bus (only once, no matter how many devices share it).
+        void invalidate(void);              // Forget the applied settings (call if other code reconfigures the bus).
+        void *handle(void);                 // Bus interface pointer.
+        TwoWire *i2c(void);                 // I2C interface pointer (NULL for SPI).
+        SPIClass *spi(void);                // SPI interface pointer (NULL for I2C).
+
+        DigiPot_status i2c_clock(uint32_t clock);                                       // Apply an I2C clock rate (Hs-mode rates also send the master code, so call before each transaction).
+        DigiPot_status i2c_probe(uint8_t addr, uint32_t clock);                         // Check for an ACK from an I2C address (uses the last scan, if it covered the address).
+        uint8_t i2c_scan(const uint8_t *addrs, uint8_t n_addrs, uint32_t clock);        // Probe a list of I2C addresses in one pass (returns the number found).
+        bool i2c_present(uint8_t addr);                                                 // Check if the last scan found an I2C address.
+        void i2c_forget_scan(void);                                                     // Forget the last scan (probes go back to the bus).
+        DigiPot_status i2c_write(uint8_t addr, const uint8_t *tx, uint8_t n_tx, uint32_t clock, \
+                bool idempotent = true);                                                // Write bytes to an I2C device (retried only if idempotent).
+        DigiPot_status i2c_read(uint8_t addr, uint8_t *rx, uint8_t n_rx, uint32_t clock);          // Read bytes from an I2C device.
+        DigiPot_status i2c_write_read(uint8_t addr, const uint8_t *tx, uint8_t n_tx, \
+                uint8_t *rx, uint8_t n_rx, uint32_t clock);                             // Write, then read with a repeated start.
+        DigiPot_status i2c_transfer(uint8_t addr, const DigiPot_i2c_seg *segs, uint8_t n_segs, \
+                uint32_t clock, bool idempotent = true);                                // Run write/read segments as one transaction (retried only if idempotent).
+        static DigiPot_status i2c_status(uint8_t wire_error);                          // Convert a Wire "endTransmission" code to a status.
+        static uint8_t i2c_waits(const DigiPot_i2c_seg *segs, uint8_t n_segs);         // Count the blocking Wire calls in an "i2c_transfer".
+
+        void set_timeout(uint32_t timeout_us);                                          // Set the I2C transaction deadline (0 for the core default).
+        void set_retry(const DigiPot_retry_policy &policy);                             // Set the retry policy.
+        void tick(void);                                                                // Refill the retry budget (call once per loop).
+        uint32_t worst_case_us(uint8_t n_waits = 1, uint32_t clock = 0);                // Longest a transaction call with "n_waits" blocking Wire calls can take, with retries (0 if unbounded).
+
+        void spi_cs_init(DigiPot_cs &cs);                                               // Set up a chip select pin (output, high) and resolve its port register.
+        void spi_select(const DigiPot_cs &cs, uint32_t clock, uint8_t bit_order, uint8_t data_mode);   // Start an SPI transaction and pull chip select low.
+        DigiPot_status spi_deselect(const DigiPot_cs &cs);                              // Release chip select and end the SPI transaction (returns any transfer error).
+        uint8_t spi_transfer(uint8_t data);                                             // Exchange one byte over SPI.
+        DigiPot_status spi_transfer(uint8_t *buf, uint16_t n);                          // Exchange a block of bytes over SPI (replies replace the sent bytes).
+
+    #if defined(DIGIPOT_STATS)
+        DigiPot_stats *stats(void);                                                     // Performance counters for this bus.
+        void reset_stats(void);                                                         // Zero the performance counters.
+        void stats_start(void);                                                         // Start timing a transaction.
+        void stats_end(uint8_t status, uint16_t n_bytes);                               // Finish timing a transaction and count its result.
+    #endif
+
+    private:
+
+        // Private Variables. //
+        void *_handle;                      // Bus interface pointer (NULL if this transport is unused).
+        bool _begun;                        // Flag indicating the bus has been initialized.
+        uint32_t _clock;                    // Clock rate last applied to the bus (0 if unknown).
+        uint8_t _bit_order;                 // SPI bit order of the cached settings.
+        uint8_t _data_mode;                 // SPI data mode of the cached settings.
+        SPISettings _spi_settings;          // Cached SPI settings.
+        uint32_t _timeout_us;               // I2C transaction deadline (0 for the core default).
+        uint32_t _bound_us;                 // Deadline the core actually enforces (0 if none).
+        DigiPot_retry_policy _retry;        // Retry policy.
+        uint32_t _budget_us;                // Retry time left until the next "tick".
+        uint8_t _scanned[16];               // Bitmask of I2C addresses covered by the last scan.
+        uint8_t _present[16];               // Bitmask of I2C addresses that ACKed during the last scan.
+    #if defined(DIGIPOT_STATS)
+        DigiPot_stats _stats;               // Performance counters.
+        uint32_t _stats_t0;                 // Start time of the transaction being timed.
+    #endif
+
+        // Private Functions. //
+        static Vulintus_DigiPot_Bus *find(void *handle, DigiPot_bus_type bus_type);    // Find or claim the transport for a bus.
+        DigiPot_status read_bytes(uint8_t addr, uint8_t *rx, uint8_t n_rx, bool send_stop = true);    // Request and read bytes from an I2C device.
+        DigiPot_status check_timeout(DigiPot_status status);                           // Report a core timeout as DIGIPOT_ERR_TIMEOUT.
+        bool retry_due(DigiPot_status status, uint8_t attempt, uint32_t t_start);      // Check if a failed transaction should be repeated (and wait for the backoff).
+        DigiPot_status spi_status(void);                                               // Check the core for a failed SPI transfer.
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_BUS_H
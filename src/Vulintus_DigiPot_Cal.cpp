@@ -0,0 +1,140 @@
+/*!
+	Vulintus_DigiPot_Cal.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Cal.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot.h"
+
+#if defined(__AVR__)
+    #include <avr/eeprom.h>             // AVR EEPROM access.
+#endif
+
+
+// Class Constructor.
+Vulintus_DigiPot_Cal::Vulintus_DigiPot_Cal(void)
+{
+    n_codes = 0;                                    // No table loaded yet.
+    zero_mohm = 0;
+    step_mohm = 0;
+    delta_shift = 0;
+    _deltas = NULL;
+    _source = DIGIPOT_CAL_RAM;
+}
+
+
+// Use an existing table.
+bool Vulintus_DigiPot_Cal::begin(const int16_t *deltas, uint16_t num_codes, uint32_t zero, uint32_t step, \
+        uint8_t shift, DigiPot_cal_source source)
+{
+    #if !defined(__AVR__)
+        if (source == DIGIPOT_CAL_EEPROM) {         // EEPROM tables are only supported on AVR.
+            return false;
+        }
+    #endif
+    if ((num_codes < 2) || (deltas == NULL && source != DIGIPOT_CAL_EEPROM)) {
+        return false;                               // Return false for an empty table.
+    }
+    _deltas = deltas;                               // Save the table location.
+    _source = source;
+    n_codes = num_codes;                            // Save the line parameters.
+    zero_mohm = zero;
+    step_mohm = step;
+    delta_shift = shift;
+    return true;
+}
+
+
+// Build a RAM table from measured resistances.
+bool Vulintus_DigiPot_Cal::build(const float *measured_ohms, uint16_t num_codes, int16_t *deltas)
+{
+    if (num_codes < 2) {                            // A line needs at least two points.
+        return false;
+    }
+    float zero = measured_ohms[0] * 1000.0;                                     // Endpoint line, in milliohms.
+    float step = (measured_ohms[num_codes - 1] * 1000.0 - zero) / (num_codes - 1);
+    if ((zero < 0) || (step < 0)) {                 // The ladder must increase with code.
+        return false;
+    }
+    zero = (uint32_t) (zero + 0.5);                 // Round the line as it will be stored, so the deltas
+    step = (uint32_t) (step + 0.5);                 // absorb the rounding instead of it adding up along the ladder.
+    float max_dev = 0;                              // Find the largest deviation from the line.
+    for (uint16_t i = 0; i < num_codes; i++) {
+        float dev = fabs(measured_ohms[i] * 1000.0 - (zero + step * i));
+        if (dev > max_dev) {
+            max_dev = dev;
+        }
+    }
+    uint8_t shift = 0;                              // Pick the finest resolution that fits in 16 bits.
+    while ((max_dev / (float) (1UL << shift)) > 32767.0) {
+        shift++;
+    }
+    for (uint16_t i = 0; i < num_codes; i++) {      // Store the rounded deviations.
+        float dev = (measured_ohms[i] * 1000.0 - (zero + step * i)) / (float) (1UL << shift);
+        deltas[i] = (int16_t) ((dev < 0) ? (dev - 0.5) : (dev + 0.5));
+    }
+    return begin(deltas, num_codes, (uint32_t) zero, (uint32_t) step, shift, DIGIPOT_CAL_RAM);
+}
+
+
+// Look up the calibrated resistance of a code, in milliohms.
+uint32_t Vulintus_DigiPot_Cal::resistance_mohm(uint16_t code)
+{
+    if (n_codes < 2) {                              // If no table is loaded...
+        return DIGIPOT_MOHM_INVALID;                // Return the error value.
+    }
+    if (code >= n_codes) {                          // Clip the code to the table.
+        code = n_codes - 1;
+    }
+    int32_t r = (int32_t) (zero_mohm + (uint32_t) code * step_mohm);   // Straight-line value.
+    r += (int32_t) delta(code) * (1L << delta_shift);                   // Add the measured deviation.
+    return (r > 0) ? r : 0;                         // Resistance can't be negative.
+}
+
+
+// Find the code with the resistance closest to a target, in milliohms.
+uint16_t Vulintus_DigiPot_Cal::nearest_code(uint32_t mohm)
+{
+    if (n_codes < 2) {                              // If no table is loaded...
+        return 0;                                   // Return the bottom of the ladder.
+    }
+    uint16_t lo = 0;                                // Binary search for the last code at or below the target.
+    uint16_t hi = n_codes - 1;
+    if (mohm <= resistance_mohm(lo)) {
+        return lo;
+    }
+    if (mohm >= resistance_mohm(hi)) {
+        return hi;
+    }
+    while (hi - lo > 1) {
+        uint16_t mid = (lo + hi) >> 1;
+        if (resistance_mohm(mid) <= mohm) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    uint32_t below = mohm - resistance_mohm(lo);    // Pick the closer of the two neighbors.
+    uint32_t above = resistance_mohm(hi) - mohm;
+    return (above < below) ? hi : lo;
+}
+
+
+// Fetch one deviation from the table.
+int16_t Vulintus_DigiPot_Cal::delta(uint16_t code)
+{
+    switch (_source) {
+        case DIGIPOT_CAL_PROGMEM:
+            return (int16_t) pgm_read_word(&_deltas[code]);
+        #if defined(__AVR__)
+        case DIGIPOT_CAL_EEPROM:
+            return (int16_t) eeprom_read_word((const uint16_t *) &_deltas[code]);
+        #endif
+        default:
+            return _deltas[code];
+    }
+}
@@ -0,0 +1,71 @@
+/*!
+	Vulintus_DigiPot_Cal.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Per-step resistance calibration tables for Vulintus digital 
+	potentiometers/rheostats. A table stores the measured resistance of each 
+	wiper code as a fixed-point deviation from a straight line, so it fits in
+	two bytes per code in RAM, flash (PROGMEM), or EEPROM (AVR only):
+
+		R(code) = zero_mohm + (code * step_mohm) + (delta[code] << delta_shift)
+
+	All lookups are integer-only. Nearest-code searches are a binary search 
+	over the (monotonic) ladder.
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPot_Cal" class first created.
+		2026-10-17 - Drew Sloan - Lookups on a table that was never loaded now
+                                  return DIGIPOT_MOHM_INVALID (resistance) or 0 (code).
+		2026-10-17 - Drew Sloan - "build" measures the deltas from the rounded
+                                  line, so the step rounding doesn't add up.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_CAL_H
+#define VULINTUS_DIGIPOT_CAL_H
+
+#include <Arduino.h>                    //Standard Arduino header.
+
+
+// DEFINITIONS *******************************************************************************************************//
+enum DigiPot_cal_source : uint8_t {
+    DIGIPOT_CAL_RAM     = 0,    // Deltas are in RAM.
+    DIGIPOT_CAL_PROGMEM = 1,    // Deltas are in flash (PROGMEM).
+    DIGIPOT_CAL_EEPROM  = 2,    // Deltas are in EEPROM, starting at the given address (AVR only).
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPot_Cal
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPot_Cal(void);
+
+		// Public Variables. //
+        uint16_t n_codes;           // Number of codes in the table (n_resistors + 1).
+        uint32_t zero_mohm;         // Resistance at code 0, in milliohms.
+        uint32_t step_mohm;         // Straight-line resistance per step, in milliohms.
+        uint8_t delta_shift;        // Deltas are in units of 2^delta_shift milliohms.
+
+		// Public Functions. // 
+        bool begin(const int16_t *deltas, uint16_t num_codes, uint32_t zero, uint32_t step, \
+                uint8_t shift, DigiPot_cal_source source = DIGIPOT_CAL_RAM);        // Use an existing table.
+        bool build(const float *measured_ohms, uint16_t num_codes, int16_t *deltas);  // Build a RAM table from measured resistances.
+        uint32_t resistance_mohm(uint16_t code);        // Look up the calibrated resistance of a code, in milliohms.
+        uint16_t nearest_code(uint32_t mohm);           // Find the code with the resistance closest to a target, in milliohms.
+
+    private:
+
+        // Private Variables. //
+        const int16_t *_deltas;             // Deviation table (pointer, or EEPROM address).
+        DigiPot_cal_source _source;         // Memory holding the deviation table.
+
+        // Private Functions. //
+        int16_t delta(uint16_t code);       // Fetch one deviation from the table.
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_CAL_H
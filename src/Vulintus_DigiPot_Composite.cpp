@@ -0,0 +1,330 @@
+/*!
+	Vulintus_DigiPot_Composite.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Composite.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot.h"
+
+
+// CLASS FUNCTIONS ***********************************************************//
+
+// Class Constructor.
+Vulintus_DigiPot_Composite::Vulintus_DigiPot_Composite(Vulintus_DigiPot *pot_a, uint8_t wiper_a, \
+        Vulintus_DigiPot *pot_b, uint8_t wiper_b, DigiPot_composite_mode mode, \
+        DigiPot_composite_entry *table, uint16_t table_size)
+{
+    _pot_a = pot_a;                         // Save the first (coarse) part.
+    _wiper_a = wiper_a;
+    _pot_b = pot_b;                         // Save the second (fine) part.
+    _wiper_b = wiper_b;
+    _mode = mode;                           // Save the wiring arrangement.
+    _table = table;                         // Save the table buffer.
+    _table_max = table_size;
+    _n_entries = 0;                         // The table is built in "begin".
+    n_wipers = 1;                           // The composite acts like a single wiper.
+}
+
+
+// Initialization (starts both parts and builds the table).
+uint8_t Vulintus_DigiPot_Composite::begin(void)
+{
+    _status = (DigiPot_status) _pot_a->begin();     // Start the first part.
+    if ((_pot_b != _pot_a) && (_status == DIGIPOT_OK)) {    // If the second wiper is on a separate chip...
+        _status = (DigiPot_status) _pot_b->begin(); // Start the second part.
+    }
+    build();                                        // Build the resistance table.
+    clear_cache();                                  // Mark the composite value as unknown.
+    uint16_t code_a = _pot_a->get_code(_wiper_a);   // Grab the cached wiper values read during "begin".
+    uint16_t code_b = _pot_b->get_code(_wiper_b);
+    if ((code_a != DIGIPOT_CODE_INVALID) && (code_b != DIGIPOT_CODE_INVALID) && (_n_entries > 0)) {
+        cache_store(0, nearest_entry((uint32_t) (pair_resistance(code_a, code_b) * 1000.0 + 0.5)));
+    }
+    return _status;                                 // Return the status.
+}
+
+
+// Rebuild the table (call after changing either part's resistances).
+uint16_t Vulintus_DigiPot_Composite::build(void)
+{
+    _n_entries = 0;                                 // Start with an empty table.
+    if ((_table == NULL) || (_table_max < 2)) {     // If there's no room for a table...
+        return 0;                                   // Return zero entries.
+    }
+    float r_min = pair_resistance(0, 0);            // Find the lowest composite resistance.
+    float r_max = pair_resistance(_pot_a->n_resistors, _pot_b->n_resistors);    // Find the highest composite resistance.
+    float r_step = (r_max - r_min) / (float) (_table_max - 1);  // Calculate the spacing of the targets.
+    for (uint16_t i = 0; i < _table_max; i++) {     // Step through the evenly-spaced targets.
+        uint16_t code_a, code_b;                    // Best wiper pair for this target.
+        best_pair(r_min + r_step * (float) i, &code_a, &code_b);
+        uint32_t mohm = (uint32_t) (pair_resistance(code_a, code_b) * 1000.0 + 0.5);   // Convert the result to milliohms.
+        if (_n_entries > 0) {                       // If there's an entry to compare against...
+            uint32_t last = _table[_n_entries - 1].mohm;
+            if (mohm <= last + 1 + (last >> 20)) {  // If this pair duplicates it (to within the parts' milliohm and the float rounding)...
+                continue;                           // Skip it (nearest pairs never decrease, so the table stays sorted).
+            }
+        }
+        _table[_n_entries].mohm = mohm;             // Add the entry.
+        _table[_n_entries].code_a = code_a;
+        _table[_n_entries].code_b = code_b;
+        _n_entries++;
+    }
+    wiper_resistance.mohm = _table[0].mohm;                                 // The lowest resistance acts as the wiper resistance.
+    max_resistance.mohm = _table[_n_entries - 1].mohm - _table[0].mohm;     // The span acts as the ladder resistance.
+    n_resistors = _n_entries - 1;                   // Each table entry is one composite step.
+    return _n_entries;                              // Return the number of entries.
+}
+
+
+// Number of table entries in use.
+uint16_t Vulintus_DigiPot_Composite::table_size(void)
+{
+    return _n_entries;
+}
+
+
+// Composite resistance of a wiper pair (ohms).
+float Vulintus_DigiPot_Composite::pair_resistance(uint16_t code_a, uint16_t code_b)
+{
+    float r_a = _pot_a->code_resistance(code_a);    // Look up each part's resistance.
+    float r_b = _pot_b->code_resistance(code_b);
+    if (_mode == DIGIPOT_COMPOSITE_PARALLEL) {      // If the parts are in parallel...
+        return (r_a * r_b) / (r_a + r_b);           // Combine them in parallel.
+    }
+    return r_a + r_b;                               // Otherwise, combine them in series.
+}
+
+
+// Set the composite resistance (milliohms).
+uint32_t Vulintus_DigiPot_Composite::set_milliohms(uint32_t mohm, uint8_t /* wiper_i */)
+{
+    if (_n_entries == 0) {                          // If the table hasn't been built...
+        return DIGIPOT_MOHM_INVALID;                // Return the error value.
+    }
+    uint16_t code_a = _table[nearest_entry(mohm)].code_a;   // Look up the coarse code for the nearest entry.
+    uint16_t code_b = solve_b(mohm * 0.001, code_a);        // Solve the fine code for the exact target.
+    clear_cache();                                  // The pair may fall between table entries.
+    if (write_pair(code_a, code_b)) {               // Write both wipers. If the write failed...
+        return DIGIPOT_MOHM_INVALID;                // Return the error value.
+    }
+    return digipot_ohms_to_mohm(pair_resistance(code_a, code_b));  // Return the actual resistance.
+}
+
+
+// Read the composite resistance (milliohms).
+uint32_t Vulintus_DigiPot_Composite::get_milliohms(uint8_t /* wiper_i */, bool hw_read)
+{
+    uint16_t code_a = _pot_a->get_code(_wiper_a, hw_read);  // Fetch both wiper values.
+    uint16_t code_b = _pot_b->get_code(_wiper_b, hw_read);
+    if ((code_a == DIGIPOT_CODE_INVALID) || (code_b == DIGIPOT_CODE_INVALID)) {    // If either value is unknown...
+        return DIGIPOT_MOHM_INVALID;                // Return the error value.
+    }
+    return digipot_ohms_to_mohm(pair_resistance(code_a, code_b));  // Return the composite resistance.
+}
+
+
+// Set the composite position, 0-0xFFFF (0xFFFF is full scale).
+uint32_t Vulintus_DigiPot_Composite::set_ratio_q16(uint16_t ratio, uint8_t wiper_i)
+{
+    uint32_t mohm = wiper_resistance.mohm + (uint32_t) ((float) max_resistance.mohm * ratio / 65536.0);   // Convert to resistance.
+    if (ratio == 0xFFFF) {                          // 0xFFFF stands for full scale.
+        mohm = wiper_resistance.mohm + max_resistance.mohm;
+    }
+    if (set_milliohms(mohm, wiper_i) == DIGIPOT_MOHM_INVALID) {   // Write it. If the write failed...
+        return DIGIPOT_Q16_INVALID;                 // Return the error value.
+    }
+    return get_ratio_q16(wiper_i, false);           // Return the actual position.
+}
+
+
+// Read the composite position, 0-DIGIPOT_Q16_ONE.
+uint32_t Vulintus_DigiPot_Composite::get_ratio_q16(uint8_t wiper_i, bool hw_read)
+{
+    uint32_t mohm = get_milliohms(wiper_i, hw_read);    // Fetch the composite resistance.
+    if (mohm == DIGIPOT_MOHM_INVALID) {             // If the read failed...
+        return DIGIPOT_Q16_INVALID;                 // Return the error value.
+    }
+    if ((mohm <= wiper_resistance.mohm) || (max_resistance.mohm == 0)) {  // If the composite is at the bottom...
+        return 0;                                   // Return zero.
+    }
+    return (uint32_t) ((float) (mohm - wiper_resistance.mohm) * 65536.0 / max_resistance.mohm + 0.5);   // Return the rounded position.
+}
+
+
+// Bus interface pointer (of the first part).
+void *Vulintus_DigiPot_Composite::bus_handle(void)
+{
+    return _pot_a->bus_handle();
+}
+
+
+// I2C address or SPI chip select pin (of the first part).
+uint8_t Vulintus_DigiPot_Composite::bus_address(void)
+{
+    return _pot_a->bus_address();
+}
+
+
+// Longest a blocking call can take on both parts (0 if unbounded).
+uint32_t Vulintus_DigiPot_Composite::worst_case_us(DigiPot_call call)
+{
+    if (call != DIGIPOT_CALL_BEGIN) {               // Writes and reads go through "bus_write" and "bus_read"...
+        return Vulintus_DigiPot::worst_case_us(call);
+    }
+    uint32_t a_us = _pot_a->worst_case_us(DIGIPOT_CALL_BEGIN);     // ...but "begin" starts each part.
+    if (_pot_b == _pot_a) {                         // If both wipers are on one chip...
+        return a_us;                                // It only starts once.
+    }
+    uint32_t b_us = _pot_b->worst_case_us(DIGIPOT_CALL_BEGIN);
+    return ((a_us == 0) || (b_us == 0)) ? 0 : a_us + b_us;
+}
+
+
+// Longest one table write or read can take (0 if unbounded).
+uint32_t Vulintus_DigiPot_Composite::bus_worst_case_us(DigiPot_op op)
+{
+    uint32_t a_us, b_us;                            // Bounds for each part.
+    if (op == DIGIPOT_OP_READ) {                    // Reads read both parts.
+        a_us = _pot_a->worst_case_us(DIGIPOT_CALL_READ);
+        b_us = _pot_b->worst_case_us(DIGIPOT_CALL_READ);
+    }
+    else if ((_pot_a == _pot_b) && (_wiper_a != _wiper_b)) {   // Both wipers on one chip are written together...
+        return _pot_a->worst_case_us(DIGIPOT_CALL_WRITE_ALL);
+    }
+    else {                                          // ...otherwise each part is written in turn.
+        a_us = _pot_a->worst_case_us(DIGIPOT_CALL_WRITE);
+        b_us = _pot_b->worst_case_us(DIGIPOT_CALL_WRITE);
+    }
+    return ((a_us == 0) || (b_us == 0)) ? 0 : a_us + b_us;
+}
+
+
+// Write a table entry to both parts.
+uint8_t Vulintus_DigiPot_Composite::bus_write(uint16_t code, uint8_t /* wiper_i */)
+{
+    if (code >= _n_entries) {                       // If the table entry doesn't exist...
+        return DIGIPOT_ERR_BUS;                     // Report an "other" error.
+    }
+    return write_pair(_table[code].code_a, _table[code].code_b);   // Write the entry's wiper pair.
+}
+
+
+// Read both parts and find the nearest table entry.
+uint16_t Vulintus_DigiPot_Composite::bus_read(uint8_t wiper_i)
+{
+    uint32_t mohm = get_milliohms(wiper_i, true);  // Read the composite resistance from both parts.
+    if ((mohm == DIGIPOT_MOHM_INVALID) || (_n_entries == 0)) {     // If the read failed...
+        return DIGIPOT_CODE_INVALID;                // Return the error value.
+    }
+    return nearest_entry(mohm);                     // Return the nearest table entry.
+}
+
+
+// Find the second wiper code that best completes a target.
+uint16_t Vulintus_DigiPot_Composite::solve_b(float float_ohms, uint16_t code_a)
+{
+    float r_a = _pot_a->code_resistance(code_a);    // Look up the first part's resistance.
+    float r_b;                                      // Resistance needed from the second part.
+    if (_mode == DIGIPOT_COMPOSITE_PARALLEL) {      // If the parts are in parallel...
+        r_b = (float_ohms < r_a) ? (float_ohms * r_a) / (r_a - float_ohms) : 3.4e38;   // Solve 1/R = 1/Ra + 1/Rb.
+    }
+    else {                                          // Otherwise, if the parts are in series...
+        r_b = float_ohms - r_a;                     // Solve R = Ra + Rb.
+    }
+    uint16_t lo = 0, hi = _pot_b->n_resistors;      // Bracket the second part's codes.
+    while (lo < hi) {                               // Binary-search the first code at or above the needed resistance.
+        uint16_t mid = (lo + hi) >> 1;
+        if (_pot_b->code_resistance(mid) < r_b) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if ((lo > 0) && (fabs(pair_resistance(code_a, lo - 1) - float_ohms) <= fabs(pair_resistance(code_a, lo) - float_ohms))) {
+        lo--;                                       // Use the code below if it's closer.
+    }
+    return lo;                                      // Return the code.
+}
+
+
+// Find the best wiper pair for a target.
+void Vulintus_DigiPot_Composite::best_pair(float float_ohms, uint16_t *code_a, uint16_t *code_b)
+{
+    uint16_t first = 0, last = _pot_a->n_resistors;     // Range of coarse codes to try.
+    if (_mode == DIGIPOT_COMPOSITE_COARSE_FINE) {   // If the second part is the fine adjustment...
+        float r_coarse = float_ohms - _pot_b->code_resistance(0);  // Find the coarse resistance needed with the fine part at zero.
+        uint16_t lo = 0, hi = _pot_a->n_resistors;  // Binary-search the last coarse code at or below it.
+        while (lo < hi) {
+            uint16_t mid = (lo + hi + 1) >> 1;
+            if (_pot_a->code_resistance(mid) <= r_coarse) {
+                lo = mid;
+            }
+            else {
+                hi = mid - 1;
+            }
+        }
+        first = (lo > 0) ? lo - 1 : 0;              // Only the codes around it can be closest.
+        last = (lo < _pot_a->n_resistors) ? lo + 1 : lo;
+    }
+    float best_err = 3.4e38;                        // Smallest error seen so far.
+    for (uint16_t a = first; a <= last; a++) {      // Step through the coarse codes.
+        uint16_t b = solve_b(float_ohms, a);        // Solve the fine code.
+        float err = fabs(pair_resistance(a, b) - float_ohms);  // Calculate the error.
+        if (err < best_err) {                       // If this is the best pair so far...
+            best_err = err;                         // Save it.
+            *code_a = a;
+            *code_b = b;
+        }
+    }
+}
+
+
+// Binary-search the table for the nearest resistance.
+uint16_t Vulintus_DigiPot_Composite::nearest_entry(uint32_t mohm)
+{
+    uint16_t lo = 0, hi = _n_entries - 1;           // Bracket the table entries.
+    if (mohm >= _table[hi].mohm) {                  // If the target is at or above the top entry...
+        return hi;                                  // Use the top entry (the comparison below would wrap).
+    }
+    while (lo < hi) {                               // Find the first entry at or above the target.
+        uint16_t mid = (lo + hi) >> 1;
+        if (_table[mid].mohm < mohm) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if ((lo > 0) && ((mohm - _table[lo - 1].mohm) <= (_table[lo].mohm - mohm))) {
+        lo--;                                       // Use the entry below if it's closer.
+    }
+    return lo;                                      // Return the entry index.
+}
+
+
+// Write both wipers (one transaction if they share a chip).
+uint8_t Vulintus_DigiPot_Composite::write_pair(uint16_t code_a, uint16_t code_b)
+{
+    if ((_pot_a == _pot_b) && (_wiper_a != _wiper_b)) {    // If both wipers are on the same chip...
+        uint16_t codes[DIGIPOT_MAX_WIPERS];         // Values for the multi-wiper write.
+        codes[_wiper_a] = code_a;
+        codes[_wiper_b] = code_b;
+        uint8_t error = _pot_a->set_codes(codes, (1 << _wiper_a) | (1 << _wiper_b));    // Write both in one transaction.
+        _status = (error == DIGIPOT_PENDING) ? DIGIPOT_PENDING : _pot_a->status();
+        return error;                               // Return the error code.
+    }
+    if (_pot_a->set_code(code_a, _wiper_a) == DIGIPOT_CODE_INVALID) {  // Write the coarse wiper. If the write failed...
+        _status = _pot_a->status();                 // Report the first part's status.
+        return (_status != DIGIPOT_OK) ? _status : DIGIPOT_ERR_BUS;
+    }
+    if (_pot_b->set_code(code_b, _wiper_b) == DIGIPOT_CODE_INVALID) {  // Write the fine wiper. If the write failed...
+        _status = _pot_b->status();                 // Report the second part's status.
+        return (_status != DIGIPOT_OK) ? _status : DIGIPOT_ERR_BUS;
+    }
+    _status = _pot_b->status();                     // Report the second part's status.
+    return (_status == DIGIPOT_PENDING) ? DIGIPOT_PENDING : DIGIPOT_OK;
+}
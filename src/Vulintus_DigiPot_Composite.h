@@ -0,0 +1,104 @@
+/*!
+	Vulintus_DigiPot_Composite.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Virtual high-resolution potentiometer/rheostat built from two physical
+	wipers (two wipers on one chip, or one wiper on each of two chips) wired
+	in series, in parallel, or as a coarse/fine series pair.
+
+	When the composite starts, it builds a sorted index of achievable
+	resistances in a caller-provided table. Each entry is the best wiper
+	pair for one evenly-spaced target, and the entry number is the
+	composite's wiper code. "set_resistance" finds the nearest entry with a
+	single binary search, keeps its first wiper code, and then solves the
+	second wiper for the exact target. So the composite reaches the full
+	resolution of the pair, not just the table's resolution. Both wipers
+	are written in one transaction when they share a chip.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPot_Composite" class first created.
+		2026-10-17 - Drew Sloan - Now overrides the integer (milliohm and Q16) 
+                                  functions, which the float functions wrap.
+		2026-10-17 - Drew Sloan - Added "worst_case_us", from both parts' bounds.
+		2026-10-17 - Drew Sloan - Targets above the table use the top entry, and 
+                                  pairs that differ only by rounding count 
+                                  as duplicates.
+		2026-10-17 - Drew Sloan - "set_ratio_q16(0xFFFF)" is the top of the table.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_COMPOSITE_H
+#define VULINTUS_DIGIPOT_COMPOSITE_H
+
+#include <Arduino.h>                    //Standard Arduino header.
+
+#include "./Vulintus_DigiPot.h"         // Vulintus digital potentiometer base class.
+
+
+// DEFINITIONS *******************************************************************************************************//
+enum DigiPot_composite_mode : uint8_t {
+    DIGIPOT_COMPOSITE_SERIES        = 0,    // R = Ra + Rb.
+    DIGIPOT_COMPOSITE_PARALLEL      = 1,    // R = (Ra * Rb) / (Ra + Rb).
+    DIGIPOT_COMPOSITE_COARSE_FINE   = 2,    // R = Ra + Rb, where Rb's range spans at least one step of Ra.
+};
+
+struct DigiPot_composite_entry {
+    uint32_t mohm;                  // Composite resistance, in milliohms.
+    uint16_t code_a;                // First (coarse) wiper code.
+    uint16_t code_b;                // Second (fine) wiper code.
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPot_Composite : public Vulintus_DigiPot
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPot_Composite(Vulintus_DigiPot *pot_a, uint8_t wiper_a, Vulintus_DigiPot *pot_b, uint8_t wiper_b, \
+                DigiPot_composite_mode mode, DigiPot_composite_entry *table, uint16_t table_size);
+
+        // Public functions matching "Vulintus_DigiPot" base class. //
+        uint8_t begin(void);                                            // Initialization (starts both parts and builds the table).
+        uint32_t set_milliohms(uint32_t mohm, uint8_t wiper_i = 0);            // Set the composite resistance (milliohms).
+        uint32_t get_milliohms(uint8_t wiper_i = 0, bool hw_read = false);     // Read the composite resistance (milliohms).
+        uint32_t set_ratio_q16(uint16_t ratio, uint8_t wiper_i = 0);           // Set the composite position, 0-0xFFFF (0xFFFF is full scale).
+        uint32_t get_ratio_q16(uint8_t wiper_i = 0, bool hw_read = false);     // Read the composite position, 0-DIGIPOT_Q16_ONE.
+        void *bus_handle(void);                                         // Bus interface pointer (of the first part).
+        uint8_t bus_address(void);                                      // I2C address or SPI chip select pin (of the first part).
+        uint32_t worst_case_us(DigiPot_call call);                      // Longest a blocking call can take on both parts (0 if unbounded).
+
+        // Public Functions. //
+        uint16_t build(void);                                           // Rebuild the table (call after changing either part's resistances).
+        uint16_t table_size(void);                                      // Number of table entries in use.
+        float pair_resistance(uint16_t code_a, uint16_t code_b);        // Composite resistance of a wiper pair (ohms).
+
+    protected:
+
+        // Protected functions matching "Vulintus_DigiPot" base class. //
+        uint8_t bus_write(uint16_t code, uint8_t wiper_i);              // Write a table entry to both parts.
+        uint16_t bus_read(uint8_t wiper_i);                             // Read both parts and find the nearest table entry.
+        uint32_t bus_worst_case_us(DigiPot_op op);                      // Longest one table write or read can take (0 if unbounded).
+
+    private:
+
+        // Private Variables. //
+        Vulintus_DigiPot *_pot_a;               // First (coarse) part.
+        Vulintus_DigiPot *_pot_b;               // Second (fine) part.
+        uint8_t _wiper_a;                       // Wiper index on the first part.
+        uint8_t _wiper_b;                       // Wiper index on the second part.
+        DigiPot_composite_mode _mode;           // Wiring arrangement.
+        DigiPot_composite_entry *_table;        // Sorted index of achievable resistances.
+        uint16_t _table_max;                    // Table capacity.
+        uint16_t _n_entries;                    // Table entries in use.
+
+        // Private Functions. //
+        uint16_t solve_b(float float_ohms, uint16_t code_a);    // Find the second wiper code that best completes a target.
+        void best_pair(float float_ohms, uint16_t *code_a, uint16_t *code_b);  // Find the best wiper pair for a target.
+        uint16_t nearest_entry(uint32_t mohm);                  // Binary-search the table for the nearest resistance.
+        uint8_t write_pair(uint16_t code_a, uint16_t code_b);   // Write both wipers (one transaction if they share a chip).
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_COMPOSITE_H
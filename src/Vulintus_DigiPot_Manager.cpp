@@ -0,0 +1,181 @@
+/*!
+	Vulintus_DigiPot_Manager.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Manager.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot.h"
+
+
+// Every address used by a supported I2C part (MCP40D1x_E_I2C_ADDR is the same as MCP4XXX_I2C_ADDR_HHL).
+static const uint8_t digipot_scan_addrs[] = {
+    MCP4XXX_I2C_ADDR_LLL, MCP4XXX_I2C_ADDR_LLH, MCP4XXX_I2C_ADDR_LHL, MCP4XXX_I2C_ADDR_LHH,
+    MCP4XXX_I2C_ADDR_HLL, MCP4XXX_I2C_ADDR_HLH, MCP4XXX_I2C_ADDR_HHL, MCP4XXX_I2C_ADDR_HHH,
+    MCP40D18_AE_I2C_ADDR,
+    AD5273I2C_ADDR_L, AD5273I2C_ADDR_H,
+};
+
+
+// CLASS FUNCTIONS ***********************************************************//
+
+// Class Constructor.
+Vulintus_DigiPot_Manager::Vulintus_DigiPot_Manager(void)
+{
+    n_members = 0;                                  // Start with no drivers...
+    n_found = 0;                                    // ...and no devices.
+    startup_us = 0;
+    _n_scanned = 0;                                 // No buses have been scanned.
+    _timing = false;                                // The startup timer starts with the first scan.
+}
+
+
+// Register a driver (returns the member index, or -1 if full).
+int8_t Vulintus_DigiPot_Manager::add(Vulintus_DigiPot *pot)
+{
+    if (n_members >= DIGIPOT_MANAGER_MAX_MEMBERS) { // If the list is full...
+        return -1;                                  // Return -1 to indicate an error.
+    }
+    _members[n_members] = pot;                      // Save the driver pointer.
+    return n_members++;                             // Return the member index.
+}
+
+
+// Scan an I2C bus and identify what answers (returns the number found).
+uint8_t Vulintus_DigiPot_Manager::scan(TwoWire *i2c_bus, bool probe_steps)
+{
+    if (!_timing) {                                 // If this is the first step of startup...
+        _start_us = micros();                       // Start the timer.
+        _timing = true;
+    }
+    Vulintus_DigiPot_Bus *bus = Vulintus_DigiPot_Bus::get(i2c_bus);    // Grab the shared transport for this bus.
+    if (bus == NULL) {                              // If no transport is available...
+        return 0;                                   // Nothing can be found.
+    }
+    bus->begin();                                   // Initialize the I2C bus (once per bus).
+    uint8_t bus_i = 0;                              // Remember the bus, so "begin" can clear its scan.
+    while ((bus_i < _n_scanned) && (_scanned[bus_i] != bus)) {
+        bus_i++;
+    }
+    if (bus_i == _n_scanned) {
+        _scanned[_n_scanned++] = bus;
+    }
+    bus->i2c_scan(digipot_scan_addrs, sizeof(digipot_scan_addrs), SCAN_I2C_CLKRATE);   // Probe every candidate address.
+    uint8_t n = 0;                                  // Count the devices found on this bus.
+    for (uint8_t i = 0; i < sizeof(digipot_scan_addrs); i++) {     // Step through the candidate addresses.
+        if (!bus->i2c_present(digipot_scan_addrs[i]) || (n_found >= DIGIPOT_MANAGER_MAX_FOUND)) {
+            continue;                               // Skip addresses that didn't answer (or if the list is full).
+        }
+        DigiPot_found *dev = &_found[n_found++];    // Grab the next device record.
+        dev->bus = (void *) i2c_bus;                // Save the bus and address.
+        dev->addr = digipot_scan_addrs[i];
+        dev->member_i = -1;                         // No driver has been matched yet.
+        identify(bus, dev, probe_steps);            // Identify the chip.
+        n++;
+    }
+    startup_us = micros() - _start_us;              // Update the startup time.
+    return n;                                       // Return the number found.
+}
+
+
+// Start every registered driver (returns the number that failed).
+uint8_t Vulintus_DigiPot_Manager::begin(void)
+{
+    if (!_timing) {                                 // If there wasn't a scan...
+        _start_us = micros();                       // Start the timer.
+    }
+    uint8_t n_errors = 0;                           // Count the failures.
+    for (uint8_t i = 0; i < n_members; i++) {       // Step through the drivers.
+        if (_members[i]->begin() != DIGIPOT_OK) {   // Start each one. If it failed...
+            n_errors++;                             // Count the failure.
+        }
+        for (uint8_t j = 0; j < n_found; j++) {     // Step through the devices found.
+            if ((_found[j].bus == _members[i]->bus_handle()) && (_found[j].addr == _members[i]->bus_address())) {
+                _found[j].member_i = i;             // Match the device to its driver.
+            }
+        }
+    }
+    for (uint8_t i = 0; i < _n_scanned; i++) {      // Step through the scanned buses.
+        _scanned[i]->i2c_forget_scan();             // Send later probes to the bus, not the scan results.
+    }
+    _n_scanned = 0;
+    startup_us = micros() - _start_us;              // Save the total startup time.
+    _timing = false;                                // The next scan starts a new timer.
+    return n_errors;                                // Return the number that failed.
+}
+
+
+// Fetch a device found by a scan.
+const DigiPot_found *Vulintus_DigiPot_Manager::found(uint8_t found_i)
+{
+    if (found_i >= n_found) {                       // If the index is out of range...
+        return NULL;                                // Return a null pointer.
+    }
+    return &_found[found_i];                        // Return the device record.
+}
+
+
+// Find the scan result for a bus and address (NULL if not found).
+const DigiPot_found *Vulintus_DigiPot_Manager::find(void *bus, uint8_t addr)
+{
+    for (uint8_t i = 0; i < n_found; i++) {         // Step through the devices found.
+        if ((_found[i].bus == bus) && (_found[i].addr == addr)) {
+            return &_found[i];                      // Return the matching record.
+        }
+    }
+    return NULL;                                    // Return a null pointer if there's no match.
+}
+
+
+// Identify the chip at an address.
+void Vulintus_DigiPot_Manager::identify(Vulintus_DigiPot_Bus *bus, DigiPot_found *dev, bool probe_steps)
+{
+    uint8_t tx[2];                                  // Command bytes.
+    uint8_t rx[2];                                  // Reply bytes.
+    dev->family = DIGIPOT_FAMILY_UNKNOWN;           // Assume the chip can't be identified.
+    dev->n_resistors = 0;
+    dev->n_wipers = 1;
+
+    if ((dev->addr == AD5273I2C_ADDR_L) || (dev->addr == AD5273I2C_ADDR_H)) {  // Only the AD5273 uses these addresses.
+        dev->family = DIGIPOT_FAMILY_AD5273;
+        dev->n_resistors = 63;
+        return;
+    }
+    if (dev->addr == MCP40D18_AE_I2C_ADDR) {        // Only the MCP40D18-xxxAE uses this address.
+        dev->family = DIGIPOT_FAMILY_MCP40D1X;
+        dev->n_resistors = 127;
+        return;
+    }
+
+    tx[0] = MCP4XXX_REG_WIPER0 | MCP4XXX_CMD_READ;  // Try an MCP4xxx wiper 0 read.
+    if ((bus->i2c_write_read(dev->addr, tx, 1, rx, 2, SCAN_I2C_CLKRATE) == DIGIPOT_OK) && ((rx[0] & 0xFE) == 0xFE)) {
+        dev->family = DIGIPOT_FAMILY_MCP4XXX;       // Only an MCP4xxx returns 1s in the reserved bits.
+        uint16_t value = ((rx[0] & 0x01) << 8) | rx[1];     // Grab the wiper value.
+        tx[0] = MCP4XXX_REG_WIPER1 | MCP4XXX_CMD_READ;      // Try a wiper 1 read.
+        if (bus->i2c_write_read(dev->addr, tx, 1, rx, 2, SCAN_I2C_CLKRATE) == DIGIPOT_OK) {
+            dev->n_wipers = 2;                      // Only dual parts ACK the wiper 1 address.
+        }
+        if (value > 0x80) {                         // If the wiper is past 7-bit full scale...
+            dev->n_resistors = 256;                 // It must be an 8-bit part.
+        }
+        else if (probe_steps) {                     // Otherwise, if a write probe is allowed...
+            tx[0] = MCP4XXX_REG_WIPER0 | MCP4XXX_CMD_WRITE | 0x01;  // Write 8-bit full scale (0x100).
+            tx[1] = 0x00;
+            bus->i2c_write(dev->addr, tx, 2, SCAN_I2C_CLKRATE);
+            tx[0] = MCP4XXX_REG_WIPER0 | MCP4XXX_CMD_READ;  // Read it back (7-bit parts clamp to 0x80).
+            if (bus->i2c_write_read(dev->addr, tx, 1, rx, 2, SCAN_I2C_CLKRATE) == DIGIPOT_OK) {
+                dev->n_resistors = (rx[0] & 0x01) ? 256 : 128;
+            }
+            tx[0] = MCP4XXX_REG_WIPER0 | MCP4XXX_CMD_WRITE | ((value >> 8) & 0x01);    // Restore the original value.
+            tx[1] = value & 0xFF;
+            bus->i2c_write(dev->addr, tx, 2, SCAN_I2C_CLKRATE);
+        }
+        return;
+    }
+    if (dev->addr == MCP40D1x_E_I2C_ADDR) {         // If a non-MCP4xxx answered at the shared address...
+        dev->family = DIGIPOT_FAMILY_MCP40D1X;      // It's an MCP40D1x.
+        dev->n_resistors = 127;
+    }
+}
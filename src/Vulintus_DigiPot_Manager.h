@@ -0,0 +1,109 @@
+/*!
+	Vulintus_DigiPot_Manager.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Startup manager for boards with many digital potentiometers/rheostats.
+	"scan" initializes an I2C bus once. It then probes every address that a
+	supported part can use, in a single pass:
+		- MCP4xxx_I2C_addr  -> 0x28-0x2F (MCP45xx/46xx).
+		- MCP40D1x_I2C_addr -> 0x2E, 0x3E (MCP40D17/18/19).
+		- AD5273_I2C_addr   -> 0x58, 0x59 (AD5273).
+	Where a protocol probe can tell the families apart, each device that
+	answers is identified:
+		- An MCP4xxx read of wiper 0 returns 1s in its reserved bits.
+		  MCP40D1x parts NACK the command, which separates the two families
+		  at the shared address 0x2E.
+		- A wiper 1 read is only ACKed by dual parts.
+		- Wiper values above 0x80 identify 8-bit (256-step) MCP4xxx parts.
+		  With "probe_steps" set, the step count is also found for wipers at
+		  or below 0x80. Full scale is written, read back (7-bit parts clamp
+		  to 0x80), and the original value is restored. This briefly moves
+		  the wiper, so it is off by default.
+
+	"begin" starts every registered driver. Probes for scanned addresses
+	are answered from the scan results, so missing parts fail with no bus
+	traffic, and each bus is only initialized once. Every device that was
+	found is matched to the driver registered at its address. Once every
+	driver has started, the scanned buses forget their scans, so later
+	probes (e.g. a driver restarted after a fault) reach the bus again.
+	"startup_us" reports the total time spent in "scan" and "begin".
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPot_Manager" class first created.
+		2026-10-17 - Drew Sloan - "begin" clears the scan results when it's done.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_MANAGER_H
+#define VULINTUS_DIGIPOT_MANAGER_H
+
+#include <Arduino.h>                    //Standard Arduino header.
+
+#include "./Vulintus_DigiPot.h"         // Vulintus digital potentiometer base class.
+
+
+// DEFINITIONS *******************************************************************************************************//
+#ifndef DIGIPOT_MANAGER_MAX_MEMBERS
+    #define DIGIPOT_MANAGER_MAX_MEMBERS     16      // Maximum number of registered drivers (build-wide -D flag only; it sizes a member array).
+#endif
+
+#ifndef DIGIPOT_MANAGER_MAX_FOUND
+    #define DIGIPOT_MANAGER_MAX_FOUND       16      // Maximum number of devices recorded by scans (build-wide -D flag only; it sizes a member array).
+#endif
+
+enum DigiPot_family : uint8_t {
+    DIGIPOT_FAMILY_UNKNOWN  = 0,    // A device answered, but couldn't be identified.
+    DIGIPOT_FAMILY_AD5273   = 1,    // Analog Devices AD5273.
+    DIGIPOT_FAMILY_MCP40D1X = 2,    // Microchip MCP40D17/18/19.
+    DIGIPOT_FAMILY_MCP4XXX  = 3,    // Microchip MCP45xx/46xx.
+};
+
+struct DigiPot_found {
+    void *bus;                      // Bus interface pointer.
+    uint8_t addr;                   // I2C address.
+    DigiPot_family family;          // Chip family.
+    uint16_t n_resistors;           // Number of resistors in the ladder (0 if unknown).
+    uint8_t n_wipers;               // Number of wipers.
+    int8_t member_i;                // Index of the registered driver at this address (-1 if none).
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPot_Manager
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPot_Manager(void);
+
+		// Public Variables. //
+        uint8_t n_members;              // Number of registered drivers.
+        uint8_t n_found;                // Number of devices found by scans.
+        uint32_t startup_us;            // Total time spent in "scan" and "begin" (microseconds).
+
+		// Public Functions. //
+        int8_t add(Vulintus_DigiPot *pot);                          // Register a driver (returns the member index, or -1 if full).
+        uint8_t scan(TwoWire *i2c_bus = &Wire, bool probe_steps = false);   // Scan an I2C bus and identify what answers (returns the number found).
+        uint8_t begin(void);                                        // Start every registered driver (returns the number that failed).
+        const DigiPot_found *found(uint8_t found_i);                // Fetch a device found by a scan.
+        const DigiPot_found *find(void *bus, uint8_t addr);         // Find the scan result for a bus and address (NULL if not found).
+
+    private:
+
+        // Private Variables. //
+        Vulintus_DigiPot *_members[DIGIPOT_MANAGER_MAX_MEMBERS];    // Registered drivers.
+        DigiPot_found _found[DIGIPOT_MANAGER_MAX_FOUND];            // Devices found by scans.
+        Vulintus_DigiPot_Bus *_scanned[DIGIPOT_MAX_BUSES];          // Buses scanned since the last "begin".
+        uint8_t _n_scanned;             // Number of buses scanned since the last "begin".
+        uint32_t _start_us;             // Time the first scan (or "begin") started.
+        bool _timing;                   // Flag indicating the startup timer is running.
+
+        // Private Functions. //
+        void identify(Vulintus_DigiPot_Bus *bus, DigiPot_found *dev, bool probe_steps);    // Identify the chip at an address.
+
+        static const uint32_t SCAN_I2C_CLKRATE = 400000;            // Clock frequency for scans (supported by every part).
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_MANAGER_H
@@ -0,0 +1,123 @@
+/*!
+	Vulintus_DigiPot_Parts.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Parts.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot_Parts.h"
+#include "./Vulintus_DigiPot_Bus.h"      // I2C clock rates.
+
+
+#define RAB_AD5273      (DIGIPOT_RAB_1K | DIGIPOT_RAB_10K | DIGIPOT_RAB_50K | DIGIPOT_RAB_100K)     // AD5273 options.
+#define RAB_MCP         (DIGIPOT_RAB_5K | DIGIPOT_RAB_10K | DIGIPOT_RAB_50K | DIGIPOT_RAB_100K)     // Microchip options.
+#define F_SPI           DIGIPOT_PART_FLAG_SPI
+#define F_RHEO          DIGIPOT_PART_FLAG_RHEOSTAT
+#define F_NV            DIGIPOT_PART_FLAG_NV
+#define F_OTP           DIGIPOT_PART_FLAG_OTP
+#define F_HS            DIGIPOT_PART_FLAG_I2C_HS
+#define F_MUX           DIGIPOT_PART_FLAG_SDO_MUX
+
+// Part descriptors, in "DigiPot_part" order.
+static const DigiPot_part_desc digipot_parts[DIGIPOT_N_PARTS] PROGMEM = {
+//    Steps  Wipers  Flags                   Wiper   Options
+    {   0,   1,      0,                      0,      0           },     // DIGIPOT_PART_NONE
+    {  63,   1,      F_OTP,                  60,     RAB_AD5273  },     // DIGIPOT_PART_AD5273
+    { 127,   1,      F_RHEO,                 75,     RAB_MCP     },     // DIGIPOT_PART_MCP40D17
+    { 127,   1,      0,                      75,     RAB_MCP     },     // DIGIPOT_PART_MCP40D18
+    { 127,   1,      F_RHEO,                 75,     RAB_MCP     },     // DIGIPOT_PART_MCP40D19
+    { 128,   1,      F_SPI | F_MUX,          75,     RAB_MCP     },     // DIGIPOT_PART_MCP4131
+    { 128,   1,      F_SPI | F_RHEO,         75,     RAB_MCP     },     // DIGIPOT_PART_MCP4132
+    { 128,   1,      F_SPI | F_MUX | F_NV,   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4141
+    { 128,   1,      F_SPI | F_RHEO | F_NV,  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4142
+    { 256,   1,      F_SPI | F_MUX,          75,     RAB_MCP     },     // DIGIPOT_PART_MCP4151
+    { 256,   1,      F_SPI | F_RHEO,         75,     RAB_MCP     },     // DIGIPOT_PART_MCP4152
+    { 256,   1,      F_SPI | F_MUX | F_NV,   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4161
+    { 256,   1,      F_SPI | F_RHEO | F_NV,  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4162
+    { 128,   2,      F_SPI,                  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4231
+    { 128,   2,      F_SPI | F_RHEO,         75,     RAB_MCP     },     // DIGIPOT_PART_MCP4232
+    { 128,   2,      F_SPI | F_NV,           75,     RAB_MCP     },     // DIGIPOT_PART_MCP4241
+    { 128,   2,      F_SPI | F_RHEO | F_NV,  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4242
+    { 256,   2,      F_SPI,                  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4251
+    { 256,   2,      F_SPI | F_RHEO,         75,     RAB_MCP     },     // DIGIPOT_PART_MCP4252
+    { 256,   2,      F_SPI | F_NV,           75,     RAB_MCP     },     // DIGIPOT_PART_MCP4261
+    { 256,   2,      F_SPI | F_RHEO | F_NV,  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4262
+    { 128,   1,      F_HS,                   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4531
+    { 128,   1,      F_HS | F_RHEO,          75,     RAB_MCP     },     // DIGIPOT_PART_MCP4532
+    { 128,   1,      F_HS | F_NV,            75,     RAB_MCP     },     // DIGIPOT_PART_MCP4541
+    { 128,   1,      F_HS | F_RHEO | F_NV,   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4542
+    { 256,   1,      F_HS,                   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4551
+    { 256,   1,      F_HS | F_RHEO,          75,     RAB_MCP     },     // DIGIPOT_PART_MCP4552
+    { 256,   1,      F_HS | F_NV,            75,     RAB_MCP     },     // DIGIPOT_PART_MCP4561
+    { 256,   1,      F_HS | F_RHEO | F_NV,   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4562
+    { 128,   2,      F_HS,                   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4631
+    { 128,   2,      F_HS | F_RHEO,          75,     RAB_MCP     },     // DIGIPOT_PART_MCP4632
+    { 128,   2,      F_HS | F_NV,            75,     RAB_MCP     },     // DIGIPOT_PART_MCP4641
+    { 128,   2,      F_HS | F_RHEO | F_NV,   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4642
+    { 256,   2,      F_HS,                   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4651
+    { 256,   2,      F_HS | F_RHEO,          75,     RAB_MCP     },     // DIGIPOT_PART_MCP4652
+    { 256,   2,      F_HS | F_NV,            75,     RAB_MCP     },     // DIGIPOT_PART_MCP4661
+    { 256,   2,      F_HS | F_RHEO | F_NV,   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4662
+    { 128,   2,      F_SPI,                  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4XXX_SPI_128
+    { 256,   2,      F_SPI,                  75,     RAB_MCP     },     // DIGIPOT_PART_MCP4XXX_SPI_256
+    { 128,   2,      F_HS,                   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4XXX_I2C_128
+    { 256,   2,      F_HS,                   75,     RAB_MCP     },     // DIGIPOT_PART_MCP4XXX_I2C_256
+};
+
+
+// FUNCTIONS *****************************************************************//
+
+// Copy a part descriptor out of flash.
+bool digipot_part_read(DigiPot_part part, DigiPot_part_desc *desc)
+{
+    if (part >= DIGIPOT_N_PARTS) {                  // If the part index is out of range...
+        return false;                               // Return false.
+    }
+    const DigiPot_part_desc *p = &digipot_parts[part];     // Grab the flash address of the descriptor.
+    desc->n_resistors = pgm_read_word(&p->n_resistors);    // Copy each field.
+    desc->n_wipers = pgm_read_byte(&p->n_wipers);
+    desc->flags = pgm_read_byte(&p->flags);
+    desc->wiper_ohms = pgm_read_byte(&p->wiper_ohms);
+    desc->rab_options = pgm_read_byte(&p->rab_options);
+    return true;                                    // Return true.
+}
+
+
+// Fetch a part's flags from flash.
+uint8_t digipot_part_flags(DigiPot_part part)
+{
+    if (part >= DIGIPOT_N_PARTS) {                  // If the part index is out of range...
+        return 0;                                   // Return no flags.
+    }
+    return pgm_read_byte(&digipot_parts[part].flags);
+}
+
+
+// Fastest bus clock a part supports (Hz).
+uint32_t digipot_part_max_clock(DigiPot_part part)
+{
+    uint8_t flags = digipot_part_flags(part);       // Fetch the part's flags.
+    if (flags & DIGIPOT_PART_FLAG_SPI) {            // If the part is on an SPI bus...
+        return DIGIPOT_SPI_MAX_HZ;                  // Return the SPI limit.
+    }
+    if (flags & DIGIPOT_PART_FLAG_I2C_HS) {         // If the part supports I2C High-speed mode...
+        return DIGIPOT_I2C_HS_HZ;                   // Return the Hs-mode limit.
+    }
+    return DIGIPOT_I2C_FAST_HZ;                     // Otherwise, return the Fast-mode limit.
+}
+
+
+// Convert a resistance option to ohms.
+uint32_t digipot_rab_ohms(DigiPot_rab rab)
+{
+    switch (rab) {
+        case DIGIPOT_RAB_1K:    return 1000;
+        case DIGIPOT_RAB_5K:    return 5000;
+        case DIGIPOT_RAB_10K:   return 10000;
+        case DIGIPOT_RAB_50K:   return 50000;
+        case DIGIPOT_RAB_100K:  return 100000;
+    }
+    return 0;                                       // Return zero for an invalid option.
+}
@@ -0,0 +1,118 @@
+/*!
+	Vulintus_DigiPot_Parts.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Flash-resident (PROGMEM) descriptor table for every supported part. Each
+	descriptor holds the step count, wiper count, bus, rheostat/memory
+	flags, default wiper resistance, and the nominal end-to-end resistance
+	options. Drivers keep only a one-byte part index and load these
+	constants from flash when they need them. So there's a single copy of
+	the per-part constants no matter how many devices are declared.
+
+	The part aliases (Vulintus_MCP4131, Vulintus_MCP40D18, ...) select their
+	descriptor automatically. "set_nominal_resistance" picks one of the
+	part's resistance options. "wiper_resistance" and "max_resistance" stay
+	per-instance, so measured values can still override the defaults.
+
+	"digipot_part_max_clock" gives the fastest bus clock each part supports:
+	10 MHz for SPI, 3.4 MHz (Hs-mode) for the MCP45xx/46xx, and 400 kHz for
+	the MCP40D1x and AD5273. The single-potentiometer SPI parts (MCP41x1)
+	share one pin for SDI and SDO, so their reads are limited to 250 kHz.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Part descriptor table first created.
+		2026-10-17 - Drew Sloan - Added the bus clock limits.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_PARTS_H
+#define VULINTUS_DIGIPOT_PARTS_H
+
+#include <Arduino.h>                    //Standard Arduino header.
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define DIGIPOT_BUS_MIN_HZ          10000       // Slowest bus clock (the SMBus minimum).
+#define DIGIPOT_SPI_DEFAULT_HZ      1000000     // Default SPI clock.
+#define DIGIPOT_SPI_MAX_HZ          10000000    // Fastest SPI clock (MCP41xx/42xx).
+#define DIGIPOT_SPI_MUX_READ_HZ     250000      // Fastest SPI clock for reads through a shared SDI/SDO pin (MCP41x1).
+
+enum DigiPot_part : uint8_t {
+    DIGIPOT_PART_NONE = 0,          // No physical part (composites, adapters).
+    DIGIPOT_PART_AD5273,            // Single potentiometer, I2C, OTP, 6-bit.
+    DIGIPOT_PART_MCP40D17,          // Single rheostat, I2C, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP40D18,          // Single potentiometer, I2C, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP40D19,          // Single rheostat, I2C, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4131,           // Single potentiometer, SPI, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4132,           // Single rheostat, SPI, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4141,           // Single potentiometer, SPI, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4142,           // Single rheostat, SPI, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4151,           // Single potentiometer, SPI, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4152,           // Single rheostat, SPI, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4161,           // Single potentiometer, SPI, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4162,           // Single rheostat, SPI, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4231,           // Dual potentiometer, SPI, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4232,           // Dual rheostat, SPI, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4241,           // Dual potentiometer, SPI, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4242,           // Dual rheostat, SPI, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4251,           // Dual potentiometer, SPI, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4252,           // Dual rheostat, SPI, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4261,           // Dual potentiometer, SPI, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4262,           // Dual rheostat, SPI, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4531,           // Single potentiometer, I2C, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4532,           // Single rheostat, I2C, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4541,           // Single potentiometer, I2C, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4542,           // Single rheostat, I2C, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4551,           // Single potentiometer, I2C, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4552,           // Single rheostat, I2C, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4561,           // Single potentiometer, I2C, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4562,           // Single rheostat, I2C, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4631,           // Dual potentiometer, I2C, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4632,           // Dual rheostat, I2C, RAM memory, 7-bit.
+    DIGIPOT_PART_MCP4641,           // Dual potentiometer, I2C, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4642,           // Dual rheostat, I2C, EE memory, 7-bit.
+    DIGIPOT_PART_MCP4651,           // Dual potentiometer, I2C, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4652,           // Dual rheostat, I2C, RAM memory, 8-bit.
+    DIGIPOT_PART_MCP4661,           // Dual potentiometer, I2C, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4662,           // Dual rheostat, I2C, EE memory, 8-bit.
+    DIGIPOT_PART_MCP4XXX_SPI_128,   // Unspecified 7-bit MCP41xx/42xx (Vulintus_MCP4xxx_SPI_128_DigiPot).
+    DIGIPOT_PART_MCP4XXX_SPI_256,   // Unspecified 8-bit MCP41xx/42xx (Vulintus_MCP4xxx_SPI_256_DigiPot).
+    DIGIPOT_PART_MCP4XXX_I2C_128,   // Unspecified 7-bit MCP45xx/46xx (Vulintus_MCP4xxx_I2C_128_DigiPot).
+    DIGIPOT_PART_MCP4XXX_I2C_256,   // Unspecified 8-bit MCP45xx/46xx (Vulintus_MCP4xxx_I2C_256_DigiPot).
+    DIGIPOT_N_PARTS                 // Number of parts in the table.
+};
+
+enum DigiPot_part_flag : uint8_t {
+    DIGIPOT_PART_FLAG_SPI       = 0x01,     // SPI bus (I2C if clear).
+    DIGIPOT_PART_FLAG_RHEOSTAT  = 0x02,     // Rheostat (potentiometer if clear).
+    DIGIPOT_PART_FLAG_NV        = 0x04,     // Nonvolatile (EEPROM) wipers.
+    DIGIPOT_PART_FLAG_OTP       = 0x08,     // One-time-programmable wiper setting.
+    DIGIPOT_PART_FLAG_I2C_HS    = 0x10,     // I2C High-speed mode (3.4 MHz) support.
+    DIGIPOT_PART_FLAG_SDO_MUX   = 0x20,     // SDI and SDO share one pin (slower SPI reads).
+};
+
+enum DigiPot_rab : uint8_t {
+    DIGIPOT_RAB_1K      = 0x01,     // 1 kOhm end-to-end resistance.
+    DIGIPOT_RAB_5K      = 0x02,     // 5 kOhm end-to-end resistance.
+    DIGIPOT_RAB_10K     = 0x04,     // 10 kOhm end-to-end resistance.
+    DIGIPOT_RAB_50K     = 0x08,     // 50 kOhm end-to-end resistance.
+    DIGIPOT_RAB_100K    = 0x10,     // 100 kOhm end-to-end resistance.
+};
+
+struct DigiPot_part_desc {
+    uint16_t n_resistors;           // Number of resistors in the ladder (full-scale code).
+    uint8_t n_wipers;               // Number of wipers.
+    uint8_t flags;                  // Bus and memory flags (DigiPot_part_flag).
+    uint8_t wiper_ohms;             // Typical wiper resistance, in ohms.
+    uint8_t rab_options;            // Nominal end-to-end resistance options (DigiPot_rab bitmask).
+};
+
+
+// FUNCTIONS *********************************************************************************************************//
+bool digipot_part_read(DigiPot_part part, DigiPot_part_desc *desc);    // Copy a part descriptor out of flash.
+uint8_t digipot_part_flags(DigiPot_part part);                          // Fetch a part's flags from flash.
+uint32_t digipot_part_max_clock(DigiPot_part part);                     // Fastest bus clock a part supports (Hz).
+uint32_t digipot_rab_ohms(DigiPot_rab rab);                             // Convert a resistance option to ohms.
+
+#endif      // #ifndef VULINTUS_DIGIPOT_PARTS_H
@@ -0,0 +1,90 @@
+/*!
+	Vulintus_DigiPot_Queue.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Queue.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot.h"
+
+
+// CLASS FUNCTIONS ***********************************************************//
+
+// Class Constructor.
+Vulintus_DigiPot_Queue::Vulintus_DigiPot_Queue(void)
+{
+    n_dropped = 0;                          // Nothing has been dropped yet.
+    _head = 0;                              // Start with an empty ring.
+    _tail = 0;
+}
+
+
+// Queue a transaction.
+DigiPot_status Vulintus_DigiPot_Queue::push(Vulintus_DigiPot *pot, DigiPot_op op, uint8_t wiper_i, uint16_t code)
+{
+    uint8_t next = (_head + 1) % (DIGIPOT_QUEUE_LENGTH + 1);   // Find the slot after the head.
+    if (next == _tail) {                                    // If the ring is full...
+        n_dropped++;                                        // Count the dropped transaction.
+        return DIGIPOT_ERR_QUEUE_FULL;                      // Return the error.
+    }
+    DigiPot_transaction *t = &_slots[_head];                // Grab the free descriptor.
+    t->pot = pot;                                           // Fill in the descriptor.
+    t->op = op;
+    t->wiper_i = wiper_i;
+    t->code = code;
+    DIGIPOT_FENCE();                                        // Finish the descriptor before publishing it.
+    _head = next;                                           // Publish the descriptor.
+    return DIGIPOT_PENDING;                                 // The transaction is queued.
+}
+
+
+// Run the oldest queued transaction (returns the number run, 0 or 1).
+uint8_t Vulintus_DigiPot_Queue::poll(void)
+{
+    uint8_t tail = _tail;                                   // Only this function writes the tail.
+    if (tail == _head) {                                    // If the ring is empty...
+        return 0;                                           // There's nothing to run.
+    }
+    DIGIPOT_FENCE();                                        // Read the head before the descriptor it covers.
+    DigiPot_transaction t = _slots[tail];                   // Copy out the descriptor.
+    DIGIPOT_FENCE();                                        // Finish the copy before freeing the slot.
+    _tail = (tail + 1) % (DIGIPOT_QUEUE_LENGTH + 1);        // Free the slot before the callback can queue more.
+    t.pot->run_transaction(&t);                             // Run the transaction and report the result.
+    return 1;                                               // One transaction was run.
+}
+
+
+// Run every queued transaction (returns the number run).
+uint8_t Vulintus_DigiPot_Queue::flush(void)
+{
+    uint8_t n = 0;                                          // Count the transactions.
+    while (poll()) {                                        // Loop until the ring is empty.
+        n++;
+    }
+    return n;                                               // Return the count.
+}
+
+
+// Number of queued transactions.
+uint8_t Vulintus_DigiPot_Queue::pending(void)
+{
+    return (_head + (DIGIPOT_QUEUE_LENGTH + 1) - _tail) % (DIGIPOT_QUEUE_LENGTH + 1);
+}
+
+
+// Drop all queued transactions without running them (consumer context only, each is reported as cancelled).
+void Vulintus_DigiPot_Queue::clear(void)
+{
+    uint8_t head = _head;                                   // Only drop what's queued now (callbacks may queue more).
+    uint8_t tail = _tail;                                   // Only the consumer ("poll" and this function) writes the tail.
+    while (tail != head) {                                  // Loop until the snapshot is empty.
+        DIGIPOT_FENCE();                                    // Read the head before the descriptor it covers.
+        DigiPot_transaction t = _slots[tail];               // Copy out the descriptor.
+        DIGIPOT_FENCE();                                    // Finish the copy before freeing the slot.
+        tail = (tail + 1) % (DIGIPOT_QUEUE_LENGTH + 1);     // Free the slot before the callback can queue more.
+        _tail = tail;
+        t.pot->cancel_transaction(&t);                      // Forget the pending value and report the cancellation.
+    }
+}
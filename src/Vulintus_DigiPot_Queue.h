@@ -0,0 +1,102 @@
+/*!
+	Vulintus_DigiPot_Queue.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Asynchronous transaction queue for Vulintus digital potentiometers/
+	rheostats. When a device is given a queue with "set_async", its writes
+	and hardware reads are saved as transaction descriptors in a fixed ring
+	(no heap) and the call returns immediately with a DIGIPOT_PENDING status.
+	Calling "poll" runs the oldest queued transaction and then calls the
+	device's completion callback with the result code and any read data.
+	"clear" drops everything still queued. Each dropped write clears its
+	device's cached wiper value (the cache already holds the pending value),
+	and each dropped transaction is reported to the callback with a
+	DIGIPOT_ERR_CANCELLED status.
+
+	The Arduino Wire and SPI libraries are blocking, so each queued
+	transaction still occupies the CPU while it runs. The queue lets the
+	sketch choose when that happens (e.g. between sensor samples) and
+	bounds each "poll" call to a single short transaction. The ring is
+	single-producer/single-consumer, with a memory barrier between filling
+	a descriptor and publishing it, so "poll" may be called from a timer
+	interrupt on cores where Wire/SPI are interrupt-safe. "flush" and
+	"clear" free slots too, so they are consumer calls: run them in the
+	same context as "poll" (e.g. from the same interrupt, or with that
+	interrupt disabled), never while a "poll" could interrupt them.
+
+	DIGIPOT_QUEUE_LENGTH sets the size of every queue. It changes the class
+	layout, so it must be the same in every file: set it with a build-wide
+	compiler flag (e.g. -DDIGIPOT_QUEUE_LENGTH=16), never with a #define in
+	the sketch.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPot_Queue" class first created.
+		2026-10-17 - Drew Sloan - Added memory barriers around publishing and
+                                  freeing descriptors.
+		2026-10-17 - Drew Sloan - "clear" now reports each dropped transaction
+                                  and clears the pending wiper values.
+		2026-10-17 - Drew Sloan - Documented that "clear" must run in the 
+                                  consumer ("poll") context.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_QUEUE_H
+#define VULINTUS_DIGIPOT_QUEUE_H
+
+#include <Arduino.h>                    // Standard Arduino header.
+
+#include "./Vulintus_DigiPot_Bus.h"     // Shared bus transport (status codes).
+
+
+// DEFINITIONS *******************************************************************************************************//
+#ifndef DIGIPOT_QUEUE_LENGTH
+    #define DIGIPOT_QUEUE_LENGTH    8   // Number of transaction descriptors in each queue (build-wide flag only, see above).
+#endif
+
+class Vulintus_DigiPot;                 // Forward declaration of the base class.
+
+enum DigiPot_op : uint8_t {
+    DIGIPOT_OP_WRITE    = 0,            // Write a wiper value.
+    DIGIPOT_OP_READ     = 1,            // Read a wiper value.
+};
+
+typedef void (*DigiPot_callback)(Vulintus_DigiPot *pot, DigiPot_op op, uint8_t wiper_i, \
+        DigiPot_status status, uint16_t data, void *context);      // Completion callback.
+
+struct DigiPot_transaction {
+    Vulintus_DigiPot *pot;              // Device to address.
+    DigiPot_op op;                      // Operation.
+    uint8_t wiper_i;                    // Wiper index.
+    uint16_t code;                      // Value to write (ignored for reads).
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPot_Queue
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPot_Queue(void);
+
+		// Public Variables. //
+        uint32_t n_dropped;             // Transactions rejected because the queue was full.
+
+		// Public Functions. //
+        DigiPot_status push(Vulintus_DigiPot *pot, DigiPot_op op, uint8_t wiper_i, uint16_t code);  // Queue a transaction.
+        uint8_t poll(void);             // Run the oldest queued transaction (returns the number run, 0 or 1).
+        uint8_t flush(void);            // Run every queued transaction (returns the number run).
+        uint8_t pending(void);          // Number of queued transactions.
+        void clear(void);               // Drop all queued transactions without running them (consumer context only, reported as cancelled).
+
+    private:
+
+        // Private Variables. //
+        DigiPot_transaction _slots[DIGIPOT_QUEUE_LENGTH + 1];   // Transaction descriptors (one is always left empty).
+        volatile uint8_t _head;         // Next slot to fill (written only by "push").
+        volatile uint8_t _tail;         // Next slot to run (written only by the consumer: "poll" and "clear").
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_QUEUE_H
@@ -0,0 +1,115 @@
+/*!
+	Vulintus_DigiPot_Ramp.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Ramp.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot_Ramp.h"
+
+
+// Curve shapes, as fractions of the full ramp (Q15), at each segment boundary.
+static const uint16_t DIGIPOT_RAMP_EXP_Q15[DIGIPOT_RAMP_SEGMENTS + 1] PROGMEM = {
+    0, 174, 397, 683, 1050, 1523, 2129, 2907, 3906, 5189, 6837, 8952, 11668, 15156, 19634, 25385, 32768
+};
+static const uint16_t DIGIPOT_RAMP_SCURVE_Q15[DIGIPOT_RAMP_SEGMENTS + 1] PROGMEM = {
+    0, 368, 1408, 3024, 5120, 7600, 10368, 13328, 16384, 19440, 22400, 25168, 27648, 29744, 31360, 32400, 32768
+};
+
+
+// Class Constructor.
+Vulintus_DigiPot_Ramp::Vulintus_DigiPot_Ramp(void)
+{
+    _pot = NULL;                                    // No target device yet.
+    _running = false;                               // The ramp isn't running.
+}
+
+
+// Start a new ramp.
+bool Vulintus_DigiPot_Ramp::start(Vulintus_DigiPot *pot, uint8_t wiper_i, uint16_t start_code, uint16_t end_code, \
+        uint32_t duration_us, DigiPot_ramp_curve curve, uint32_t now_us)
+{
+    if (pot == NULL) {                              // If no device was specified...
+        return false;                               // Return false to indicate an error.
+    }
+    _pot = pot;                                     // Save the device pointer.
+    _wiper_i = wiper_i;                             // Save the wiper index.
+    _start_us = now_us;                             // Save the start time.
+    _seg_us = duration_us / DIGIPOT_RAMP_SEGMENTS;  // Calculate the segment duration.
+
+    // Precompute the wiper value at each segment boundary.
+    int32_t delta = (int32_t) end_code - (int32_t) start_code;     // Total change.
+    for (uint8_t i = 0; i <= DIGIPOT_RAMP_SEGMENTS; i++) {          // Step through the segment boundaries.
+        int32_t frac_q15;                           // Fraction of the full ramp (Q15).
+        switch (curve) {
+            case DIGIPOT_RAMP_EXPONENTIAL:
+                frac_q15 = pgm_read_word(&DIGIPOT_RAMP_EXP_Q15[i]);
+                break;
+            case DIGIPOT_RAMP_SCURVE:
+                frac_q15 = pgm_read_word(&DIGIPOT_RAMP_SCURVE_Q15[i]);
+                break;
+            default:
+                frac_q15 = ((int32_t) i << 15) / DIGIPOT_RAMP_SEGMENTS;
+                break;
+        }
+        _knots[i] = start_code + ((delta * frac_q15 + 0x4000) >> 15);  // Round to the nearest step (|delta * frac| < 2^31).
+    }
+
+    // Find a shift of the segment time that keeps (span * time) within 31 bits for the largest segment span.
+    uint32_t max_span = 1;                          // Largest change across one segment (at least 1).
+    for (uint8_t i = 0; i < DIGIPOT_RAMP_SEGMENTS; i++) {           // Step through the segments.
+        uint32_t span = (_knots[i + 1] > _knots[i]) ? (_knots[i + 1] - _knots[i]) : (_knots[i] - _knots[i + 1]);
+        if (span > max_span) {
+            max_span = span;
+        }
+    }
+    _shift = 0;
+    while ((_seg_us >> _shift) > (0x7FFFFFFFUL / max_span)) {       // While the product could overflow...
+        _shift++;                                   // Drop another bit of time resolution.
+    }
+
+    _last_code = _pot->move_to(start_code, _wiper_i);  // Move to the start value.
+    _running = true;                                // Mark the ramp as running.
+    return update(now_us);                          // Run the first update.
+}
+
+
+// Advance the ramp (returns true while the ramp is running).
+bool Vulintus_DigiPot_Ramp::update(uint32_t now_us)
+{
+    if (!_running) {                                // If the ramp isn't running...
+        return false;                               // There's nothing to do.
+    }
+    uint32_t elapsed = now_us - _start_us;          // Calculate the elapsed time (rollover-safe).
+    uint16_t code;                                  // Target wiper value for this tick.
+    uint32_t seg = (_seg_us > 0) ? (elapsed / _seg_us) : DIGIPOT_RAMP_SEGMENTS;    // Find the current segment.
+    if (seg >= DIGIPOT_RAMP_SEGMENTS) {             // If the ramp is finished...
+        code = _knots[DIGIPOT_RAMP_SEGMENTS];       // Use the end value.
+        _running = false;                           // Mark the ramp as finished.
+    }
+    else {                                          // Otherwise, interpolate within the segment.
+        int32_t rem = (elapsed - seg * _seg_us) >> _shift;          // Time into the segment.
+        int32_t span = (int32_t) _knots[seg + 1] - (int32_t) _knots[seg];   // Change across the segment.
+        code = _knots[seg] + (span * rem) / (int32_t) (_seg_us >> _shift);  // Linear interpolation.
+    }
+    if (code != _last_code) {                       // If the wiper needs to move...
+        _last_code = _pot->move_to(code, _wiper_i); // Send only the commands needed to get there.
+    }
+    return _running;                                // Return the running flag.
+}
+
+
+// Stop the ramp where it is.
+void Vulintus_DigiPot_Ramp::stop(void)
+{
+    _running = false;                               // Clear the running flag.
+}
+
+
+// Check if the ramp is running.
+bool Vulintus_DigiPot_Ramp::running(void)
+{
+    return _running;                                // Return the running flag.
+}
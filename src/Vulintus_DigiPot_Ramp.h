@@ -0,0 +1,64 @@
+/*!
+	Vulintus_DigiPot_Ramp.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Non-blocking wiper ramps for Vulintus digital potentiometers/rheostats.
+	Each ramp precomputes a piecewise-linear step schedule when it starts, 
+	then advances with a constant-time "update" call from the main loop.
+	
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPot_Ramp" class first created.
+		2026-10-17 - Drew Sloan - Full 16-bit wiper range, and the interpolation 
+		                          shift accounts for the segment span.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_RAMP_H
+#define VULINTUS_DIGIPOT_RAMP_H
+
+#include <Arduino.h>                    //Standard Arduino header.
+
+#include "./Vulintus_DigiPot.h"         // Vulintus digital potentiometer base class.
+
+
+// DEFINITIONS *******************************************************************************************************//
+#define DIGIPOT_RAMP_SEGMENTS   16      // Number of linear segments in a precomputed ramp schedule.
+
+enum DigiPot_ramp_curve : uint8_t {
+    DIGIPOT_RAMP_LINEAR         = 0,    // Constant rate.
+    DIGIPOT_RAMP_EXPONENTIAL    = 1,    // Slow start, fast finish (e^4x).
+    DIGIPOT_RAMP_SCURVE         = 2,    // Slow start and finish (smoothstep).
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPot_Ramp
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPot_Ramp(void);
+
+		// Public Functions. // 
+        bool start(Vulintus_DigiPot *pot, uint8_t wiper_i, uint16_t start_code, uint16_t end_code, \
+                uint32_t duration_us, DigiPot_ramp_curve curve, uint32_t now_us);   // Start a new ramp.
+        bool update(uint32_t now_us);       // Advance the ramp (returns true while the ramp is running).
+        void stop(void);                    // Stop the ramp where it is.
+        bool running(void);                 // Check if the ramp is running.
+
+    private:
+
+        // Private Variables. //
+        Vulintus_DigiPot *_pot;                         // Target device.
+        uint8_t _wiper_i;                               // Target wiper.
+        bool _running;                                  // Ramp running flag.
+        uint32_t _start_us;                             // Ramp start time, in microseconds.
+        uint32_t _seg_us;                               // Duration of each segment, in microseconds.
+        uint8_t _shift;                                 // Right-shift of the segment time that keeps (span * time) within 31 bits.
+        uint16_t _last_code;                            // Last wiper value sent to the device.
+        uint16_t _knots[DIGIPOT_RAMP_SEGMENTS + 1];     // Wiper values at each segment boundary.
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_RAMP_H
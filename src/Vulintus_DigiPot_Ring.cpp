@@ -0,0 +1,122 @@
+/*!
+	Vulintus_DigiPot_Ring.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Ring.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot.h"
+
+
+// CLASS FUNCTIONS ***********************************************************//
+
+// Class Constructor.
+Vulintus_DigiPot_Ring::Vulintus_DigiPot_Ring(void)
+{
+    n_overflows = 0;                        // Zero the counters.
+    n_coalesced = 0;
+    n_written = 0;
+    n_invalid = 0;
+    _head = 0;                              // Start with an empty ring.
+    _tail = 0;
+    _n_dropped = 0;
+    _overflows_seen = 0;
+    _n_devs = 0;                            // No drivers are registered yet.
+}
+
+
+// Register a driver (returns the device index, or -1 if full).
+int8_t Vulintus_DigiPot_Ring::add(Vulintus_DigiPot *pot)
+{
+    if (_n_devs >= DIGIPOT_RING_MAX_DEVICES) {              // If the device table is full...
+        return -1;                                          // Return the error value.
+    }
+    _devs[_n_devs] = pot;                                   // Save the driver pointer.
+    return _n_devs++;                                       // Return its index.
+}
+
+
+// Coalesce and send everything in the ring (returns the number of wiper writes).
+uint8_t Vulintus_DigiPot_Ring::drain(void)
+{
+    DigiPot_ring_cmd latest[DIGIPOT_RING_LENGTH];           // Latest command for each wiper, in first-seen order.
+    uint8_t n = 0;                                          // Number of wipers to write.
+
+    count_overflows();                                      // Report any dropped commands.
+    uint8_t head = _head;                                   // Take everything pushed so far.
+    DIGIPOT_FENCE();                                   // Read the head before the commands it covers.
+    for (uint8_t tail = _tail; tail != head; tail++) {      // Step through the commands.
+        DigiPot_ring_cmd cmd = _slots[tail & (DIGIPOT_RING_LENGTH - 1)];
+        uint8_t wiper_i = cmd.wiper_flags & 0x0F;           // Grab the wiper index.
+        int8_t i = n - 1;
+        while ((i >= 0) && ((latest[i].dev_i != cmd.dev_i) || ((latest[i].wiper_flags & 0x0F) != wiper_i))) {
+            i--;                                            // Find the latest command for the same wiper.
+        }
+        if ((i >= 0) && !((latest[i].wiper_flags >> 4) & DIGIPOT_RING_BARRIER)) {  // If it can be replaced...
+            latest[i] = cmd;                                // Keep only the newer value.
+            n_coalesced++;
+        }
+        else {                                              // Otherwise...
+            latest[n++] = cmd;                              // Add the command.
+        }
+    }
+    DIGIPOT_FENCE();                                   // Finish reading the commands before freeing them.
+    _tail = head;                                           // Free the slots, so ISRs can refill them during the bus writes.
+
+    for (uint8_t i = 0; i < n; i++) {                       // Step through the wipers.
+        if (latest[i].dev_i >= _n_devs) {                   // If the device isn't registered...
+            n_invalid++;                                    // Count the bad command.
+            continue;
+        }
+        Vulintus_DigiPot *pot = _devs[latest[i].dev_i];     // Grab the driver.
+        uint8_t wiper_i = latest[i].wiper_flags & 0x0F;
+        if ((latest[i].wiper_flags >> 4) & DIGIPOT_RING_RATIO) {    // If the command is a Q16 position...
+            pot->set_ratio_q16(latest[i].code, wiper_i);    // Convert it to steps and write it.
+        }
+        else {                                              // Otherwise...
+            pot->set_code(latest[i].code, wiper_i);         // Write the code.
+        }
+        n_written++;
+    }
+    return n;                                               // Return the number of writes.
+}
+
+
+// Check for commands dropped since the last check.
+bool Vulintus_DigiPot_Ring::overflowed(void)
+{
+    count_overflows();                                      // Grab the latest count.
+    bool dropped = (n_overflows != _overflows_seen);        // Check for new drops.
+    _overflows_seen = n_overflows;                          // Reset the check.
+    return dropped;
+}
+
+
+// Number of commands in the ring.
+uint8_t Vulintus_DigiPot_Ring::pending(void)
+{
+    return (uint8_t) (_head - _tail);
+}
+
+
+// Drop everything in the ring without sending it.
+void Vulintus_DigiPot_Ring::clear(void)
+{
+    _tail = _head;                                          // Skip everything in the ring.
+}
+
+
+// Copy the producer's dropped count into "n_overflows".
+void Vulintus_DigiPot_Ring::count_overflows(void)
+{
+#if defined(__AVR__)
+    uint8_t sreg = SREG;                                    // Save the interrupt state.
+    cli();                                                  // The 4-byte read can't be interrupted.
+    n_overflows = _n_dropped;                               // Copy the count.
+    SREG = sreg;                                            // Restore the interrupt state.
+#else
+    n_overflows = _n_dropped;                               // Aligned 4-byte reads are atomic.
+#endif
+}
@@ -0,0 +1,143 @@
+/*!
+	Vulintus_DigiPot_Ring.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Interrupt-safe wiper command ring for Vulintus digital potentiometers/
+	rheostats. Wire and SPI can't be used from an interrupt, and a bus write
+	takes far too long for one anyway. So an ISR "push"es a compact 4-byte
+	command (device index, wiper, code, flags) into a fixed lock-free
+	single-producer/single-consumer ring instead, in constant time with no
+	bus access. "drain", called from "loop" (or a bus worker), takes
+	everything in the ring and coalesces commands for the same wiper down to
+	the latest value, so only the final setting of each wiper reaches the
+	bus.
+
+		Vulintus_DigiPot_Ring ring;
+		int8_t pot_i = ring.add(&pot);      // Register the driver (before the ISR starts).
+
+		ISR(TIMER1_COMPA_vect) {
+		    ring.push(pot_i, 0, code);      // Queue a wiper 0 write.
+		}
+
+		void loop() {
+		    ring.drain();                   // Send the latest value of each wiper.
+		    if (ring.overflowed()) { ... }  // Commands were dropped.
+		}
+
+	Commands flagged DIGIPOT_RING_RATIO carry a Q16 wiper position
+	("set_ratio_q16") instead of a step code, so the ISR doesn't need the
+	step count. Commands flagged DIGIPOT_RING_BARRIER are always written,
+	even when a later command for the same wiper follows.
+
+	A push into a full ring is dropped and never silent. "push" returns
+	DIGIPOT_ERR_QUEUE_FULL, and the producer counts it in a counter only it
+	writes. "drain" and "overflowed" copy the count into "n_overflows"
+	(with interrupts briefly off on AVR, where the 4-byte read isn't
+	atomic).
+
+	Only one context may push at a time. On AVR, interrupts don't nest, so
+	several ISRs can share a ring. On cores with nested interrupt
+	priorities, give each priority level its own ring. Only one context may
+	drain.
+
+	DIGIPOT_RING_LENGTH and DIGIPOT_RING_MAX_DEVICES size member arrays, so
+	they change the class layout and must be the same in every file. Set
+	them with build-wide compiler flags (e.g. -DDIGIPOT_RING_LENGTH=32),
+	never with a #define in the sketch.
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - "Vulintus_DigiPot_Ring" class first created.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_RING_H
+#define VULINTUS_DIGIPOT_RING_H
+
+#include <Arduino.h>                    // Standard Arduino header.
+
+#include "./Vulintus_DigiPot_Bus.h"     // Shared bus transport (status codes, memory barrier).
+
+
+// DEFINITIONS *******************************************************************************************************//
+#ifndef DIGIPOT_RING_LENGTH
+    #define DIGIPOT_RING_LENGTH         16      // Number of commands in each ring (a power of 2, up to 128; build-wide flag only).
+#endif
+
+#ifndef DIGIPOT_RING_MAX_DEVICES
+    #define DIGIPOT_RING_MAX_DEVICES    8       // Maximum number of registered drivers per ring (build-wide flag only).
+#endif
+
+#if ((DIGIPOT_RING_LENGTH & (DIGIPOT_RING_LENGTH - 1)) != 0) || (DIGIPOT_RING_LENGTH > 128)
+    #error "DIGIPOT_RING_LENGTH must be a power of 2, up to 128."
+#endif
+
+class Vulintus_DigiPot;                 // Forward declaration of the base class.
+
+enum DigiPot_ring_flag : uint8_t {
+    DIGIPOT_RING_RATIO      = 0x01,     // The code is a Q16 wiper position ("set_ratio_q16"), not steps.
+    DIGIPOT_RING_BARRIER    = 0x02,     // Write this value, even if a later command replaces it.
+};
+
+struct DigiPot_ring_cmd {
+    uint8_t dev_i;                      // Index of the registered driver.
+    uint8_t wiper_flags;                // Wiper index (low nibble) and flags (high nibble).
+    uint16_t code;                      // Wiper code, or Q16 position.
+};
+
+
+//CLASSES ******************************************************************************************************//
+class Vulintus_DigiPot_Ring
+{
+    public:
+
+        // Class Constructor. //
+        Vulintus_DigiPot_Ring(void);
+
+		// Public Variables. //
+        uint32_t n_overflows;           // Commands dropped because the ring was full (updated by "drain"/"overflowed").
+        uint32_t n_coalesced;           // Commands replaced by a later command for the same wiper.
+        uint32_t n_written;             // Wiper writes sent to the drivers.
+        uint32_t n_invalid;             // Commands for unregistered device indices.
+
+		// Public Functions. //
+        int8_t add(Vulintus_DigiPot *pot);  // Register a driver (returns the device index, or -1 if full).
+        uint8_t drain(void);                // Coalesce and send everything in the ring (returns the number of wiper writes).
+        bool overflowed(void);              // Check for commands dropped since the last check.
+        uint8_t pending(void);              // Number of commands in the ring.
+        void clear(void);                   // Drop everything in the ring without sending it.
+
+        // Queue a wiper command (safe from one interrupt or thread at a time).
+        inline DigiPot_status push(uint8_t dev_i, uint8_t wiper_i, uint16_t code, uint8_t flags = 0)
+        {
+            uint8_t head = _head;                               // Only this function writes the head.
+            if ((uint8_t) (head - _tail) >= DIGIPOT_RING_LENGTH) {  // If the ring is full...
+                _n_dropped++;                                   // Count the dropped command.
+                return DIGIPOT_ERR_QUEUE_FULL;                  // Return the error.
+            }
+            DigiPot_ring_cmd *cmd = &_slots[head & (DIGIPOT_RING_LENGTH - 1)];  // Grab the free slot.
+            cmd->dev_i = dev_i;                                 // Fill in the command.
+            cmd->wiper_flags = (flags << 4) | (wiper_i & 0x0F);
+            cmd->code = code;
+            DIGIPOT_FENCE();                               // Finish the command before publishing it.
+            _head = head + 1;                                   // Publish the command.
+            return DIGIPOT_PENDING;                             // The command is queued.
+        }
+
+    private:
+
+        // Private Variables. //
+        DigiPot_ring_cmd _slots[DIGIPOT_RING_LENGTH];           // Command slots.
+        volatile uint8_t _head;             // Commands pushed (free-running, written only by "push").
+        volatile uint8_t _tail;             // Commands taken (free-running, written only by "drain").
+        volatile uint32_t _n_dropped;       // Commands dropped (written only by "push").
+        uint32_t _overflows_seen;           // Value of "n_overflows" at the last "overflowed" check.
+        Vulintus_DigiPot *_devs[DIGIPOT_RING_MAX_DEVICES];      // Registered drivers.
+        uint8_t _n_devs;                    // Number of registered drivers.
+
+        // Private Functions. //
+        void count_overflows(void);         // Copy the producer's dropped count into "n_overflows".
+
+};
+
+#endif      // #ifndef VULINTUS_DIGIPOT_RING_H
@@ -0,0 +1,102 @@
+/*!
+	Vulintus_DigiPot_Stats.cpp
+
+	Vulintus, Inc., 2026
+
+	See "Vulintus_DigiPot_Stats.h" for documentation and change log.
+*/
+
+
+#include "./Vulintus_DigiPot_Bus.h"
+
+#if defined(DIGIPOT_STATS)
+
+
+// FUNCTIONS *****************************************************************//
+
+// Zero a record.
+void digipot_stats_clear(DigiPot_stats *stats)
+{
+    memset(stats, 0, sizeof(DigiPot_stats));        // Clear every counter and bucket.
+}
+
+
+// Add a timed call to a record.
+void digipot_stats_latency(DigiPot_stats *stats, uint32_t us)
+{
+    uint8_t bucket = 0;                             // Find the log2 bucket.
+    while ((bucket < (DIGIPOT_STATS_BUCKETS - 1)) && (us >> (bucket + 1))) {
+        bucket++;
+    }
+    if (stats->latency[bucket] < 0xFFFF) {          // If the bucket isn't full...
+        stats->latency[bucket]++;                   // Count the call.
+    }
+    stats->busy_us += us;                           // Add to the total busy time.
+    if (us > stats->max_us) {                       // If this is the longest call so far...
+        stats->max_us = us;                         // Save it.
+    }
+}
+
+
+// Count a transaction's result.
+void digipot_stats_status(DigiPot_stats *stats, uint8_t status)
+{
+    stats->n_transactions++;                        // Count the transaction.
+    switch (status) {
+        case DIGIPOT_OK:                            // Success.
+            break;
+        case DIGIPOT_ERR_NACK_ADDR:                 // Address NACK.
+        case DIGIPOT_ERR_NACK_DATA:                 // Data NACK.
+            stats->n_nacks++;
+            break;
+        case DIGIPOT_ERR_SHORT_READ:                // Short read.
+            stats->n_short_reads++;
+            break;
+        default:                                    // Anything else.
+            stats->n_errors++;
+            break;
+    }
+}
+
+
+// Print a record (e.g. to Serial).
+void digipot_stats_print(const DigiPot_stats *stats, Stream *out)
+{
+    out->print(F("transactions: "));
+    out->println(stats->n_transactions);
+    out->print(F("bytes: "));
+    out->println(stats->n_bytes);
+    out->print(F("nacks: "));
+    out->println(stats->n_nacks);
+    out->print(F("short reads: "));
+    out->println(stats->n_short_reads);
+    out->print(F("other errors: "));
+    out->println(stats->n_errors);
+    out->print(F("retries: "));
+    out->println(stats->n_retries);
+    out->print(F("cache hits: "));
+    out->println(stats->n_cache_hits);
+    out->print(F("skipped writes: "));
+    out->println(stats->n_skipped_writes);
+    out->print(F("busy (us): "));
+    out->println(stats->busy_us);
+    out->print(F("max (us): "));
+    out->println(stats->max_us);
+    for (uint8_t i = 0; i < DIGIPOT_STATS_BUCKETS; i++) {  // Step through the histogram buckets.
+        if (!stats->latency[i]) {                   // Skip empty buckets.
+            continue;
+        }
+        out->print(F("  <"));                       // Print the bucket's upper bound...
+        if (i < (DIGIPOT_STATS_BUCKETS - 1)) {
+            out->print((uint32_t) 2 << i);
+        }
+        else {
+            out->print(F("inf"));
+        }
+        out->print(F(" us: "));
+        out->println(stats->latency[i]);            // ...and its count.
+    }
+}
+
+
+#endif      // #if defined(DIGIPOT_STATS)
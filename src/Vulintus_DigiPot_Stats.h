@@ -0,0 +1,84 @@
+/*!
+	Vulintus_DigiPot_Stats.h
+
+	copyright 2026, Vulintus, Inc.
+
+	Optional performance counters for Vulintus digital potentiometers/
+	rheostats. Define DIGIPOT_STATS as a compiler flag (e.g. "-DDIGIPOT_STATS"
+	in PlatformIO "build_flags" or the Arduino CLI "--build-property") to
+	turn them on. It changes the class layouts, so it must be set for the
+	library sources as well as the sketch; a #define in the sketch is not
+	enough. Every shared bus transport and every device then keeps a
+	"DigiPot_stats" record of:
+		- transactions, bytes, NACKs, short reads, other errors, and retries;
+		- cache hits (reads answered from the wiper cache) and skipped writes
+		  (writes of a value the wiper already has);
+		- busy time, worst-case latency, and a latency histogram.
+	The histogram has log2 buckets: bucket 0 counts calls under 2 us, and
+	bucket k counts calls from 2^k to 2^(k+1) - 1 us. The last bucket counts
+	everything longer.
+
+	Bus records time single transactions. Device records time each
+	driver-level read or write, and charge the device the transactions and
+	bytes its bus carried during the call. Records can be read with
+	"stats()", cleared with "reset_stats()", and printed to any Stream with
+	"digipot_stats_print".
+
+	Without DIGIPOT_STATS, the records, counters, and timing calls are not
+	compiled at all (the DIGIPOT_STAT() macro expands to nothing).
+
+	UPDATE LOG:
+		2026-10-17 - Drew Sloan - Performance counters first created.
+*/
+
+
+#ifndef VULINTUS_DIGIPOT_STATS_H
+#define VULINTUS_DIGIPOT_STATS_H
+
+#include <Arduino.h>                    // Standard Arduino header.
+
+
+// DEFINITIONS *******************************************************************************************************//
+#if defined(DIGIPOT_STATS)
+
+    #define DIGIPOT_STAT(x)     x       // Compile the statement.
+
+    #ifndef DIGIPOT_STATS_BUCKETS
+        #define DIGIPOT_STATS_BUCKETS   16  // Number of log2 latency buckets (override with a compiler flag).
+    #endif
+
+    struct DigiPot_stats {
+        uint32_t n_transactions;        // Bus transactions (START to STOP, or CS low to high).
+        uint32_t n_bytes;               // Bytes clocked on the bus, not counting I2C address bytes.
+        uint32_t n_nacks;               // Address or data NACKs.
+        uint32_t n_short_reads;         // Reads that returned fewer bytes than requested.
+        uint32_t n_errors;              // Other failed transactions.
+        uint32_t n_retries;             // Transactions repeated after a failure.
+        uint32_t n_cache_hits;          // Reads answered from the wiper cache.
+        uint32_t n_skipped_writes;      // Writes skipped because the wiper already had the value.
+        uint32_t busy_us;               // Total time spent on timed calls (microseconds).
+        uint32_t max_us;                // Longest timed call (microseconds).
+        uint16_t latency[DIGIPOT_STATS_BUCKETS];    // Log2 latency histogram (saturates at 65535).
+    };
+
+    struct DigiPot_stats_mark {
+        uint32_t t0;                    // Start time of the call.
+        uint32_t n_transactions;        // Bus counters at the start of the call.
+        uint32_t n_bytes;
+        uint32_t n_nacks;
+        uint32_t n_short_reads;
+        uint32_t n_errors;
+    };
+
+    void digipot_stats_clear(DigiPot_stats *stats);                     // Zero a record.
+    void digipot_stats_latency(DigiPot_stats *stats, uint32_t us);      // Add a timed call to a record.
+    void digipot_stats_status(DigiPot_stats *stats, uint8_t status);    // Count a transaction's result.
+    void digipot_stats_print(const DigiPot_stats *stats, Stream *out);  // Print a record (e.g. to Serial).
+
+#else
+
+    #define DIGIPOT_STAT(x)             // Counters are compiled out.
+
+#endif      // #if defined(DIGIPOT_STATS)
+
+#endif      // #ifndef VULINTUS_DIGIPOT_STATS_H